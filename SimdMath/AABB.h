@@ -0,0 +1,199 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <immintrin.h>
+#include <limits>
+
+#include "Affine.h"
+#include "SoA.h"
+#include "Vec4.h"
+
+// w of min and max is ignored
+struct AABB {
+    // Contains nothing, the union with any box is that box
+    static AABB Empty() {
+        const float inf = std::numeric_limits<float>::infinity();
+        return {Vec4{inf}, Vec4{-inf}};
+    }
+
+    [[nodiscard]] AABB Union(const AABB &box) const {
+        return {Vec4{_mm_min_ps(min.m, box.min.m)}, Vec4{_mm_max_ps(max.m, box.max.m)}};
+    }
+
+    [[nodiscard]] AABB Union(const Vec4 &point) const {
+        return {Vec4{_mm_min_ps(min.m, point.m)}, Vec4{_mm_max_ps(max.m, point.m)}};
+    }
+
+    [[nodiscard]] Vec4 Center() const {
+        return (min + max) * Vec4{0.5f};
+    }
+
+    // Half of the surface area, enough for comparing surface area heuristic costs
+    [[nodiscard]] float HalfArea() const {
+        const Vec4 e = max - min;
+        return e.x * e.y + e.y * e.z + e.z * e.x;
+    }
+
+    Vec4 min;
+    Vec4 max;
+};
+
+// Unused lanes should have min and max set to +infinity, they never intersect anything
+struct alignas(16) AABB4 {
+    float minX[4];
+    float minY[4];
+    float minZ[4];
+    float maxX[4];
+    float maxY[4];
+    float maxZ[4];
+};
+
+// Unused lanes should have min and max set to +infinity, they never intersect anything
+struct alignas(32) AABB8 {
+    float minX[8];
+    float minY[8];
+    float minZ[8];
+    float maxX[8];
+    float maxY[8];
+    float maxZ[8];
+};
+
+// Arvo's method: transforms the center and projects the extents onto the absolute values of the basis vectors,
+// 2 matrix-vector products instead of 8 for the corners
+// Only valid for affine transforms, projections need the corners
+// Results have w = 1
+
+inline AABB TransformAABB(const Mat4 &mat, const AABB &box) {
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 half = _mm_set_ps1(0.5f);
+    const __m128 center = _mm_mul_ps(_mm_add_ps(box.min.m, box.max.m), half);
+    const __m128 extent = _mm_mul_ps(_mm_sub_ps(box.max.m, box.min.m), half);
+
+    const __m128 cx = _mm_shuffle_ps(center, center, _MM_SHUFFLE(0, 0, 0, 0));
+    const __m128 cy = _mm_shuffle_ps(center, center, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m128 cz = _mm_shuffle_ps(center, center, _MM_SHUFFLE(2, 2, 2, 2));
+    const __m128 ex = _mm_shuffle_ps(extent, extent, _MM_SHUFFLE(0, 0, 0, 0));
+    const __m128 ey = _mm_shuffle_ps(extent, extent, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m128 ez = _mm_shuffle_ps(extent, extent, _MM_SHUFFLE(2, 2, 2, 2));
+
+    const __m128 newCenter = _mm_add_ps(_mm_add_ps(_mm_mul_ps(mat.c0.m, cx), _mm_mul_ps(mat.c1.m, cy)),
+                                        _mm_add_ps(_mm_mul_ps(mat.c2.m, cz), mat.c3.m));
+    const __m128 newExtent = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_and_ps(mat.c0.m, absMask), ex),
+                                                   _mm_mul_ps(_mm_and_ps(mat.c1.m, absMask), ey)),
+                                        _mm_mul_ps(_mm_and_ps(mat.c2.m, absMask), ez));
+    return {Vec4{_mm_sub_ps(newCenter, newExtent)}, Vec4{_mm_add_ps(newCenter, newExtent)}};
+}
+
+// Rows are dotted directly, the projective row is never built
+inline AABB TransformAABB(const Affine3x4 &transform, const AABB &box) {
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 half = _mm_set_ps1(0.5f);
+    const __m128 center = _mm_blend_ps(_mm_mul_ps(_mm_add_ps(box.min.m, box.max.m), half), _mm_set_ps1(1.0f), 0b1000);
+    const __m128 extent = _mm_mul_ps(_mm_sub_ps(box.max.m, box.min.m), half);
+
+    const __m128 newCenter = (transform * Vec4{center}).m;
+    const __m128 newExtent = _mm_or_ps(_mm_or_ps(_mm_dp_ps(_mm_and_ps(transform.r0.m, absMask), extent, 0x71),
+                                                 _mm_dp_ps(_mm_and_ps(transform.r1.m, absMask), extent, 0x72)),
+                                       _mm_dp_ps(_mm_and_ps(transform.r2.m, absMask), extent, 0x74));
+    return {Vec4{_mm_sub_ps(newCenter, newExtent)}, Vec4{_mm_add_ps(newCenter, newExtent)}};
+}
+
+// rows[r][c] holds element (r, c) of 4 transforms, the last row is never needed
+inline void TransposeAffineRows(const Mat4 *const transforms[4], __m128 rows[3][4]) {
+    const Vec4 Mat4::*columns[4]{&Mat4::c0, &Mat4::c1, &Mat4::c2, &Mat4::c3};
+    for (int c = 0; c < 4; c++) {
+        __m128 m0 = (transforms[0]->*columns[c]).m;
+        __m128 m1 = (transforms[1]->*columns[c]).m;
+        __m128 m2 = (transforms[2]->*columns[c]).m;
+        __m128 m3 = (transforms[3]->*columns[c]).m;
+        _MM_TRANSPOSE4_PS(m0, m1, m2, m3);
+        rows[0][c] = m0;
+        rows[1][c] = m1;
+        rows[2][c] = m2;
+    }
+}
+
+// Affine3x4 is already row-major, 3 transposes instead of 4
+inline void TransposeAffineRows(const Affine3x4 *const transforms[4], __m128 rows[3][4]) {
+    const Vec4 Affine3x4::*sources[3]{&Affine3x4::r0, &Affine3x4::r1, &Affine3x4::r2};
+    for (int r = 0; r < 3; r++) {
+        __m128 m0 = (transforms[0]->*sources[r]).m;
+        __m128 m1 = (transforms[1]->*sources[r]).m;
+        __m128 m2 = (transforms[2]->*sources[r]).m;
+        __m128 m3 = (transforms[3]->*sources[r]).m;
+        _MM_TRANSPOSE4_PS(m0, m1, m2, m3);
+        rows[r][0] = m0;
+        rows[r][1] = m1;
+        rows[r][2] = m2;
+        rows[r][3] = m3;
+    }
+}
+
+// Arvo's method on 4 boxes at once, center and extent are SoA, writes min(count, 4) bounds
+inline void StoreTransformedAABBs(const __m128 rows[3][4], const __m128 center[3], const __m128 extent[3],
+                                  const Vec3SoA &mins, const Vec3SoA &maxs, size_t i, size_t count) {
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    float *const outMins[3]{mins.x + i, mins.y + i, mins.z + i};
+    float *const outMaxs[3]{maxs.x + i, maxs.y + i, maxs.z + i};
+    for (int r = 0; r < 3; r++) {
+        const __m128 newCenter = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rows[r][0], center[0]), _mm_mul_ps(rows[r][1], center[1])),
+                                            _mm_add_ps(_mm_mul_ps(rows[r][2], center[2]), rows[r][3]));
+        const __m128 newExtent = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_and_ps(rows[r][0], absMask), extent[0]),
+                                                       _mm_mul_ps(_mm_and_ps(rows[r][1], absMask), extent[1])),
+                                            _mm_mul_ps(_mm_and_ps(rows[r][2], absMask), extent[2]));
+        StoreLanes(outMins[r], _mm_sub_ps(newCenter, newExtent), count);
+        StoreLanes(outMaxs[r], _mm_add_ps(newCenter, newExtent), count);
+    }
+}
+
+// World bounds of count objects as SoA, ready for SIMD culling
+// Transform is Mat4 or Affine3x4, 4 objects per iteration
+template<typename Transform>
+void TransformAABBs(const Transform *transforms, const AABB *boxes, size_t count, const Vec3SoA &mins, const Vec3SoA &maxs) {
+    const __m128 half = _mm_set_ps1(0.5f);
+    for (size_t i = 0; i < count; i += 4) {
+        // The tail repeats the last object, only valid lanes are stored
+        const size_t n = std::min<size_t>(count - i, 4);
+        const Transform *lanes[4];
+        __m128 min[4], max[4];
+        for (size_t lane = 0; lane < 4; lane++) {
+            const size_t index = i + std::min(lane, n - 1);
+            lanes[lane] = transforms + index;
+            min[lane] = boxes[index].min.m;
+            max[lane] = boxes[index].max.m;
+        }
+        _MM_TRANSPOSE4_PS(min[0], min[1], min[2], min[3]);
+        _MM_TRANSPOSE4_PS(max[0], max[1], max[2], max[3]);
+
+        __m128 rows[3][4];
+        TransposeAffineRows(lanes, rows);
+        __m128 center[3], extent[3];
+        for (int axis = 0; axis < 3; axis++) {
+            center[axis] = _mm_mul_ps(_mm_add_ps(min[axis], max[axis]), half);
+            extent[axis] = _mm_mul_ps(_mm_sub_ps(max[axis], min[axis]), half);
+        }
+        StoreTransformedAABBs(rows, center, extent, mins, maxs, i, n);
+    }
+}
+
+// Same as above, but every object shares the same local bounds, like instances of one mesh
+template<typename Transform>
+void TransformAABBs(const Transform *transforms, const AABB &box, size_t count, const Vec3SoA &mins, const Vec3SoA &maxs) {
+    const Vec4 boxCenter = box.Center();
+    const Vec4 boxExtent = (box.max - box.min) * Vec4{0.5f};
+    const __m128 center[3]{_mm_set_ps1(boxCenter.x), _mm_set_ps1(boxCenter.y), _mm_set_ps1(boxCenter.z)};
+    const __m128 extent[3]{_mm_set_ps1(boxExtent.x), _mm_set_ps1(boxExtent.y), _mm_set_ps1(boxExtent.z)};
+    for (size_t i = 0; i < count; i += 4) {
+        const size_t n = std::min<size_t>(count - i, 4);
+        const Transform *lanes[4];
+        for (size_t lane = 0; lane < 4; lane++) lanes[lane] = transforms + i + std::min(lane, n - 1);
+
+        __m128 rows[3][4];
+        TransposeAffineRows(lanes, rows);
+        StoreTransformedAABBs(rows, center, extent, mins, maxs, i, n);
+    }
+}
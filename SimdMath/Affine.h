@@ -0,0 +1,62 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#pragma once
+
+#include "Mat4.h"
+
+// r0: m00, m01, m02, m03
+// r1: m10, m11, m12, m13
+// r2: m20, m21, m22, m23
+//
+// Row-major upper 3 rows of an affine Mat4, the last row is implicitly (0, 0, 0, 1)
+struct alignas(16) Affine3x4 {
+    // Constructors
+
+    Affine3x4()
+        : r0{1.0f, 0.0f, 0.0f, 0.0f},
+          r1{0.0f, 1.0f, 0.0f, 0.0f},
+          r2{0.0f, 0.0f, 1.0f, 0.0f} {}
+
+    Affine3x4(const Vec4 &r0, const Vec4 &r1, const Vec4 &r2)
+        : r0{r0}, r1{r1}, r2{r2} {}
+
+    // The last row of mat is dropped
+    explicit Affine3x4(const Mat4 &mat) {
+        __m128 m0 = mat.c0.m;
+        __m128 m1 = mat.c1.m;
+        __m128 m2 = mat.c2.m;
+        __m128 m3 = mat.c3.m;
+        _MM_TRANSPOSE4_PS(m0, m1, m2, m3);
+        r0 = Vec4{m0};
+        r1 = Vec4{m1};
+        r2 = Vec4{m2};
+    }
+
+    // Operators
+
+    [[nodiscard]] Mat4 ToMat4() const {
+        __m128 m0 = r0.m;
+        __m128 m1 = r1.m;
+        __m128 m2 = r2.m;
+        __m128 m3 = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+        _MM_TRANSPOSE4_PS(m0, m1, m2, m3);
+        return {m0, m1, m2, m3};
+    }
+
+    // w of v is kept
+    Vec4 operator*(const Vec4 &v) const {
+        const __m128 dp0 = _mm_dp_ps(r0.m, v.m, 0xF1);
+        const __m128 dp1 = _mm_dp_ps(r1.m, v.m, 0xF2);
+        const __m128 dp2 = _mm_dp_ps(r2.m, v.m, 0xF4);
+        const __m128 w = _mm_blend_ps(_mm_setzero_ps(), v.m, 0b1000);
+        return Vec4{_mm_or_ps(_mm_or_ps(dp0, dp1), _mm_or_ps(dp2, w))};
+    }
+
+    Vec4 r0;
+    Vec4 r1;
+    Vec4 r2;
+};
+
+static_assert(sizeof(Affine3x4) == 3 * sizeof(Vec4));
@@ -0,0 +1,247 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <immintrin.h>
+#include <limits>
+#include <vector>
+
+#include "Instrumentation.h"
+#include "Parallel.h"
+#include "SoA.h"
+#include "Vec4.h"
+
+// a < b
+struct BroadphasePair {
+    uint32_t a;
+    uint32_t b;
+};
+
+// Sort and sweep collision broadphase
+// Every update projects the boxes onto the axis with the largest variance of the box centers, sorts their minimums along it
+// and sweeps the sorted boxes, testing 8 candidates at a time against the other two axes
+class Broadphase {
+public:
+    // mins, maxs: w is ignored, touching boxes overlap
+    // incremental: insertion sorts the order of the previous update instead of radix sorting from scratch,
+    //              much faster when the boxes barely move between updates but quadratic when they don't,
+    //              falls back to radix sort when the count or the axis changes
+    void Update(const Vec4 *mins, const Vec4 *maxs, size_t count, bool incremental = false) {
+        PROFILE_SCOPE("Broadphase::Update");
+        const int axis = LargestVarianceAxis(mins, maxs, count);
+        if (incremental && count == m_order.size() && axis == m_axis) {
+            for (size_t i = 0; i < count; i++) m_keys[i] = mins[m_order[i]][axis];
+            InsertionSort();
+        } else {
+            m_axis = axis;
+            m_order.resize(count);
+            m_keys.resize(count);
+            for (size_t i = 0; i < count; i++) {
+                m_order[i] = static_cast<uint32_t>(i);
+                m_keys[i] = mins[i][axis];
+            }
+            RadixSort();
+        }
+        Gather(mins, maxs);
+        Sweep();
+    }
+
+    [[nodiscard]] const std::vector<BroadphasePair> &Pairs() const { return m_pairs; }
+
+    // Box indices sorted by their minimum along Axis()
+    [[nodiscard]] const std::vector<uint32_t> &Order() const { return m_order; }
+
+    [[nodiscard]] int Axis() const { return m_axis; }
+
+private:
+    static int LargestVarianceAxis(const Vec4 *mins, const Vec4 *maxs, size_t count) {
+        if (count == 0) return 0;
+
+        // Center * 2, the scale doesn't change which axis is the largest
+        std::vector<std::array<Vec4, 2>> sums(ThreadCount());
+        const size_t rangeCount = ParallelFor(count, PARALLEL_THRESHOLD, [&](size_t range, size_t begin, size_t end) {
+            __m128 sum = _mm_setzero_ps();
+            __m128 sumSquares = _mm_setzero_ps();
+            for (size_t i = begin; i < end; i++) {
+                const __m128 center = _mm_add_ps(mins[i].m, maxs[i].m);
+                sum = _mm_add_ps(sum, center);
+                sumSquares = _mm_add_ps(sumSquares, _mm_mul_ps(center, center));
+            }
+            sums[range] = {Vec4{sum}, Vec4{sumSquares}};
+        });
+
+        double variances[3]{};
+        for (int axis = 0; axis < 3; axis++) {
+            double sum = 0.0, sumSquares = 0.0;
+            for (size_t range = 0; range < rangeCount; range++) {
+                sum += sums[range][0][axis];
+                sumSquares += sums[range][1][axis];
+            }
+            const double mean = sum / static_cast<double>(count);
+            variances[axis] = sumSquares / static_cast<double>(count) - mean * mean;
+        }
+        if (variances[1] > variances[0] && variances[1] >= variances[2]) return 1;
+        if (variances[2] > variances[0] && variances[2] > variances[1]) return 2;
+        return 0;
+    }
+
+    // Unsigned integers in the same order as the floats
+    static uint32_t SortableKey(float f) {
+        uint32_t bits;
+        std::memcpy(&bits, &f, sizeof(bits));
+        return bits ^ ((bits >> 31) ? 0xFFFFFFFFu : 0x80000000u);
+    }
+
+    // Least significant digit first, 8 bits per pass, every pass histograms and scatters in parallel ranges
+    void RadixSort() {
+        const size_t count = m_order.size();
+        m_sortKeys.resize(count);
+        m_tempKeys.resize(count);
+        m_tempOrder.resize(count);
+        for (size_t i = 0; i < count; i++) m_sortKeys[i] = SortableKey(m_keys[i]);
+
+        std::vector<std::array<uint32_t, 256>> offsets(ThreadCount());
+        for (int shift = 0; shift < 32; shift += 8) {
+            const size_t rangeCount = ParallelFor(count, PARALLEL_THRESHOLD, [&](size_t range, size_t begin, size_t end) {
+                std::array<uint32_t, 256> &histogram = offsets[range];
+                histogram.fill(0);
+                for (size_t i = begin; i < end; i++) histogram[(m_sortKeys[i] >> shift) & 0xFF]++;
+            });
+
+            // Every key has the same digit, the pass wouldn't move anything
+            bool skip = false;
+            for (int digit = 0; digit < 256 && !skip; digit++) {
+                uint32_t total = 0;
+                for (size_t range = 0; range < rangeCount; range++) total += offsets[range][digit];
+                skip = total == count;
+            }
+            if (skip) continue;
+
+            // Bucket major, range minor, so equal digits keep their order
+            uint32_t offset = 0;
+            for (int digit = 0; digit < 256; digit++) {
+                for (size_t range = 0; range < rangeCount; range++) {
+                    const uint32_t histogram = offsets[range][digit];
+                    offsets[range][digit] = offset;
+                    offset += histogram;
+                }
+            }
+
+            ParallelFor(count, PARALLEL_THRESHOLD, [&](size_t range, size_t begin, size_t end) {
+                std::array<uint32_t, 256> &offset = offsets[range];
+                for (size_t i = begin; i < end; i++) {
+                    const uint32_t destination = offset[(m_sortKeys[i] >> shift) & 0xFF]++;
+                    m_tempKeys[destination] = m_sortKeys[i];
+                    m_tempOrder[destination] = m_order[i];
+                }
+            });
+            m_sortKeys.swap(m_tempKeys);
+            m_order.swap(m_tempOrder);
+        }
+    }
+
+    void InsertionSort() {
+        const size_t count = m_order.size();
+        for (size_t i = 1; i < count; i++) {
+            const float key = m_keys[i];
+            const uint32_t index = m_order[i];
+            size_t j = i;
+            for (; j > 0 && m_keys[j - 1] > key; j--) {
+                m_keys[j] = m_keys[j - 1];
+                m_order[j] = m_order[j - 1];
+            }
+            m_keys[j] = key;
+            m_order[j] = index;
+        }
+    }
+
+    // Sorted SoA bounds, followed by 8 +infinity lanes so the sweep can always load 8
+    void Gather(const Vec4 *mins, const Vec4 *maxs) {
+        const size_t count = m_order.size();
+        for (int axis = 0; axis < 3; axis++) {
+            m_min[axis].resize(count + 8);
+            m_max[axis].resize(count + 8);
+            std::fill_n(m_min[axis].begin() + count, 8, std::numeric_limits<float>::infinity());
+            std::fill_n(m_max[axis].begin() + count, 8, std::numeric_limits<float>::infinity());
+        }
+        ParallelFor(count, PARALLEL_THRESHOLD, [&](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                const Vec4 &min = mins[m_order[i]];
+                const Vec4 &max = maxs[m_order[i]];
+                for (int axis = 0; axis < 3; axis++) {
+                    m_min[axis][i] = min[axis];
+                    m_max[axis][i] = max[axis];
+                }
+            }
+        });
+    }
+
+    void Sweep() {
+        const size_t count = m_order.size();
+        const int axisB = (m_axis + 1) % 3;
+        const int axisC = (m_axis + 2) % 3;
+        const float *minA = m_min[m_axis].data();
+        const float *maxA = m_max[m_axis].data();
+        const float *minB = m_min[axisB].data();
+        const float *maxB = m_max[axisB].data();
+        const float *minC = m_min[axisC].data();
+        const float *maxC = m_max[axisC].data();
+
+        m_rangePairs.resize(ThreadCount());
+        const size_t rangeCount = ParallelFor(count, PARALLEL_THRESHOLD, [&](size_t range, size_t begin, size_t end) {
+            std::vector<BroadphasePair> &pairs = m_rangePairs[range];
+            pairs.clear();
+            for (size_t i = begin; i < end; i++) {
+                const __m256 maxAi = _mm256_set1_ps(maxA[i]);
+                const __m256 minBi = _mm256_set1_ps(minB[i]);
+                const __m256 maxBi = _mm256_set1_ps(maxB[i]);
+                const __m256 minCi = _mm256_set1_ps(minC[i]);
+                const __m256 maxCi = _mm256_set1_ps(maxC[i]);
+                const uint32_t a = m_order[i];
+                for (size_t j = i + 1; j < count; j += 8) {
+                    // Sorted by minA, so the candidates are a prefix of the lanes
+                    // An infinite maxA also passes the padding, so lanes past the end are masked off
+                    const int lanes = count - j < 8 ? (1 << (count - j)) - 1 : 0xFF;
+                    const int candidates = lanes & _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(minA + j), maxAi, _CMP_LE_OQ));
+                    if (!candidates) break;
+
+                    __m256 overlap = _mm256_cmp_ps(_mm256_loadu_ps(minB + j), maxBi, _CMP_LE_OQ);
+                    overlap = _mm256_and_ps(overlap, _mm256_cmp_ps(_mm256_loadu_ps(maxB + j), minBi, _CMP_GE_OQ));
+                    overlap = _mm256_and_ps(overlap, _mm256_cmp_ps(_mm256_loadu_ps(minC + j), maxCi, _CMP_LE_OQ));
+                    overlap = _mm256_and_ps(overlap, _mm256_cmp_ps(_mm256_loadu_ps(maxC + j), minCi, _CMP_GE_OQ));
+                    unsigned mask = candidates & _mm256_movemask_ps(overlap);
+                    while (mask) {
+                        const uint32_t b = m_order[j + LowestLane(mask)];
+                        mask &= mask - 1;
+                        pairs.push_back(a < b ? BroadphasePair{a, b} : BroadphasePair{b, a});
+                    }
+
+                    if (candidates != 0xFF) break;
+                }
+            }
+        });
+
+        size_t total = 0;
+        for (size_t range = 0; range < rangeCount; range++) total += m_rangePairs[range].size();
+        m_pairs.resize(total);
+        auto out = m_pairs.begin();
+        for (size_t range = 0; range < rangeCount; range++) out = std::copy(m_rangePairs[range].begin(), m_rangePairs[range].end(), out);
+    }
+
+    int m_axis = 0;
+    std::vector<uint32_t> m_order;
+    std::vector<float> m_keys;
+    std::vector<uint32_t> m_sortKeys;
+    std::vector<uint32_t> m_tempKeys;
+    std::vector<uint32_t> m_tempOrder;
+    std::vector<float> m_min[3];
+    std::vector<float> m_max[3];
+    std::vector<std::vector<BroadphasePair>> m_rangePairs;
+    std::vector<BroadphasePair> m_pairs;
+};
@@ -0,0 +1,482 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "Instrumentation.h"
+#include "Parallel.h"
+#include "Ray.h"
+#include "SoA.h"
+
+struct BvhHit {
+    float t = std::numeric_limits<float>::max();
+    uint32_t primitive = UINT32_MAX;
+};
+
+// Binary bounding volume hierarchy built with the binned surface area heuristic
+// Subtrees are built in parallel, large ranges are also binned in parallel
+// Every subtree gets a share of the hardware threads, so the nested ParallelFor calls never start more threads than there are
+class BvhBuilder {
+public:
+    // count is 0 for inner nodes
+    struct Node {
+        AABB bounds;
+        uint32_t left;
+        uint32_t right;
+        uint32_t first;
+        uint32_t count;
+    };
+
+    static constexpr int BIN_COUNT = 16;
+    static constexpr float TRAVERSAL_COST = 1.0f;
+    // Deeper nodes fall back to median splits, which bounds the tree depth
+    static constexpr int MAX_SAH_DEPTH = 40;
+    static constexpr uint32_t MAX_DEPTH = MAX_SAH_DEPTH + 33;
+
+    BvhBuilder(const AABB *bounds, size_t count, uint32_t maxLeafSize)
+        : m_bounds{bounds}, m_maxLeafSize{std::max<uint32_t>(maxLeafSize, 1)} {
+        PROFILE_SCOPE("BvhBuilder");
+        if (count == 0) return;
+
+        m_indices.resize(count);
+        m_centroids.resize(count);
+        ParallelFor(count, PARALLEL_THRESHOLD, [&](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                m_indices[i] = static_cast<uint32_t>(i);
+                m_centroids[i] = bounds[i].Center();
+            }
+        });
+
+        m_nodes.resize(2 * count - 1);
+        m_nodeCount = 1;
+        Build(0, 0, static_cast<uint32_t>(count), 0, ThreadCount());
+        m_nodes.resize(m_nodeCount);
+    }
+
+    [[nodiscard]] const std::vector<Node> &Nodes() const { return m_nodes; }
+
+    [[nodiscard]] std::vector<uint32_t> &Indices() { return m_indices; }
+
+private:
+    // Makes ParallelFor split count into at most maxRanges ranges
+    static size_t MinRangeSize(size_t count, unsigned maxRanges) {
+        return std::max<size_t>(PARALLEL_THRESHOLD, (count + maxRanges - 1) / maxRanges);
+    }
+
+    struct Bin {
+        AABB bounds = AABB::Empty();
+        uint32_t count = 0;
+    };
+
+    struct Bins {
+        Bin bins[3][BIN_COUNT];
+
+        void Merge(const Bins &other) {
+            for (int axis = 0; axis < 3; axis++) {
+                for (int i = 0; i < BIN_COUNT; i++) {
+                    bins[axis][i].bounds = bins[axis][i].bounds.Union(other.bins[axis][i].bounds);
+                    bins[axis][i].count += other.bins[axis][i].count;
+                }
+            }
+        }
+    };
+
+    struct Split {
+        float cost = std::numeric_limits<float>::max();
+        int axis = -1;
+        int bin = 0;
+    };
+
+    // Bin of a centroid on all 3 axes, same computation for binning and partitioning
+    static __m128i BinIndices(const Vec4 &centroid, const Vec4 &origin, const Vec4 &scale) {
+        const __m128i bins = _mm_cvttps_epi32(((centroid - origin) * scale).m);
+        return _mm_min_epi32(_mm_max_epi32(bins, _mm_setzero_si128()), _mm_set1_epi32(BIN_COUNT - 1));
+    }
+
+    // Bounds of the primitives and of their centroids
+    void ComputeBounds(uint32_t begin, uint32_t end, unsigned threads, AABB &bounds, AABB &centroidBounds) const {
+        const auto reduce = [this](size_t begin, size_t end, AABB &bounds, AABB &centroidBounds) {
+            bounds = AABB::Empty();
+            centroidBounds = AABB::Empty();
+            for (size_t i = begin; i < end; i++) {
+                const uint32_t index = m_indices[i];
+                bounds = bounds.Union(m_bounds[index]);
+                centroidBounds = centroidBounds.Union(m_centroids[index]);
+            }
+        };
+
+        if (threads <= 1 || end - begin < PARALLEL_THRESHOLD) {
+            reduce(begin, end, bounds, centroidBounds);
+            return;
+        }
+
+        AABB partialBounds[64], partialCentroidBounds[64];
+        const size_t ranges = ParallelFor(end - begin, MinRangeSize(end - begin, std::min(threads, 64u)), [&](size_t range, size_t rangeBegin, size_t rangeEnd) {
+            reduce(begin + rangeBegin, begin + rangeEnd, partialBounds[range], partialCentroidBounds[range]);
+        });
+        bounds = partialBounds[0];
+        centroidBounds = partialCentroidBounds[0];
+        for (size_t i = 1; i < ranges; i++) {
+            bounds = bounds.Union(partialBounds[i]);
+            centroidBounds = centroidBounds.Union(partialCentroidBounds[i]);
+        }
+    }
+
+    void BinPrimitives(uint32_t begin, uint32_t end, unsigned threads, const Vec4 &origin, const Vec4 &scale, Bins &result) const {
+        const auto bin = [&](size_t begin, size_t end, Bins &bins) {
+            for (size_t i = begin; i < end; i++) {
+                const uint32_t index = m_indices[i];
+                alignas(16) int indices[4];
+                _mm_store_si128(reinterpret_cast<__m128i *>(indices), BinIndices(m_centroids[index], origin, scale));
+                for (int axis = 0; axis < 3; axis++) {
+                    Bin &b = bins.bins[axis][indices[axis]];
+                    b.bounds = b.bounds.Union(m_bounds[index]);
+                    b.count++;
+                }
+            }
+        };
+
+        if (threads <= 1 || end - begin < PARALLEL_THRESHOLD) {
+            bin(begin, end, result);
+            return;
+        }
+
+        std::vector<Bins> partial(ThreadCount());
+        const size_t ranges = ParallelFor(end - begin, MinRangeSize(end - begin, threads), [&](size_t range, size_t rangeBegin, size_t rangeEnd) {
+            bin(begin + rangeBegin, begin + rangeEnd, partial[range]);
+        });
+        for (size_t i = 0; i < ranges; i++) result.Merge(partial[i]);
+    }
+
+    static Split FindSplit(const Bins &bins) {
+        Split best;
+        for (int axis = 0; axis < 3; axis++) {
+            const Bin *axisBins = bins.bins[axis];
+
+            // Cost of the right side of the split after bin i
+            float rightCosts[BIN_COUNT];
+            AABB right = AABB::Empty();
+            uint32_t rightCount = 0;
+            for (int i = BIN_COUNT - 1; i > 0; i--) {
+                right = right.Union(axisBins[i].bounds);
+                rightCount += axisBins[i].count;
+                rightCosts[i - 1] = rightCount ? right.HalfArea() * static_cast<float>(rightCount) : -1.0f;
+            }
+
+            AABB left = AABB::Empty();
+            uint32_t leftCount = 0;
+            for (int i = 0; i < BIN_COUNT - 1; i++) {
+                left = left.Union(axisBins[i].bounds);
+                leftCount += axisBins[i].count;
+                if (leftCount == 0 || rightCosts[i] < 0.0f) continue;
+                const float cost = left.HalfArea() * static_cast<float>(leftCount) + rightCosts[i];
+                if (cost < best.cost) best = {cost, axis, i};
+            }
+        }
+        return best;
+    }
+
+    // threads is the number of hardware threads this subtree may use, 1 builds it on the calling thread only
+    void Build(uint32_t nodeIndex, uint32_t begin, uint32_t end, int depth, unsigned threads) {
+        Node &node = m_nodes[nodeIndex];
+        const uint32_t count = end - begin;
+
+        AABB centroidBounds;
+        ComputeBounds(begin, end, threads, node.bounds, centroidBounds);
+
+        node.first = begin;
+        node.count = count;
+        if (count <= 1) return;
+
+        const Vec4 extent = centroidBounds.max - centroidBounds.min;
+        uint32_t middle = begin;
+        // Points and segments have no area, the split cost would divide by 0, so they only get median splits
+        if (depth < MAX_SAH_DEPTH && node.bounds.HalfArea() > 0.0f) {
+            const Vec4 scale{_mm_and_ps(_mm_div_ps(_mm_set_ps1(BIN_COUNT * 0.9999f), extent.m),
+                                        _mm_cmpgt_ps(extent.m, _mm_setzero_ps()))};
+            Bins bins;
+            BinPrimitives(begin, end, threads, centroidBounds.min, scale, bins);
+            const Split split = FindSplit(bins);
+
+            const float leafCost = static_cast<float>(count);
+            const float splitCost = TRAVERSAL_COST + split.cost / node.bounds.HalfArea();
+            if (count <= m_maxLeafSize && leafCost <= splitCost) return;
+
+            if (split.axis >= 0) {
+                const Vec4 &origin = centroidBounds.min;
+                middle = static_cast<uint32_t>(std::partition(m_indices.begin() + begin, m_indices.begin() + end, [&](uint32_t index) {
+                                                   alignas(16) int indices[4];
+                                                   _mm_store_si128(reinterpret_cast<__m128i *>(indices), BinIndices(m_centroids[index], origin, scale));
+                                                   return indices[split.axis] <= split.bin;
+                                               }) -
+                                               m_indices.begin());
+            }
+        } else if (count <= m_maxLeafSize) {
+            return;
+        }
+
+        // Every centroid is in the same bin, split at the median of the largest axis
+        if (middle == begin || middle == end) {
+            const int axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+            middle = begin + count / 2;
+            std::nth_element(m_indices.begin() + begin, m_indices.begin() + middle, m_indices.begin() + end, [&](uint32_t a, uint32_t b) {
+                return m_centroids[a][axis] < m_centroids[b][axis];
+            });
+        }
+
+        const uint32_t left = m_nodeCount.fetch_add(2);
+        node.left = left;
+        node.right = left + 1;
+        node.count = 0;
+
+        if (threads > 1 && count > PARALLEL_THRESHOLD) {
+            const unsigned leftThreads = threads / 2;
+            ParallelInvoke([=] { Build(left, begin, middle, depth + 1, leftThreads); },
+                           [=] { Build(left + 1, middle, end, depth + 1, threads - leftThreads); });
+        } else {
+            Build(left, begin, middle, depth + 1, threads);
+            Build(left + 1, middle, end, depth + 1, threads);
+        }
+    }
+
+    const AABB *m_bounds;
+    uint32_t m_maxLeafSize;
+    std::vector<uint32_t> m_indices;
+    std::vector<Vec4> m_centroids;
+    std::vector<Node> m_nodes;
+    std::atomic<uint32_t> m_nodeCount{0};
+};
+
+// Width-wide bounding volume hierarchy over primitive bounds
+// All children of a node are tested with one Intersect(const Ray &, const AABB4/AABB8 &) call
+template<int Width>
+class Bvh {
+public:
+    static_assert(Width == 4 || Width == 8, "Bvh nodes are 4 or 8 wide");
+
+    using Bounds = std::conditional_t<Width == 4, AABB4, AABB8>;
+
+    static constexpr uint32_t EMPTY = UINT32_MAX;
+
+    // children[i] is a node index when counts[i] is 0, and the first index of a leaf otherwise
+    // Unused children are EMPTY with +infinity bounds
+    // Children always come after their parent in the node array
+    struct Node {
+        Bounds bounds;
+        uint32_t children[Width];
+        uint32_t counts[Width];
+    };
+
+    Bvh() = default;
+
+    // bounds: one box per primitive
+    Bvh(const AABB *bounds, size_t count, uint32_t maxLeafSize = 4) {
+        if (count == 0) return;
+        BvhBuilder builder{bounds, count, maxLeafSize};
+        m_indices = std::move(builder.Indices());
+        m_nodes.reserve(builder.Nodes().size() / 2 + 1);
+        m_nodes.emplace_back();
+        Collapse(builder.Nodes(), 0, 0);
+    }
+
+    // Updates the bounds for moved primitives, the tree structure stays the same
+    void Refit(const AABB *bounds) {
+        PROFILE_SCOPE("Bvh::Refit");
+        for (size_t i = m_nodes.size(); i-- > 0;) {
+            Node &node = m_nodes[i];
+            for (int lane = 0; lane < Width; lane++) {
+                if (node.children[lane] == EMPTY) continue;
+                AABB box = AABB::Empty();
+                if (node.counts[lane]) {
+                    for (uint32_t j = 0; j < node.counts[lane]; j++) box = box.Union(bounds[m_indices[node.children[lane] + j]]);
+                } else {
+                    const Node &child = m_nodes[node.children[lane]];
+                    for (int childLane = 0; childLane < Width; childLane++) {
+                        if (child.children[childLane] != EMPTY) box = box.Union(GetLane(child.bounds, childLane));
+                    }
+                }
+                SetLane(node.bounds, lane, box);
+            }
+        }
+    }
+
+    // intersectLeaf(const Ray &ray, uint32_t first, uint32_t count, BvhHit &hit) tests Indices()[first, first + count)
+    // and returns true after updating hit when it finds a hit closer than ray.tMax
+    template<typename LeafFunc>
+    bool ClosestHit(const Ray &ray, LeafFunc &&intersectLeaf, BvhHit &hit) const {
+        if (m_nodes.empty()) return false;
+
+        Ray r = ray;
+        r.tMax = std::min(r.tMax, hit.t);
+        bool found = false;
+
+        struct Entry {
+            uint32_t node;
+            float t;
+        };
+        Entry stack[STACK_SIZE];
+        int stackSize = 0;
+        stack[stackSize++] = {0, r.tMin};
+
+        while (stackSize) {
+            const Entry entry = stack[--stackSize];
+            if (entry.t > r.tMax) continue;
+
+            const Node &node = m_nodes[entry.node];
+            alignas(32) float tEntries[Width];
+            unsigned mask = IntersectNode(r, node, tEntries);
+
+            Entry innerNodes[Width];
+            int innerCount = 0;
+            while (mask) {
+                const int lane = LowestLane(mask);
+                mask &= mask - 1;
+                if (node.counts[lane]) {
+                    if (intersectLeaf(static_cast<const Ray &>(r), node.children[lane], node.counts[lane], hit)) {
+                        found = true;
+                        r.tMax = hit.t;
+                    }
+                } else {
+                    // Insertion sort, farthest first so the nearest child is popped first
+                    int i = innerCount++;
+                    while (i > 0 && innerNodes[i - 1].t < tEntries[lane]) {
+                        innerNodes[i] = innerNodes[i - 1];
+                        i--;
+                    }
+                    innerNodes[i] = {node.children[lane], tEntries[lane]};
+                }
+            }
+            for (int i = 0; i < innerCount; i++) stack[stackSize++] = innerNodes[i];
+        }
+        return found;
+    }
+
+    // Same intersectLeaf as ClosestHit, returns as soon as any leaf reports a hit
+    template<typename LeafFunc>
+    bool AnyHit(const Ray &ray, LeafFunc &&intersectLeaf) const {
+        if (m_nodes.empty()) return false;
+
+        BvhHit hit;
+        hit.t = ray.tMax;
+        uint32_t stack[STACK_SIZE];
+        int stackSize = 0;
+        stack[stackSize++] = 0;
+
+        while (stackSize) {
+            const Node &node = m_nodes[stack[--stackSize]];
+            alignas(32) float tEntries[Width];
+            unsigned mask = IntersectNode(ray, node, tEntries);
+            while (mask) {
+                const int lane = LowestLane(mask);
+                mask &= mask - 1;
+                if (node.counts[lane]) {
+                    if (intersectLeaf(ray, node.children[lane], node.counts[lane], hit)) return true;
+                } else {
+                    stack[stackSize++] = node.children[lane];
+                }
+            }
+        }
+        return false;
+    }
+
+    [[nodiscard]] const std::vector<Node> &Nodes() const { return m_nodes; }
+
+    // Primitive indices in leaf order
+    [[nodiscard]] const std::vector<uint32_t> &Indices() const { return m_indices; }
+
+private:
+    static constexpr int STACK_SIZE = BvhBuilder::MAX_DEPTH * (Width - 1) + 1;
+
+    static unsigned IntersectNode(const Ray &ray, const Node &node, float *tEntries) {
+        if constexpr (Width == 4) {
+            __m128 t;
+            const int mask = Intersect(ray, node.bounds, t);
+            _mm_store_ps(tEntries, t);
+            return mask;
+        } else {
+            __m256 t;
+            const int mask = Intersect(ray, node.bounds, t);
+            _mm256_store_ps(tEntries, t);
+            return mask;
+        }
+    }
+
+    static void SetLane(Bounds &bounds, int lane, const AABB &box) {
+        bounds.minX[lane] = box.min.x;
+        bounds.minY[lane] = box.min.y;
+        bounds.minZ[lane] = box.min.z;
+        bounds.maxX[lane] = box.max.x;
+        bounds.maxY[lane] = box.max.y;
+        bounds.maxZ[lane] = box.max.z;
+    }
+
+    static AABB GetLane(const Bounds &bounds, int lane) {
+        return {{bounds.minX[lane], bounds.minY[lane], bounds.minZ[lane], 1.0f},
+                {bounds.maxX[lane], bounds.maxY[lane], bounds.maxZ[lane], 1.0f}};
+    }
+
+    // Pulls up to Width descendants of a binary node into one wide node, always opening the largest inner node
+    void Collapse(const std::vector<BvhBuilder::Node> &binaryNodes, uint32_t binaryIndex, uint32_t nodeIndex) {
+        const BvhBuilder::Node &binary = binaryNodes[binaryIndex];
+        uint32_t slots[Width];
+        int slotCount = 0;
+        if (binary.count) {
+            slots[slotCount++] = binaryIndex;
+        } else {
+            slots[slotCount++] = binary.left;
+            slots[slotCount++] = binary.right;
+        }
+
+        while (slotCount < Width) {
+            int largest = -1;
+            float largestArea = -1.0f;
+            for (int i = 0; i < slotCount; i++) {
+                const BvhBuilder::Node &slot = binaryNodes[slots[i]];
+                if (slot.count == 0 && slot.bounds.HalfArea() > largestArea) {
+                    largest = i;
+                    largestArea = slot.bounds.HalfArea();
+                }
+            }
+            if (largest < 0) break;
+            const BvhBuilder::Node &opened = binaryNodes[slots[largest]];
+            slots[largest] = opened.left;
+            slots[slotCount++] = opened.right;
+        }
+
+        for (int lane = 0; lane < Width; lane++) {
+            Node &node = m_nodes[nodeIndex];
+            if (lane >= slotCount) {
+                const float inf = std::numeric_limits<float>::infinity();
+                SetLane(node.bounds, lane, {Vec4{inf}, Vec4{inf}});
+                node.children[lane] = EMPTY;
+                node.counts[lane] = 0;
+                continue;
+            }
+            const BvhBuilder::Node &slot = binaryNodes[slots[lane]];
+            SetLane(node.bounds, lane, slot.bounds);
+            if (slot.count) {
+                node.children[lane] = slot.first;
+                node.counts[lane] = slot.count;
+            } else {
+                node.children[lane] = static_cast<uint32_t>(m_nodes.size());
+                node.counts[lane] = 0;
+                // Invalidates node
+                m_nodes.emplace_back();
+            }
+        }
+
+        for (int lane = 0; lane < slotCount; lane++) {
+            if (binaryNodes[slots[lane]].count == 0) Collapse(binaryNodes, slots[lane], m_nodes[nodeIndex].children[lane]);
+        }
+    }
+
+    std::vector<Node> m_nodes;
+    std::vector<uint32_t> m_indices;
+};
@@ -0,0 +1,163 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#pragma once
+
+#include "Instrumentation.h"
+#include "Mat4.h"
+#include "SoA.h"
+#include "Trig.h"
+
+// Standard: same as Mat4::Perspective, depth in [-1, 1]
+// ReverseZ: near maps to 1 and far maps to 0, for glClipControl(GL_LOWER_LEFT, GL_ZERO_TO_ONE)
+// Infinite: Standard with far at infinity
+// ReverseZInfinite: ReverseZ with far at infinity, far is ignored
+enum class DepthMode {
+    Standard,
+    ReverseZ,
+    Infinite,
+    ReverseZInfinite
+};
+
+// Structure-of-arrays camera descriptions
+// eye and target are points, up is a direction, same as Mat4::LookAt
+struct CameraSoA {
+    Vec3SoA eye;
+    Vec3SoA target;
+    Vec3SoA up;
+    float *fov;
+    float *aspectRatio;
+    float *near;
+    float *far;
+};
+
+// Builds camera matrices for 4 views per iteration
+namespace CameraBatch {
+    // columns[column][row] holds the element of 4 views, writes min(count, 4) matrices
+    inline void StoreMatrices(Mat4 *out, const __m128 columns[4][4], size_t count) {
+        __m128 m[4][4];
+        for (int column = 0; column < 4; column++) {
+            m[column][0] = columns[column][0];
+            m[column][1] = columns[column][1];
+            m[column][2] = columns[column][2];
+            m[column][3] = columns[column][3];
+            _MM_TRANSPOSE4_PS(m[column][0], m[column][1], m[column][2], m[column][3]);
+        }
+        const size_t views = count < 4 ? count : 4;
+        for (size_t view = 0; view < views; view++) {
+            out[view] = {m[0][view], m[1][view], m[2][view], m[3][view]};
+        }
+    }
+
+    // Any of views, projections and viewProjections can be nullptr
+    // far is not read by the infinite depth modes
+    inline void Build(size_t count, const CameraSoA &cameras, DepthMode mode,
+                      Mat4 *views, Mat4 *projections, Mat4 *viewProjections) {
+        PROFILE_SCOPE("CameraBatch::Build");
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set_ps1(1.0f);
+        const bool infinite = mode == DepthMode::Infinite || mode == DepthMode::ReverseZInfinite;
+
+        for (size_t i = 0; i < count; i += 4) {
+            const size_t n = count - i;
+
+            const __m128 eyeX = LoadLanes(cameras.eye.x + i, n);
+            const __m128 eyeY = LoadLanes(cameras.eye.y + i, n);
+            const __m128 eyeZ = LoadLanes(cameras.eye.z + i, n);
+
+            // z = normalize(eye - target)
+            __m128 zx = _mm_sub_ps(eyeX, LoadLanes(cameras.target.x + i, n));
+            __m128 zy = _mm_sub_ps(eyeY, LoadLanes(cameras.target.y + i, n));
+            __m128 zz = _mm_sub_ps(eyeZ, LoadLanes(cameras.target.z + i, n));
+            __m128 invLen = _mm_div_ps(one, _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(zx, zx), _mm_mul_ps(zy, zy)), _mm_mul_ps(zz, zz))));
+            zx = _mm_mul_ps(zx, invLen);
+            zy = _mm_mul_ps(zy, invLen);
+            zz = _mm_mul_ps(zz, invLen);
+
+            // x = normalize(up x z)
+            const __m128 upX = LoadLanes(cameras.up.x + i, n);
+            const __m128 upY = LoadLanes(cameras.up.y + i, n);
+            const __m128 upZ = LoadLanes(cameras.up.z + i, n);
+            __m128 xx = _mm_sub_ps(_mm_mul_ps(upY, zz), _mm_mul_ps(upZ, zy));
+            __m128 xy = _mm_sub_ps(_mm_mul_ps(upZ, zx), _mm_mul_ps(upX, zz));
+            __m128 xz = _mm_sub_ps(_mm_mul_ps(upX, zy), _mm_mul_ps(upY, zx));
+            invLen = _mm_div_ps(one, _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(xx, xx), _mm_mul_ps(xy, xy)), _mm_mul_ps(xz, xz))));
+            xx = _mm_mul_ps(xx, invLen);
+            xy = _mm_mul_ps(xy, invLen);
+            xz = _mm_mul_ps(xz, invLen);
+
+            // y = z x x
+            const __m128 yx = _mm_sub_ps(_mm_mul_ps(zy, xz), _mm_mul_ps(zz, xy));
+            const __m128 yy = _mm_sub_ps(_mm_mul_ps(zz, xx), _mm_mul_ps(zx, xz));
+            const __m128 yz = _mm_sub_ps(_mm_mul_ps(zx, xy), _mm_mul_ps(zy, xx));
+
+            const __m128 tx = _mm_sub_ps(zero, _mm_add_ps(_mm_add_ps(_mm_mul_ps(xx, eyeX), _mm_mul_ps(xy, eyeY)), _mm_mul_ps(xz, eyeZ)));
+            const __m128 ty = _mm_sub_ps(zero, _mm_add_ps(_mm_add_ps(_mm_mul_ps(yx, eyeX), _mm_mul_ps(yy, eyeY)), _mm_mul_ps(yz, eyeZ)));
+            const __m128 tz = _mm_sub_ps(zero, _mm_add_ps(_mm_add_ps(_mm_mul_ps(zx, eyeX), _mm_mul_ps(zy, eyeY)), _mm_mul_ps(zz, eyeZ)));
+
+            // view[column][row]
+            const __m128 view[4][4] = {{xx, yx, zx, zero},
+                                       {xy, yy, zy, zero},
+                                       {xz, yz, zz, zero},
+                                       {tx, ty, tz, one}};
+
+            // Perspective scale, 1 / tan(fov / 2)
+            __m128 s, c;
+            SinCos(_mm_mul_ps(LoadLanes(cameras.fov + i, n), _mm_set_ps1(0.5f)), s, c);
+            const __m128 p11 = _mm_div_ps(c, s);
+            const __m128 p00 = _mm_div_ps(p11, LoadLanes(cameras.aspectRatio + i, n));
+
+            // Depth row: clipZ = a * viewZ + b
+            const __m128 near = LoadLanes(cameras.near + i, n);
+            const __m128 far = infinite ? zero : LoadLanes(cameras.far + i, n);
+            __m128 a, b;
+            switch (mode) {
+                case DepthMode::Standard: {
+                    const __m128 invRange = _mm_div_ps(one, _mm_sub_ps(near, far));
+                    a = _mm_mul_ps(_mm_add_ps(far, near), invRange);
+                    b = _mm_mul_ps(_mm_mul_ps(_mm_set_ps1(2.0f), _mm_mul_ps(far, near)), invRange);
+                    break;
+                }
+                case DepthMode::ReverseZ: {
+                    const __m128 invRange = _mm_div_ps(one, _mm_sub_ps(far, near));
+                    a = _mm_mul_ps(near, invRange);
+                    b = _mm_mul_ps(_mm_mul_ps(far, near), invRange);
+                    break;
+                }
+                case DepthMode::Infinite:
+                    a = _mm_set_ps1(-1.0f);
+                    b = _mm_mul_ps(_mm_set_ps1(-2.0f), near);
+                    break;
+                case DepthMode::ReverseZInfinite:
+                default:
+                    a = zero;
+                    b = near;
+                    break;
+            }
+            const __m128 minusOne = _mm_set_ps1(-1.0f);
+
+            if (views) StoreMatrices(views + i, view, n);
+
+            if (projections) {
+                const __m128 projection[4][4] = {{p00, zero, zero, zero},
+                                                 {zero, p11, zero, zero},
+                                                 {zero, zero, a, minusOne},
+                                                 {zero, zero, b, zero}};
+                StoreMatrices(projections + i, projection, n);
+            }
+
+            if (viewProjections) {
+                // The projection is sparse, so projection * view only scales and mixes rows of view
+                __m128 m[4][4];
+                for (int column = 0; column < 4; column++) {
+                    m[column][0] = _mm_mul_ps(p00, view[column][0]);
+                    m[column][1] = _mm_mul_ps(p11, view[column][1]);
+                    m[column][2] = _mm_add_ps(_mm_mul_ps(a, view[column][2]), _mm_mul_ps(b, view[column][3]));
+                    m[column][3] = _mm_sub_ps(zero, view[column][2]);
+                }
+                StoreMatrices(viewProjections + i, m, n);
+            }
+        }
+    }
+}
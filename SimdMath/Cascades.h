@@ -0,0 +1,293 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#pragma once
+
+#include <cmath>
+
+#include "Mat4.h"
+
+// Same parameters as Mat4::LookAt and Mat4::Perspective
+struct CascadeCamera {
+    Vec4 eye;
+    Vec4 target;
+    Vec4 up;
+    float fov;
+    float aspectRatio;
+    float near;
+    float far;
+};
+
+// One depth range of the camera frustum, independent of the lights
+struct CascadeSlice {
+    float near;
+    float far;
+    // Bit 0: +x, bit 1: +y, bit 2: far plane
+    Vec4 corners[8];
+    // Bounding sphere, w of center is 1
+    Vec4 center;
+    float radius;
+};
+
+struct CascadeMatrices {
+    Mat4 view;
+    Mat4 projection;
+    Mat4 viewProjection;
+};
+
+// Sphere: fits the bounding sphere of the slice, the projection size doesn't change when the camera rotates,
+//         combined with texel snapping the shadows don't shimmer
+// Tight: fits the light space bounding box of the slice corners, better resolution but shimmers on rotation
+enum class CascadeFit {
+    Sphere,
+    Tight
+};
+
+// Cascaded shadow map split and fit computations
+namespace Cascades {
+    // Distance of split i out of cascadeCount, 0 is near and cascadeCount is far
+    // lambda: 0 is uniform, 1 is logarithmic, in between is the practical split scheme
+    inline float SplitDistance(int i, int cascadeCount, float near, float far, float lambda) {
+        if (i >= cascadeCount) return far;
+        const float t = static_cast<float>(i) / static_cast<float>(cascadeCount);
+        const float logarithmic = near * std::pow(far / near, t);
+        const float uniform = near + (far - near) * t;
+        return lambda * logarithmic + (1.0f - lambda) * uniform;
+    }
+
+    // splits: cascadeCount + 1 distances, splits[0] is near and splits[cascadeCount] is far
+    inline void ComputeSplits(int cascadeCount, float near, float far, float lambda, float *splits) {
+        for (int i = 0; i <= cascadeCount; i++) splits[i] = SplitDistance(i, cascadeCount, near, far, lambda);
+    }
+
+    // corners: 8 world space corners of the camera frustum between near and far, see CascadeSlice
+    inline void ExtractCorners(const CascadeCamera &camera, float near, float far, Vec4 corners[8]) {
+        const Vec4 forward = (camera.target - camera.eye).Normalize();
+        const Vec4 right = forward.Cross(camera.up).Normalize();
+        const Vec4 up = right.Cross(forward);
+
+        const float halfTan = std::tan(camera.fov * 0.5f);
+        const Vec4 halfWidth = right * Vec4{halfTan * camera.aspectRatio};
+        const Vec4 halfHeight = up * Vec4{halfTan};
+
+        const float distances[2] = {near, far};
+        for (int plane = 0; plane < 2; plane++) {
+            const Vec4 d{distances[plane]};
+            const Vec4 center = camera.eye + forward * d;
+            const Vec4 x = halfWidth * d;
+            const Vec4 y = halfHeight * d;
+            corners[plane * 4 + 0] = center - x - y;
+            corners[plane * 4 + 1] = center + x - y;
+            corners[plane * 4 + 2] = center - x + y;
+            corners[plane * 4 + 3] = center + x + y;
+        }
+    }
+
+    // slices: cascadeCount slices split by ComputeSplits
+    inline void ComputeSlices(const CascadeCamera &camera, int cascadeCount, float lambda, CascadeSlice *slices) {
+        for (int i = 0; i < cascadeCount; i++) {
+            CascadeSlice &slice = slices[i];
+            slice.near = SplitDistance(i, cascadeCount, camera.near, camera.far, lambda);
+            slice.far = SplitDistance(i + 1, cascadeCount, camera.near, camera.far, lambda);
+            ExtractCorners(camera, slice.near, slice.far, slice.corners);
+
+            Vec4 sum;
+            for (const Vec4 &corner: slice.corners) sum = sum + corner;
+            slice.center = sum * Vec4{0.125f};
+
+            float radius = 0.0f;
+            for (const Vec4 &corner: slice.corners) radius = std::fmax(radius, corner.Distance(slice.center));
+            // Quantize so floating point noise doesn't change the projection size from frame to frame
+            slice.radius = std::ceil(radius * 16.0f) / 16.0f;
+        }
+    }
+
+    // lightDirection: (x, y, z, 0), direction the light travels
+    // resolution: shadow map size in texels
+    // casterDistance: extends the depth range toward the light for casters outside of the slice
+    inline CascadeMatrices FitLight(const CascadeSlice &slice, const Vec4 &lightDirection, CascadeFit fit, float resolution, float casterDistance) {
+        const Vec4 direction = lightDirection.Normalize();
+        const Vec4 up = std::fabs(direction.y) > 0.99f ? Vec4{1.0f, 0.0f, 0.0f, 0.0f} : Vec4{0.0f, 1.0f, 0.0f, 0.0f};
+        // Rotation only, so the texel grid stays fixed in world space
+        const Mat4 view = Mat4::LookAt({0.0f, 0.0f, 0.0f, 1.0f}, direction + Vec4{0.0f, 0.0f, 0.0f, 1.0f}, up);
+
+        Vec4 minimum, maximum;
+        if (fit == CascadeFit::Sphere) {
+            // Snapping moves the sphere by up to a texel, so the map covers the diameter plus one texel
+            const float texel = 2.0f * slice.radius / (resolution - 1.0f);
+            const Vec4 center = view * slice.center;
+            const Vec4 radius{slice.radius, slice.radius, slice.radius, 0.0f};
+            minimum = center - radius;
+            maximum = center + radius;
+            minimum.x = std::floor(minimum.x / texel) * texel;
+            minimum.y = std::floor(minimum.y / texel) * texel;
+            maximum.x = minimum.x + resolution * texel;
+            maximum.y = minimum.y + resolution * texel;
+        } else {
+            minimum = maximum = view * slice.corners[0];
+            for (int i = 1; i < 8; i++) {
+                const Vec4 corner = view * slice.corners[i];
+                minimum = Vec4{_mm_min_ps(minimum.m, corner.m)};
+                maximum = Vec4{_mm_max_ps(maximum.m, corner.m)};
+            }
+            const Vec4 texel = (maximum - minimum) / Vec4{resolution};
+            minimum.x = std::floor(minimum.x / texel.x) * texel.x;
+            minimum.y = std::floor(minimum.y / texel.y) * texel.y;
+            maximum.x = std::ceil(maximum.x / texel.x) * texel.x;
+            maximum.y = std::ceil(maximum.y / texel.y) * texel.y;
+        }
+
+        // The light looks down -z
+        const Mat4 projection = Mat4::Ortho(minimum.x, maximum.x, minimum.y, maximum.y, -maximum.z - casterDistance, -minimum.z);
+        return {view, projection, projection * view};
+    }
+
+    // columns[column][row] holds the element of 4 lights, writes matrix of min(count, 4) entries stride apart
+    inline void StoreLightMatrices(CascadeMatrices *out, size_t stride, Mat4 CascadeMatrices::*matrix, const __m128 columns[4][4], size_t count) {
+        __m128 m[4][4];
+        for (int column = 0; column < 4; column++) {
+            m[column][0] = columns[column][0];
+            m[column][1] = columns[column][1];
+            m[column][2] = columns[column][2];
+            m[column][3] = columns[column][3];
+            _MM_TRANSPOSE4_PS(m[column][0], m[column][1], m[column][2], m[column][3]);
+        }
+        const size_t lights = count < 4 ? count : 4;
+        for (size_t light = 0; light < lights; light++) {
+            out[light * stride].*matrix = {m[0][light], m[1][light], m[2][light], m[3][light]};
+        }
+    }
+
+    // Same results as FitLight, 4 lights per iteration in SoA registers
+    // out: lightCount * cascadeCount matrices, all cascades of the first light come first
+    inline void FitLights(const CascadeSlice *slices, int cascadeCount, const Vec4 *lightDirections, size_t lightCount,
+                          CascadeFit fit, float resolution, float casterDistance, CascadeMatrices *out) {
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set_ps1(1.0f);
+        const __m128 two = _mm_set_ps1(2.0f);
+        const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+        for (size_t i = 0; i < lightCount; i += 4) {
+            const size_t n = lightCount - i;
+
+            // Lanes past the end repeat the first light and aren't stored
+            __m128 dx = lightDirections[i].m;
+            __m128 dy = lightDirections[i + (n > 1 ? 1 : 0)].m;
+            __m128 dz = lightDirections[i + (n > 2 ? 2 : 0)].m;
+            __m128 dw = lightDirections[i + (n > 3 ? 3 : 0)].m;
+            _MM_TRANSPOSE4_PS(dx, dy, dz, dw);
+
+            // z = -normalize(direction), the light looks down -z
+            const __m128 invLength = _mm_div_ps(one, _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz))));
+            const __m128 zx = _mm_sub_ps(zero, _mm_mul_ps(dx, invLength));
+            const __m128 zy = _mm_sub_ps(zero, _mm_mul_ps(dy, invLength));
+            const __m128 zz = _mm_sub_ps(zero, _mm_mul_ps(dz, invLength));
+
+            // Same up as FitLight, +x for lights along y and +y otherwise
+            const __m128 pole = _mm_cmpgt_ps(_mm_and_ps(zy, absMask), _mm_set_ps1(0.99f));
+            const __m128 upX = _mm_and_ps(pole, one);
+            const __m128 upY = _mm_andnot_ps(pole, one);
+
+            // x = normalize(up x z), y = z x x
+            __m128 xx = _mm_mul_ps(upY, zz);
+            __m128 xy = _mm_sub_ps(zero, _mm_mul_ps(upX, zz));
+            __m128 xz = _mm_sub_ps(_mm_mul_ps(upX, zy), _mm_mul_ps(upY, zx));
+            const __m128 invXLength = _mm_div_ps(one, _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(xx, xx), _mm_mul_ps(xy, xy)), _mm_mul_ps(xz, xz))));
+            xx = _mm_mul_ps(xx, invXLength);
+            xy = _mm_mul_ps(xy, invXLength);
+            xz = _mm_mul_ps(xz, invXLength);
+            const __m128 yx = _mm_sub_ps(_mm_mul_ps(zy, xz), _mm_mul_ps(zz, xy));
+            const __m128 yy = _mm_sub_ps(_mm_mul_ps(zz, xx), _mm_mul_ps(zx, xz));
+            const __m128 yz = _mm_sub_ps(_mm_mul_ps(zx, xy), _mm_mul_ps(zy, xx));
+
+            // view[column][row], a rotation from the origin
+            const __m128 view[4][4] = {{xx, yx, zx, zero},
+                                       {xy, yy, zy, zero},
+                                       {xz, yz, zz, zero},
+                                       {zero, zero, zero, one}};
+
+            // Light space position of a world space point
+            const auto transform = [&](const Vec4 &p, __m128 &lx, __m128 &ly, __m128 &lz) {
+                const __m128 px = _mm_set_ps1(p.x);
+                const __m128 py = _mm_set_ps1(p.y);
+                const __m128 pz = _mm_set_ps1(p.z);
+                lx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xx, px), _mm_mul_ps(xy, py)), _mm_mul_ps(xz, pz));
+                ly = _mm_add_ps(_mm_add_ps(_mm_mul_ps(yx, px), _mm_mul_ps(yy, py)), _mm_mul_ps(yz, pz));
+                lz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(zx, px), _mm_mul_ps(zy, py)), _mm_mul_ps(zz, pz));
+            };
+
+            for (int cascade = 0; cascade < cascadeCount; cascade++) {
+                const CascadeSlice &slice = slices[cascade];
+                __m128 minX, minY, minZ, maxX, maxY, maxZ;
+                if (fit == CascadeFit::Sphere) {
+                    const __m128 texel = _mm_set_ps1(2.0f * slice.radius / (resolution - 1.0f));
+                    const __m128 size = _mm_mul_ps(texel, _mm_set_ps1(resolution));
+                    const __m128 radius = _mm_set_ps1(slice.radius);
+                    __m128 cx, cy, cz;
+                    transform(slice.center, cx, cy, cz);
+                    minX = _mm_mul_ps(_mm_floor_ps(_mm_div_ps(_mm_sub_ps(cx, radius), texel)), texel);
+                    minY = _mm_mul_ps(_mm_floor_ps(_mm_div_ps(_mm_sub_ps(cy, radius), texel)), texel);
+                    maxX = _mm_add_ps(minX, size);
+                    maxY = _mm_add_ps(minY, size);
+                    minZ = _mm_sub_ps(cz, radius);
+                    maxZ = _mm_add_ps(cz, radius);
+                } else {
+                    transform(slice.corners[0], minX, minY, minZ);
+                    maxX = minX;
+                    maxY = minY;
+                    maxZ = minZ;
+                    for (int corner = 1; corner < 8; corner++) {
+                        __m128 lx, ly, lz;
+                        transform(slice.corners[corner], lx, ly, lz);
+                        minX = _mm_min_ps(minX, lx);
+                        minY = _mm_min_ps(minY, ly);
+                        minZ = _mm_min_ps(minZ, lz);
+                        maxX = _mm_max_ps(maxX, lx);
+                        maxY = _mm_max_ps(maxY, ly);
+                        maxZ = _mm_max_ps(maxZ, lz);
+                    }
+                    const __m128 invResolution = _mm_set_ps1(1.0f / resolution);
+                    const __m128 texelX = _mm_mul_ps(_mm_sub_ps(maxX, minX), invResolution);
+                    const __m128 texelY = _mm_mul_ps(_mm_sub_ps(maxY, minY), invResolution);
+                    minX = _mm_mul_ps(_mm_floor_ps(_mm_div_ps(minX, texelX)), texelX);
+                    minY = _mm_mul_ps(_mm_floor_ps(_mm_div_ps(minY, texelY)), texelY);
+                    maxX = _mm_mul_ps(_mm_ceil_ps(_mm_div_ps(maxX, texelX)), texelX);
+                    maxY = _mm_mul_ps(_mm_ceil_ps(_mm_div_ps(maxY, texelY)), texelY);
+                }
+
+                // Same as Mat4::Ortho with near = -maxZ - casterDistance and far = -minZ
+                const __m128 near = _mm_sub_ps(_mm_sub_ps(zero, maxZ), _mm_set_ps1(casterDistance));
+                const __m128 far = _mm_sub_ps(zero, minZ);
+                const __m128 invWidth = _mm_div_ps(one, _mm_sub_ps(maxX, minX));
+                const __m128 invHeight = _mm_div_ps(one, _mm_sub_ps(maxY, minY));
+                const __m128 invDepth = _mm_div_ps(one, _mm_sub_ps(far, near));
+                const __m128 p00 = _mm_mul_ps(two, invWidth);
+                const __m128 p11 = _mm_mul_ps(two, invHeight);
+                const __m128 p22 = _mm_mul_ps(_mm_set_ps1(-2.0f), invDepth);
+                const __m128 p30 = _mm_sub_ps(zero, _mm_mul_ps(_mm_add_ps(maxX, minX), invWidth));
+                const __m128 p31 = _mm_sub_ps(zero, _mm_mul_ps(_mm_add_ps(maxY, minY), invHeight));
+                const __m128 p32 = _mm_sub_ps(zero, _mm_mul_ps(_mm_add_ps(far, near), invDepth));
+                const __m128 projection[4][4] = {{p00, zero, zero, zero},
+                                                 {zero, p11, zero, zero},
+                                                 {zero, zero, p22, zero},
+                                                 {p30, p31, p32, one}};
+
+                // The projection only scales and translates, so projection * view scales rows of view and adds w
+                __m128 viewProjection[4][4];
+                for (int column = 0; column < 4; column++) {
+                    const __m128 w = view[column][3];
+                    viewProjection[column][0] = _mm_add_ps(_mm_mul_ps(p00, view[column][0]), _mm_mul_ps(p30, w));
+                    viewProjection[column][1] = _mm_add_ps(_mm_mul_ps(p11, view[column][1]), _mm_mul_ps(p31, w));
+                    viewProjection[column][2] = _mm_add_ps(_mm_mul_ps(p22, view[column][2]), _mm_mul_ps(p32, w));
+                    viewProjection[column][3] = w;
+                }
+
+                CascadeMatrices *matrices = out + i * cascadeCount + cascade;
+                StoreLightMatrices(matrices, cascadeCount, &CascadeMatrices::view, view, n);
+                StoreLightMatrices(matrices, cascadeCount, &CascadeMatrices::projection, projection, n);
+                StoreLightMatrices(matrices, cascadeCount, &CascadeMatrices::viewProjection, viewProjection, n);
+            }
+        }
+    }
+}
@@ -0,0 +1,339 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <immintrin.h>
+#include <utility>
+#include <vector>
+
+#include "AABB.h"
+#include "Instrumentation.h"
+#include "Mat4.h"
+#include "Parallel.h"
+#include "SoA.h"
+
+// Software depth rasterizer for occlusion culling
+//
+// Occluders are transformed into OpenGL clip space (Mat4::Perspective), set up and binned into screen tiles,
+// then every tile is rasterized on its own thread, 8 pixels at a time. The depth buffer is reduced into a
+// hierarchical Z pyramid of maximum depths, boxes are occluded when their nearest depth is behind every texel
+// they cover.
+//
+// Depth is window depth in [0, 1], smaller is closer. Row 0 is the bottom of the screen, like OpenGL.
+class DepthRasterizer {
+public:
+    static constexpr int TILE_SIZE = 32;
+    // Lower than the SimdMath default, a triangle setup or a box test transforms 3 or 8 vertices per element
+    static constexpr size_t PARALLEL_THRESHOLD = ::PARALLEL_THRESHOLD / 4;
+
+    // Every level is padded to the size of the tiles, the padding starts at the far plane
+    // Triangles crossing the right edge may write their depth into the padding columns, coarser texels then take
+    // the max over a few off-screen texels too, which can only make them farther, so the test stays conservative
+    struct Level {
+        int width;
+        int height;
+        std::vector<float> depth;
+    };
+
+    DepthRasterizer(int width, int height)
+        : m_width{width},
+          m_height{height},
+          m_tilesX{(width + TILE_SIZE - 1) / TILE_SIZE},
+          m_tilesY{(height + TILE_SIZE - 1) / TILE_SIZE} {
+        int levelWidth = m_tilesX * TILE_SIZE;
+        int levelHeight = m_tilesY * TILE_SIZE;
+        m_levels.push_back({levelWidth, levelHeight, std::vector<float>(levelWidth * levelHeight, 1.0f)});
+        while (levelWidth > 1 || levelHeight > 1) {
+            levelWidth = (levelWidth + 1) / 2;
+            levelHeight = (levelHeight + 1) / 2;
+            m_levels.push_back({levelWidth, levelHeight, std::vector<float>(levelWidth * levelHeight, 1.0f)});
+        }
+        m_bins.resize(m_tilesX * m_tilesY);
+    }
+
+    // Clears the depth to the far plane and removes all occluders
+    void Clear() {
+        std::fill(m_levels[0].depth.begin(), m_levels[0].depth.end(), 1.0f);
+        m_triangles.clear();
+        for (std::vector<uint32_t> &bin: m_bins) bin.clear();
+    }
+
+    // positions: 3 vertices per triangle, vertex i at byte offset i * stride, so Vertex arrays can be used directly
+    // Occluders must be closed meshes with counter-clockwise front faces like CreateBox, back faces are culled.
+    // Triangles crossing the near plane are dropped, losing an occluder only makes the culling less effective.
+    void AddOccluder(const Mat4 &modelViewProjection, const Vec4 *positions, size_t stride, size_t triangleCount) {
+        const auto *bytes = reinterpret_cast<const char *>(positions);
+        const auto vertex = [&](size_t i) {
+            const Vec4 &p = *reinterpret_cast<const Vec4 *>(bytes + i * stride);
+            return modelViewProjection * Vec4{_mm_blend_ps(p.m, _mm_set_ps1(1.0f), 0b1000)};
+        };
+
+        const size_t first = m_triangles.size();
+        m_triangles.resize(first + triangleCount);
+        ParallelFor(triangleCount, PARALLEL_THRESHOLD, [&](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) m_triangles[first + i] = Setup(vertex(i * 3), vertex(i * 3 + 1), vertex(i * 3 + 2));
+        });
+
+        for (size_t i = first; i < m_triangles.size(); i++) {
+            const Triangle &triangle = m_triangles[i];
+            if (triangle.minX > triangle.maxX) continue;
+            for (int ty = triangle.minY / TILE_SIZE; ty <= triangle.maxY / TILE_SIZE; ty++) {
+                for (int tx = triangle.minX / TILE_SIZE; tx <= triangle.maxX / TILE_SIZE; tx++) {
+                    m_bins[ty * m_tilesX + tx].push_back(static_cast<uint32_t>(i));
+                }
+            }
+        }
+    }
+
+    // Rasterizes the occluders and builds the hierarchical Z pyramid
+    void Render() {
+        PROFILE_SCOPE("DepthRasterizer::Render");
+        // Every worker takes every workerCount-th tile, so occluders crowding one part of the screen are spread out
+        const size_t tileCount = m_bins.size();
+        const size_t workerCount = std::min<size_t>(ThreadCount(), tileCount);
+        ParallelFor(workerCount, 1, [&](size_t, size_t begin, size_t end) {
+            for (size_t worker = begin; worker < end; worker++) {
+                for (size_t tile = worker; tile < tileCount; tile += workerCount) RasterizeTile(static_cast<int>(tile));
+            }
+        });
+        BuildHiZ();
+    }
+
+    // Conservative: boxes crossing the near plane are visible, boxes outside of the frustum are not
+    // box: world space, w is ignored
+    [[nodiscard]] bool IsVisible(const Mat4 &viewProjection, const AABB &box) const {
+        // The 8 corners, bit 0 is +x, bit 1 is +y, bit 2 is +z
+        const __m256 xs = _mm256_setr_ps(box.min.x, box.max.x, box.min.x, box.max.x, box.min.x, box.max.x, box.min.x, box.max.x);
+        const __m256 ys = _mm256_setr_ps(box.min.y, box.min.y, box.max.y, box.max.y, box.min.y, box.min.y, box.max.y, box.max.y);
+        const __m256 zs = _mm256_setr_ps(box.min.z, box.min.z, box.min.z, box.min.z, box.max.z, box.max.z, box.max.z, box.max.z);
+        const auto row = [&](int r) {
+            return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(viewProjection.c0[r]), xs),
+                                               _mm256_mul_ps(_mm256_set1_ps(viewProjection.c1[r]), ys)),
+                                 _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(viewProjection.c2[r]), zs),
+                                               _mm256_set1_ps(viewProjection.c3[r])));
+        };
+        const __m256 clipX = row(0);
+        const __m256 clipY = row(1);
+        const __m256 clipZ = row(2);
+        const __m256 clipW = row(3);
+
+        // All corners outside of the same clip plane
+        const __m256 negativeW = _mm256_sub_ps(_mm256_setzero_ps(), clipW);
+        const bool outside = _mm256_movemask_ps(_mm256_cmp_ps(clipX, negativeW, _CMP_LT_OQ)) == 0xFF ||
+                            _mm256_movemask_ps(_mm256_cmp_ps(clipX, clipW, _CMP_GT_OQ)) == 0xFF ||
+                            _mm256_movemask_ps(_mm256_cmp_ps(clipY, negativeW, _CMP_LT_OQ)) == 0xFF ||
+                            _mm256_movemask_ps(_mm256_cmp_ps(clipY, clipW, _CMP_GT_OQ)) == 0xFF ||
+                            _mm256_movemask_ps(_mm256_cmp_ps(clipZ, negativeW, _CMP_LT_OQ)) == 0xFF ||
+                            _mm256_movemask_ps(_mm256_cmp_ps(clipZ, clipW, _CMP_GT_OQ)) == 0xFF;
+        if (outside) return false;
+
+        const __m256 nearPlane = _mm256_or_ps(_mm256_cmp_ps(clipW, _mm256_setzero_ps(), _CMP_LE_OQ),
+                                              _mm256_cmp_ps(clipZ, negativeW, _CMP_LT_OQ));
+        if (_mm256_movemask_ps(nearPlane)) return true;
+
+        const __m256 half = _mm256_set1_ps(0.5f);
+        const __m256 invW = _mm256_div_ps(_mm256_set1_ps(1.0f), clipW);
+        const __m256 screenX = _mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(clipX, invW), half), half), _mm256_set1_ps(static_cast<float>(m_width)));
+        const __m256 screenY = _mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(clipY, invW), half), half), _mm256_set1_ps(static_cast<float>(m_height)));
+        const __m256 depth = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(clipZ, invW), half), half);
+
+        const float minX = HorizontalMin(screenX);
+        const float maxX = HorizontalMax(screenX);
+        const float minY = HorizontalMin(screenY);
+        const float maxY = HorizontalMax(screenY);
+        const float minDepth = HorizontalMin(depth);
+        if (maxX < 0.0f || minX > static_cast<float>(m_width) || maxY < 0.0f || minY > static_cast<float>(m_height) || minDepth > 1.0f) return false;
+
+        const int x0 = std::clamp(static_cast<int>(std::floor(minX)), 0, m_width - 1);
+        const int x1 = std::clamp(static_cast<int>(std::floor(maxX)), 0, m_width - 1);
+        const int y0 = std::clamp(static_cast<int>(std::floor(minY)), 0, m_height - 1);
+        const int y1 = std::clamp(static_cast<int>(std::floor(maxY)), 0, m_height - 1);
+
+        // The first level where the box covers at most 4x4 texels, coarser levels reach too far past the box
+        int level = 0;
+        while ((x1 >> level) - (x0 >> level) > 3 || (y1 >> level) - (y0 >> level) > 3) level++;
+
+        const Level &hiZ = m_levels[level];
+        for (int y = y0 >> level; y <= y1 >> level; y++) {
+            for (int x = x0 >> level; x <= x1 >> level; x++) {
+                if (hiZ.depth[y * hiZ.width + x] >= minDepth) return true;
+            }
+        }
+        return false;
+    }
+
+    // visible: count results, 1 for visible and 0 for occluded
+    void TestVisibility(const Mat4 &viewProjection, const AABB *boxes, size_t count, uint8_t *visible) const {
+        PROFILE_SCOPE("DepthRasterizer::TestVisibility");
+        ParallelFor(count, PARALLEL_THRESHOLD, [&](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) visible[i] = IsVisible(viewProjection, boxes[i]);
+        });
+    }
+
+    [[nodiscard]] int Width() const { return m_width; }
+
+    [[nodiscard]] int Height() const { return m_height; }
+
+    // Level 0 is the depth buffer
+    [[nodiscard]] const std::vector<Level> &Levels() const { return m_levels; }
+
+private:
+    // Edge functions are A * x + B * y + C, positive inside, the depth plane is the same form
+    // minX > maxX for culled triangles
+    struct Triangle {
+        float edgeA[3];
+        float edgeB[3];
+        float edgeC[3];
+        float depthA;
+        float depthB;
+        float depthC;
+        int minX;
+        int minY;
+        int maxX;
+        int maxY;
+    };
+
+    Triangle Setup(const Vec4 &clip0, const Vec4 &clip1, const Vec4 &clip2) const {
+        Triangle triangle{};
+        triangle.minX = 0;
+        triangle.maxX = -1;
+
+        const Vec4 clip[3] = {clip0, clip1, clip2};
+        float x[3], y[3], z[3];
+        for (int i = 0; i < 3; i++) {
+            if (clip[i].w <= 0.0f || clip[i].z < -clip[i].w) return triangle;
+            const float invW = 1.0f / clip[i].w;
+            x[i] = (clip[i].x * invW * 0.5f + 0.5f) * static_cast<float>(m_width);
+            y[i] = (clip[i].y * invW * 0.5f + 0.5f) * static_cast<float>(m_height);
+            z[i] = clip[i].z * invW * 0.5f + 0.5f;
+        }
+
+        const float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+        if (!(area > 0.0f)) return triangle;
+
+        // Edge i is opposite to vertex i, divided by the area it's the barycentric weight of vertex i
+        // Shared edges are set up in the same direction and negated, so both triangles get exactly opposite values
+        // and no pixel center falls through the crack between them
+        for (int i = 0; i < 3; i++) {
+            int a = (i + 1) % 3;
+            int b = (i + 2) % 3;
+            float sign = 1.0f;
+            if (x[a] > x[b] || (x[a] == x[b] && y[a] > y[b])) {
+                std::swap(a, b);
+                sign = -1.0f;
+            }
+            const float edgeA = y[a] - y[b];
+            const float edgeB = x[b] - x[a];
+            triangle.edgeA[i] = sign * edgeA;
+            triangle.edgeB[i] = sign * edgeB;
+            triangle.edgeC[i] = sign * -(edgeA * x[a] + edgeB * y[a]);
+        }
+        const float invArea = 1.0f / area;
+        triangle.depthA = (triangle.edgeA[0] * z[0] + triangle.edgeA[1] * z[1] + triangle.edgeA[2] * z[2]) * invArea;
+        triangle.depthB = (triangle.edgeB[0] * z[0] + triangle.edgeB[1] * z[1] + triangle.edgeB[2] * z[2]) * invArea;
+        triangle.depthC = (triangle.edgeC[0] * z[0] + triangle.edgeC[1] * z[1] + triangle.edgeC[2] * z[2]) * invArea;
+
+        // Pixels whose centers can be inside
+        const float minX = std::min({x[0], x[1], x[2]});
+        const float maxX = std::max({x[0], x[1], x[2]});
+        const float minY = std::min({y[0], y[1], y[2]});
+        const float maxY = std::max({y[0], y[1], y[2]});
+        if (maxX < 0.0f || minX > static_cast<float>(m_width) || maxY < 0.0f || minY > static_cast<float>(m_height)) return triangle;
+        triangle.minX = std::max(static_cast<int>(std::ceil(minX - 0.5f)), 0);
+        triangle.maxX = std::min(static_cast<int>(std::floor(maxX - 0.5f)), m_width - 1);
+        triangle.minY = std::max(static_cast<int>(std::ceil(minY - 0.5f)), 0);
+        triangle.maxY = std::min(static_cast<int>(std::floor(maxY - 0.5f)), m_height - 1);
+        if (triangle.minY > triangle.maxY) triangle.maxX = -1;
+        return triangle;
+    }
+
+    // Runs on the ParallelFor threads of Render
+    void RasterizeTile(int tile) {
+        PROFILE_SCOPE("DepthRasterizer::RasterizeTile");
+        const int tileX = tile % m_tilesX * TILE_SIZE;
+        const int tileY = tile / m_tilesX * TILE_SIZE;
+        Level &level = m_levels[0];
+        const __m256 pixelCenters = _mm256_setr_ps(0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f);
+        const __m256 zero = _mm256_setzero_ps();
+
+        for (const uint32_t index: m_bins[tile]) {
+            const Triangle &triangle = m_triangles[index];
+            // Blocks of 8 never leave the tile, the tile size is a multiple of 8
+            // They can still pass m_width in the last tile column, those lanes write the padding, see Level
+            const int x0 = std::max(triangle.minX, tileX) & ~7;
+            const int x1 = std::min(triangle.maxX, tileX + TILE_SIZE - 1);
+            const int y0 = std::max(triangle.minY, tileY);
+            const int y1 = std::min(triangle.maxY, tileY + TILE_SIZE - 1);
+
+            const __m256 a0 = _mm256_set1_ps(triangle.edgeA[0]);
+            const __m256 a1 = _mm256_set1_ps(triangle.edgeA[1]);
+            const __m256 a2 = _mm256_set1_ps(triangle.edgeA[2]);
+            const __m256 depthA = _mm256_set1_ps(triangle.depthA);
+
+            for (int y = y0; y <= y1; y++) {
+                const float py = static_cast<float>(y) + 0.5f;
+                const __m256 row0 = _mm256_set1_ps(triangle.edgeB[0] * py + triangle.edgeC[0]);
+                const __m256 row1 = _mm256_set1_ps(triangle.edgeB[1] * py + triangle.edgeC[1]);
+                const __m256 row2 = _mm256_set1_ps(triangle.edgeB[2] * py + triangle.edgeC[2]);
+                const __m256 rowDepth = _mm256_set1_ps(triangle.depthB * py + triangle.depthC);
+                float *depthRow = level.depth.data() + y * level.width;
+
+                for (int x = x0; x <= x1; x += 8) {
+                    const __m256 px = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(x)), pixelCenters);
+                    const __m256 e0 = _mm256_add_ps(_mm256_mul_ps(a0, px), row0);
+                    const __m256 e1 = _mm256_add_ps(_mm256_mul_ps(a1, px), row1);
+                    const __m256 e2 = _mm256_add_ps(_mm256_mul_ps(a2, px), row2);
+                    // Inside when all 3 are non-negative, so when the smallest is
+                    const __m256 inside = _mm256_cmp_ps(_mm256_min_ps(_mm256_min_ps(e0, e1), e2), zero, _CMP_GE_OQ);
+                    if (!_mm256_movemask_ps(inside)) continue;
+
+                    const __m256 depth = _mm256_add_ps(_mm256_mul_ps(depthA, px), rowDepth);
+                    const __m256 old = _mm256_loadu_ps(depthRow + x);
+                    const __m256 closer = _mm256_and_ps(inside, _mm256_cmp_ps(depth, old, _CMP_LT_OQ));
+                    _mm256_storeu_ps(depthRow + x, _mm256_blendv_ps(old, depth, closer));
+                }
+            }
+        }
+    }
+
+    // Every texel is the maximum of the 2x2 texels below it, odd sizes repeat the last row and column
+    void BuildHiZ() {
+        for (size_t i = 1; i < m_levels.size(); i++) {
+            const Level &source = m_levels[i - 1];
+            Level &target = m_levels[i];
+            for (int y = 0; y < target.height; y++) {
+                const float *row0 = source.depth.data() + std::min(y * 2, source.height - 1) * source.width;
+                const float *row1 = source.depth.data() + std::min(y * 2 + 1, source.height - 1) * source.width;
+                float *out = target.depth.data() + y * target.width;
+
+                int x = 0;
+                for (; x * 2 + 8 <= source.width; x += 4) {
+                    const __m128 a = _mm_max_ps(_mm_loadu_ps(row0 + x * 2), _mm_loadu_ps(row1 + x * 2));
+                    const __m128 b = _mm_max_ps(_mm_loadu_ps(row0 + x * 2 + 4), _mm_loadu_ps(row1 + x * 2 + 4));
+                    const __m128 even = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+                    const __m128 odd = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+                    _mm_storeu_ps(out + x, _mm_max_ps(even, odd));
+                }
+                for (; x < target.width; x++) {
+                    const int x0 = std::min(x * 2, source.width - 1);
+                    const int x1 = std::min(x * 2 + 1, source.width - 1);
+                    out[x] = std::max(std::max(row0[x0], row0[x1]), std::max(row1[x0], row1[x1]));
+                }
+            }
+        }
+    }
+
+    int m_width;
+    int m_height;
+    int m_tilesX;
+    int m_tilesY;
+    std::vector<Level> m_levels;
+    std::vector<Triangle> m_triangles;
+    // Triangle indices overlapping every tile, in submission order
+    std::vector<std::vector<uint32_t>> m_bins;
+};
@@ -0,0 +1,331 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#pragma once
+
+// Scoped rdtscp timers for hot paths, compiled in with the SIMD_INSTRUMENTATION CMake option
+// PROFILE_SCOPE("name") times the rest of the enclosing block, it expands to nothing when disabled
+// Every thread adds to its own counters without locks, CollectProfile sums them on demand
+// Every scope is also an event in a ring buffer of its thread, WriteChromeTrace saves them for Perfetto or chrome://tracing
+
+#ifdef SIMD_INSTRUMENTATION
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+namespace Instrumentation {
+    // Sites registered after this many share the last slot
+    constexpr uint32_t MAX_SITES = 256;
+
+    // rdtscp waits for earlier instructions to finish, so the timed code can't leak out of the scope
+    inline uint64_t ReadTimestamp() {
+        unsigned int aux;
+        return __rdtscp(&aux);
+    }
+
+    // Latest events kept per thread, older ones are overwritten
+    constexpr uint64_t TRACE_CAPACITY = 1 << 16;
+
+    // Site of instant events, like frame markers, has this bit set
+    constexpr uint32_t INSTANT_EVENT = 0x80000000;
+
+    // Atomic so the trace can be written while threads record, relaxed stores are plain moves on x86
+    struct TraceEvent {
+        std::atomic<uint32_t> site;
+        std::atomic<uint64_t> start;
+        // Timestamp of the end for scopes, the argument for instant events
+        std::atomic<uint64_t> end;
+    };
+
+    // Written only by the owning thread, read by CollectProfile and WriteChromeTrace from any thread
+    struct ThreadCounters {
+        explicit ThreadCounters(uint32_t id) : id(id), events(new TraceEvent[TRACE_CAPACITY]) {}
+
+        // Thread id in the trace
+        const uint32_t id;
+        std::atomic<const char *> name{nullptr};
+
+        std::atomic<uint64_t> ticks[MAX_SITES]{};
+        std::atomic<uint64_t> calls[MAX_SITES]{};
+
+        // Number of events ever recorded, event i is at i % TRACE_CAPACITY
+        std::atomic<uint64_t> eventCount{0};
+        const std::unique_ptr<TraceEvent[]> events;
+
+        void Record(uint32_t site, uint64_t start, uint64_t end) {
+            const uint64_t index = eventCount.load(std::memory_order_relaxed);
+            TraceEvent &event = events[index % TRACE_CAPACITY];
+            event.site.store(site, std::memory_order_relaxed);
+            event.start.store(start, std::memory_order_relaxed);
+            event.end.store(end, std::memory_order_relaxed);
+            // Publishes the event to readers
+            eventCount.store(index + 1, std::memory_order_release);
+        }
+    };
+
+    struct Registry {
+        Registry() = default;
+
+        Registry(const Registry &) = delete;
+
+        Registry &operator=(const Registry &) = delete;
+
+        ~Registry() {
+            for (ThreadCounters *counters: blocks) delete counters;
+        }
+
+        std::atomic<uint32_t> siteCount{0};
+        std::atomic<const char *> siteNames[MAX_SITES]{};
+
+        // Taken when a thread starts or exits, never while timing
+        std::mutex mutex;
+        // Every block ever handed out, exited threads give theirs back with the counts kept
+        // ParallelFor starts new threads every call, so blocks are reused instead of growing per thread
+        std::vector<ThreadCounters *> blocks;
+        std::vector<ThreadCounters *> freeBlocks;
+    };
+
+    inline Registry &GetRegistry() {
+        static Registry registry;
+        return registry;
+    }
+
+    class ThreadSlot {
+    public:
+        ThreadSlot() {
+            Registry &registry = GetRegistry();
+            const std::lock_guard<std::mutex> lock{registry.mutex};
+            if (registry.freeBlocks.empty()) {
+                m_counters = new ThreadCounters{static_cast<uint32_t>(registry.blocks.size())};
+                registry.blocks.push_back(m_counters);
+            } else {
+                m_counters = registry.freeBlocks.back();
+                registry.freeBlocks.pop_back();
+            }
+        }
+
+        ThreadSlot(const ThreadSlot &) = delete;
+
+        ThreadSlot &operator=(const ThreadSlot &) = delete;
+
+        ~ThreadSlot() {
+            Registry &registry = GetRegistry();
+            const std::lock_guard<std::mutex> lock{registry.mutex};
+            registry.freeBlocks.push_back(m_counters);
+        }
+
+        [[nodiscard]] ThreadCounters &Counters() const { return *m_counters; }
+
+    private:
+        ThreadCounters *m_counters;
+    };
+
+    inline ThreadCounters &LocalCounters() {
+        thread_local ThreadSlot slot;
+        return slot.Counters();
+    }
+
+    // Called once per PROFILE_SCOPE by its static initializer
+    inline uint32_t RegisterSite(const char *name) {
+        Registry &registry = GetRegistry();
+        const uint32_t index = std::min(registry.siteCount.fetch_add(1), MAX_SITES - 1);
+        registry.siteNames[index].store(index == MAX_SITES - 1 ? "(other)" : name);
+        return index;
+    }
+
+    class ScopedTimer {
+    public:
+        explicit ScopedTimer(uint32_t site) : m_site(site), m_start(ReadTimestamp()) {}
+
+        ScopedTimer(const ScopedTimer &) = delete;
+
+        ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+        ~ScopedTimer() {
+            const uint64_t end = ReadTimestamp();
+            const uint64_t elapsed = end - m_start;
+            ThreadCounters &counters = LocalCounters();
+            // Single writer, a relaxed load and store is enough and avoids a locked add
+            std::atomic<uint64_t> &ticks = counters.ticks[m_site];
+            std::atomic<uint64_t> &calls = counters.calls[m_site];
+            ticks.store(ticks.load(std::memory_order_relaxed) + elapsed, std::memory_order_relaxed);
+            calls.store(calls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            counters.Record(m_site, m_start, end);
+        }
+
+    private:
+        uint32_t m_site;
+        uint64_t m_start;
+    };
+
+    struct ProfileEntry {
+        const char *name;
+        uint64_t calls;
+        uint64_t ticks;
+    };
+
+    // Totals of every site over every thread since the start, in registration order
+    // Subtract two snapshots for the counts of a period, counters are never reset
+    inline std::vector<ProfileEntry> CollectProfile() {
+        Registry &registry = GetRegistry();
+        const uint32_t siteCount = std::min(registry.siteCount.load(), MAX_SITES);
+        std::vector<ProfileEntry> entries(siteCount);
+        for (uint32_t site = 0; site < siteCount; site++) {
+            const char *name = registry.siteNames[site].load();
+            entries[site] = {name ? name : "", 0, 0};
+        }
+
+        const std::lock_guard<std::mutex> lock{registry.mutex};
+        for (const ThreadCounters *counters: registry.blocks) {
+            for (uint32_t site = 0; site < siteCount; site++) {
+                entries[site].calls += counters->calls[site].load(std::memory_order_relaxed);
+                entries[site].ticks += counters->ticks[site].load(std::memory_order_relaxed);
+            }
+        }
+        return entries;
+    }
+
+    // Instant event on the calling thread, shown as a marker with the value as its argument
+    inline void MarkInstant(uint32_t site, uint64_t value) {
+        LocalCounters().Record(site | INSTANT_EVENT, ReadTimestamp(), value);
+    }
+
+    // Name of the calling thread in the trace, name has to outlive the trace
+    inline void SetThreadName(const char *name) {
+        LocalCounters().name.store(name);
+    }
+
+    // Measured against steady_clock once, the first call takes about 20 ms
+    inline double TicksPerSecond() {
+        static const double ticksPerSecond = [] {
+            using Clock = std::chrono::steady_clock;
+            const Clock::time_point start = Clock::now();
+            const uint64_t startTicks = ReadTimestamp();
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            const uint64_t ticks = ReadTimestamp() - startTicks;
+            return static_cast<double>(ticks) / std::chrono::duration<double>(Clock::now() - start).count();
+        }();
+        return ticksPerSecond;
+    }
+
+    // Site names are string literals, only quotes and backslashes need escaping
+    inline void WriteJsonString(FILE *file, const char *string) {
+        fputc('"', file);
+        for (const char *c = string; *c; c++) {
+            if (*c == '"' || *c == '\\') fputc('\\', file);
+            fputc(*c, file);
+        }
+        fputc('"', file);
+    }
+
+    // Writes the events still in the ring buffers as Chrome trace JSON, while threads keep recording
+    // Timestamps are in microseconds from the oldest event written
+    inline bool WriteChromeTrace(const char *path) {
+        struct Event {
+            uint32_t thread;
+            uint32_t site;
+            uint64_t start;
+            uint64_t end;
+        };
+
+        Registry &registry = GetRegistry();
+        std::vector<Event> events;
+        std::vector<std::pair<uint32_t, const char *>> threads;
+        {
+            const std::lock_guard<std::mutex> lock{registry.mutex};
+            for (const ThreadCounters *counters: registry.blocks) {
+                threads.emplace_back(counters->id, counters->name.load());
+                const uint64_t count = counters->eventCount.load(std::memory_order_acquire);
+                const size_t firstEvent = events.size();
+                for (uint64_t i = count > TRACE_CAPACITY ? count - TRACE_CAPACITY : 0; i < count; i++) {
+                    const TraceEvent &event = counters->events[i % TRACE_CAPACITY];
+                    events.push_back({counters->id,
+                                      event.site.load(std::memory_order_relaxed),
+                                      event.start.load(std::memory_order_relaxed),
+                                      event.end.load(std::memory_order_relaxed)});
+                }
+                // Drops what the thread may have overwritten while copying, including the event it's writing now
+                const uint64_t countAfter = counters->eventCount.load(std::memory_order_acquire) + 1;
+                const uint64_t firstValid = countAfter > TRACE_CAPACITY ? countAfter - TRACE_CAPACITY : 0;
+                const uint64_t firstCopied = count > TRACE_CAPACITY ? count - TRACE_CAPACITY : 0;
+                if (firstValid > firstCopied) {
+                    const auto overwritten = static_cast<size_t>(std::min(firstValid - firstCopied, count - firstCopied));
+                    events.erase(events.begin() + static_cast<ptrdiff_t>(firstEvent), events.begin() + static_cast<ptrdiff_t>(firstEvent + overwritten));
+                }
+            }
+        }
+
+        FILE *file = fopen(path, "w");
+        if (!file) return false;
+
+        uint64_t origin = UINT64_MAX;
+        for (const Event &event: events) origin = std::min(origin, event.start);
+        const double microsecondsPerTick = 1e6 / TicksPerSecond();
+        const auto microseconds = [&](uint64_t ticks) { return static_cast<double>(ticks - origin) * microsecondsPerTick; };
+
+        fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+        bool first = true;
+        for (const auto &[id, name]: threads) {
+            fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", first ? "" : ",\n", id);
+            if (name) {
+                WriteJsonString(file, name);
+            } else {
+                fprintf(file, "\"Thread %u\"", id);
+            }
+            fprintf(file, "}}");
+            first = false;
+        }
+        for (const Event &event: events) {
+            const uint32_t site = event.site & ~INSTANT_EVENT;
+            const char *name = site < MAX_SITES ? registry.siteNames[site].load() : nullptr;
+            fprintf(file, "%s{\"name\":", first ? "" : ",\n");
+            WriteJsonString(file, name ? name : "");
+            if (event.site & INSTANT_EVENT) {
+                fprintf(file, ",\"ph\":\"i\",\"s\":\"p\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"args\":{\"value\":%llu}}",
+                        event.thread, microseconds(event.start), static_cast<unsigned long long>(event.end));
+            } else {
+                fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                        event.thread, microseconds(event.start), static_cast<double>(event.end - event.start) * microsecondsPerTick);
+            }
+            first = false;
+        }
+        fprintf(file, "\n]}\n");
+        return fclose(file) == 0;
+    }
+}
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+#define PROFILE_SCOPE(name) \
+    static const uint32_t PROFILE_CONCAT(profileSite, __LINE__) = Instrumentation::RegisterSite(name); \
+    const Instrumentation::ScopedTimer PROFILE_CONCAT(profileTimer, __LINE__){PROFILE_CONCAT(profileSite, __LINE__)}
+// Instant event with a value, frame markers for example
+#define PROFILE_MARK(name, value) \
+    do { \
+        static const uint32_t profileSite = Instrumentation::RegisterSite(name); \
+        Instrumentation::MarkInstant(profileSite, value); \
+    } while (false)
+#define PROFILE_THREAD_NAME(name) Instrumentation::SetThreadName(name)
+
+#else
+
+#define PROFILE_SCOPE(name) static_cast<void>(0)
+// Unevaluated, the value is only referenced so its variable isn't unused
+#define PROFILE_MARK(name, value) static_cast<void>(sizeof(value))
+#define PROFILE_THREAD_NAME(name) static_cast<void>(0)
+
+#endif
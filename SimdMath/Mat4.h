@@ -95,6 +95,8 @@ union alignas(16) Mat4 {
     static Mat4 LookAt(const Vec4 &eye, const Vec4 &target, const Vec4 &up);
 
     static Mat4 Perspective(float fov, float aspectRatio, float near, float far);
+
+    static Mat4 Ortho(float left, float right, float bottom, float top, float near, float far);
 };
 
 static_assert(sizeof(Mat4) == 4 * sizeof(Vec4));
@@ -174,3 +176,14 @@ inline Mat4 Mat4::Perspective(const float fov, const float aspectRatio, const fl
                 0.0f, 0.0f, 2.0f * far * near / (near - far), 0.0f};
     return result;
 }
+
+inline Mat4 Mat4::Ortho(const float left, const float right, const float bottom, const float top, const float near, const float far) {
+    const float invWidth = 1.0f / (right - left);
+    const float invHeight = 1.0f / (top - bottom);
+    const float invDepth = 1.0f / (far - near);
+    Mat4 result{2.0f * invWidth, 0.0f, 0.0f, 0.0f,
+                0.0f, 2.0f * invHeight, 0.0f, 0.0f,
+                0.0f, 0.0f, -2.0f * invDepth, 0.0f,
+                -(right + left) * invWidth, -(top + bottom) * invHeight, -(far + near) * invDepth, 1.0f};
+    return result;
+}
@@ -0,0 +1,362 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <immintrin.h>
+#include <limits>
+#include <vector>
+
+#include "AABB.h"
+#include "Instrumentation.h"
+#include "Parallel.h"
+#include "SoA.h"
+#include "Vec4.h"
+
+// w of center is 1
+struct BoundingSphere {
+    [[nodiscard]] BoundingSphere Union(const Vec4 &point) const {
+        const Vec4 d{_mm_blend_ps(_mm_sub_ps(point.m, center.m), _mm_setzero_ps(), 0b1000)};
+        const float distanceSquared = d.Dot(d);
+        if (distanceSquared <= radius * radius) return *this;
+        const float distance = std::sqrt(distanceSquared);
+        const float newRadius = (radius + distance) * 0.5f;
+        return {center + d * Vec4{(newRadius - radius) / distance}, newRadius};
+    }
+
+    [[nodiscard]] BoundingSphere Union(const BoundingSphere &sphere) const {
+        const Vec4 d{_mm_blend_ps(_mm_sub_ps(sphere.center.m, center.m), _mm_setzero_ps(), 0b1000)};
+        const float distance = d.Length();
+        if (distance + sphere.radius <= radius) return *this;
+        if (distance + radius <= sphere.radius) return sphere;
+        const float newRadius = (distance + radius + sphere.radius) * 0.5f;
+        return {center + d * Vec4{(newRadius - radius) / distance}, newRadius};
+    }
+
+    Vec4 center;
+    float radius;
+};
+
+// Every normal n of the mesh has axis.Dot(n) >= cosAngle
+// cosAngle is -1 when the normals cancel out and there is no useful axis
+struct NormalCone {
+    Vec4 axis;
+    float cosAngle;
+};
+
+struct MeshBounds {
+    AABB box;
+    // Average of the vertex positions, w is 1
+    Vec4 centroid;
+    BoundingSphere sphere;
+    NormalCone normalCone;
+};
+
+// Reductions over vertex streams, split into one contiguous range per thread
+// Vertex i is at byte offset i * stride, so Vertex arrays can be used directly, w of positions and normals is ignored
+namespace MeshReduction {
+    // Each range writes its result once, to its own cache line
+    template<typename T>
+    struct alignas(64) RangeResult {
+        T value;
+    };
+
+    struct FarthestPoint {
+        uint32_t index;
+        float distanceSquared;
+    };
+
+    inline const Vec4 &At(const uint8_t *bytes, size_t stride, size_t i) {
+        return *reinterpret_cast<const Vec4 *>(bytes + i * stride);
+    }
+
+    // xyz of vertices i to i + 7, one vertex per lane
+    inline void Load8(const uint8_t *bytes, size_t stride, size_t i, __m256 &x, __m256 &y, __m256 &z) {
+        const __m256 r0 = _mm256_set_m128(At(bytes, stride, i + 4).m, At(bytes, stride, i).m);
+        const __m256 r1 = _mm256_set_m128(At(bytes, stride, i + 5).m, At(bytes, stride, i + 1).m);
+        const __m256 r2 = _mm256_set_m128(At(bytes, stride, i + 6).m, At(bytes, stride, i + 2).m);
+        const __m256 r3 = _mm256_set_m128(At(bytes, stride, i + 7).m, At(bytes, stride, i + 3).m);
+        // x0 x1 y0 y1 | x4 x5 y4 y5
+        const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+        // x2 x3 y2 y3 | x6 x7 y6 y7
+        const __m256 t1 = _mm256_unpacklo_ps(r2, r3);
+        // z0 z1 w0 w1 | z4 z5 w4 w5
+        const __m256 t2 = _mm256_unpackhi_ps(r0, r1);
+        // z2 z3 w2 w3 | z6 z7 w6 w7
+        const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+        x = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+        y = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+        z = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    }
+
+    inline __m256 DistanceSquared(__m256 x, __m256 y, __m256 z, __m256 cx, __m256 cy, __m256 cz) {
+        const __m256 dx = _mm256_sub_ps(x, cx);
+        const __m256 dy = _mm256_sub_ps(y, cy);
+        const __m256 dz = _mm256_sub_ps(z, cz);
+        return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+    }
+
+    inline float DistanceSquared(const Vec4 &a, const Vec4 &b) {
+        const Vec4 d{_mm_blend_ps(_mm_sub_ps(a.m, b.m), _mm_setzero_ps(), 0b1000)};
+        return d.Dot(d);
+    }
+
+    inline float HorizontalSum(__m256 v) {
+        __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+        s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+        s = _mm_add_ss(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 1, 1, 1)));
+        return _mm_cvtss_f32(s);
+    }
+
+    inline double HorizontalSum(__m256d v) {
+        __m128d s = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+        s = _mm_add_sd(s, _mm_unpackhi_pd(s, s));
+        return _mm_cvtsd_f64(s);
+    }
+
+    // Adds the 8 lanes of v to sum as doubles, positions far from the origin don't lose the centroid
+    inline __m256d AddLanes(__m256d sum, __m256 v) {
+        sum = _mm256_add_pd(sum, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+        return _mm256_add_pd(sum, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+    }
+
+    // Runs func(begin, end) per range and combines the range results in range order
+    template<typename T, typename Func, typename Combine>
+    T Reduce(size_t count, Func &&func, Combine &&combine) {
+        std::vector<RangeResult<T>> results(ThreadCount());
+        const size_t rangeCount = ParallelFor(count, PARALLEL_THRESHOLD, [&](size_t range, size_t begin, size_t end) {
+            results[range].value = func(begin, end);
+        });
+        T result = results[0].value;
+        for (size_t range = 1; range < rangeCount; range++) result = combine(result, results[range].value);
+        return result;
+    }
+
+    // Lowest index among the farthest vertices from point, count > 0
+    inline FarthestPoint Farthest(const Vec4 *positions, size_t stride, size_t count, const Vec4 &point) {
+        const auto bytes = reinterpret_cast<const uint8_t *>(positions);
+        const __m256 px = _mm256_set1_ps(point.x);
+        const __m256 py = _mm256_set1_ps(point.y);
+        const __m256 pz = _mm256_set1_ps(point.z);
+        return Reduce<FarthestPoint>(count, [&](size_t begin, size_t end) {
+            __m256 best = _mm256_set1_ps(-1.0f);
+            __m256i bestIndex = _mm256_setzero_si256();
+            __m256i index = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(begin)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+            size_t i = begin;
+            for (; i + 8 <= end; i += 8) {
+                __m256 x, y, z;
+                Load8(bytes, stride, i, x, y, z);
+                const __m256 distanceSquared = DistanceSquared(x, y, z, px, py, pz);
+                const __m256 farther = _mm256_cmp_ps(distanceSquared, best, _CMP_GT_OQ);
+                best = _mm256_blendv_ps(best, distanceSquared, farther);
+                bestIndex = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(bestIndex), _mm256_castsi256_ps(index), farther));
+                index = _mm256_add_epi32(index, _mm256_set1_epi32(8));
+            }
+
+            alignas(32) float distances[8];
+            alignas(32) uint32_t indices[8];
+            _mm256_store_ps(distances, best);
+            _mm256_store_si256(reinterpret_cast<__m256i *>(indices), bestIndex);
+            FarthestPoint farthest{static_cast<uint32_t>(begin), -1.0f};
+            for (int lane = 0; lane < 8; lane++) {
+                if (distances[lane] > farthest.distanceSquared || (distances[lane] == farthest.distanceSquared && indices[lane] < farthest.index)) {
+                    farthest = {indices[lane], distances[lane]};
+                }
+            }
+            for (; i < end; i++) {
+                const float distanceSquared = DistanceSquared(At(bytes, stride, i), point);
+                if (distanceSquared > farthest.distanceSquared) farthest = {static_cast<uint32_t>(i), distanceSquared};
+            }
+            return farthest;
+        }, [](const FarthestPoint &a, const FarthestPoint &b) {
+            return b.distanceSquared > a.distanceSquared ? b : a;
+        });
+    }
+
+    // Ritter's growing pass, every range grows its own copy of sphere and the copies are merged
+    inline BoundingSphere Grow(const Vec4 *positions, size_t stride, size_t count, const BoundingSphere &sphere) {
+        const auto bytes = reinterpret_cast<const uint8_t *>(positions);
+        return Reduce<BoundingSphere>(count, [&](size_t begin, size_t end) {
+            BoundingSphere grown = sphere;
+            __m256 cx = _mm256_set1_ps(grown.center.x);
+            __m256 cy = _mm256_set1_ps(grown.center.y);
+            __m256 cz = _mm256_set1_ps(grown.center.z);
+            __m256 radiusSquared = _mm256_set1_ps(grown.radius * grown.radius);
+            size_t i = begin;
+            for (; i + 8 <= end; i += 8) {
+                __m256 x, y, z;
+                Load8(bytes, stride, i, x, y, z);
+                unsigned outside = _mm256_movemask_ps(_mm256_cmp_ps(DistanceSquared(x, y, z, cx, cy, cz), radiusSquared, _CMP_GT_OQ));
+                // Rare once the sphere has grown, the lanes are retested one by one against the growing sphere
+                if (!outside) continue;
+                while (outside) {
+                    const int lane = LowestLane(outside);
+                    outside &= outside - 1;
+                    grown = grown.Union(At(bytes, stride, i + lane));
+                }
+                cx = _mm256_set1_ps(grown.center.x);
+                cy = _mm256_set1_ps(grown.center.y);
+                cz = _mm256_set1_ps(grown.center.z);
+                radiusSquared = _mm256_set1_ps(grown.radius * grown.radius);
+            }
+            for (; i < end; i++) grown = grown.Union(At(bytes, stride, i));
+            return grown;
+        }, [](const BoundingSphere &a, const BoundingSphere &b) {
+            return a.Union(b);
+        });
+    }
+
+    // Smallest dot product of axis with the normals
+    inline float MinDot(const Vec4 *normals, size_t stride, size_t count, const Vec4 &axis) {
+        const auto bytes = reinterpret_cast<const uint8_t *>(normals);
+        const __m256 ax = _mm256_set1_ps(axis.x);
+        const __m256 ay = _mm256_set1_ps(axis.y);
+        const __m256 az = _mm256_set1_ps(axis.z);
+        return Reduce<float>(count, [&](size_t begin, size_t end) {
+            __m256 minDot = _mm256_set1_ps(1.0f);
+            size_t i = begin;
+            for (; i + 8 <= end; i += 8) {
+                __m256 x, y, z;
+                Load8(bytes, stride, i, x, y, z);
+                const __m256 dot = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, ax), _mm256_mul_ps(y, ay)), _mm256_mul_ps(z, az));
+                minDot = _mm256_min_ps(minDot, dot);
+            }
+            float result = HorizontalMin(minDot);
+            for (; i < end; i++) {
+                const Vec4 &n = At(bytes, stride, i);
+                result = std::min(result, n.x * axis.x + n.y * axis.y + n.z * axis.z);
+            }
+            return result;
+        }, [](float a, float b) {
+            return std::min(a, b);
+        });
+    }
+}
+
+// The min and max reduction alone, for meshes that deform every frame
+inline AABB ComputeAABB(const Vec4 *positions, size_t stride, size_t count) {
+    using namespace MeshReduction;
+    const auto bytes = reinterpret_cast<const uint8_t *>(positions);
+    return Reduce<AABB>(count, [&](size_t begin, size_t end) {
+        // 2 vertices per register and 2 independent chains
+        const __m256 inf = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+        __m256 min0 = inf, min1 = inf;
+        __m256 max0 = _mm256_sub_ps(_mm256_setzero_ps(), inf), max1 = max0;
+        size_t i = begin;
+        for (; i + 4 <= end; i += 4) {
+            const __m256 a = _mm256_set_m128(At(bytes, stride, i + 1).m, At(bytes, stride, i).m);
+            const __m256 b = _mm256_set_m128(At(bytes, stride, i + 3).m, At(bytes, stride, i + 2).m);
+            min0 = _mm256_min_ps(min0, a);
+            max0 = _mm256_max_ps(max0, a);
+            min1 = _mm256_min_ps(min1, b);
+            max1 = _mm256_max_ps(max1, b);
+        }
+        min0 = _mm256_min_ps(min0, min1);
+        max0 = _mm256_max_ps(max0, max1);
+        AABB box{Vec4{_mm_min_ps(_mm256_castps256_ps128(min0), _mm256_extractf128_ps(min0, 1))},
+                 Vec4{_mm_max_ps(_mm256_castps256_ps128(max0), _mm256_extractf128_ps(max0, 1))}};
+        for (; i < end; i++) box = box.Union(At(bytes, stride, i));
+        return box;
+    }, [](const AABB &a, const AABB &b) {
+        return a.Union(b);
+    });
+}
+
+// normals: nullptr skips the normal cone, otherwise unit length normals with the same stride as positions
+// Sphere: Ritter's sphere, refined by shrinking its radius to the farthest vertex from its final center,
+//         the sphere around the centroid is used instead when it is smaller
+inline MeshBounds ComputeMeshBounds(const Vec4 *positions, const Vec4 *normals, size_t stride, size_t count) {
+    PROFILE_SCOPE("ComputeMeshBounds");
+    using namespace MeshReduction;
+    MeshBounds bounds{AABB::Empty(), Vec4{0.0f, 0.0f, 0.0f, 1.0f}, {Vec4{0.0f, 0.0f, 0.0f, 1.0f}, 0.0f}, {Vec4{0.0f, 0.0f, 1.0f, 0.0f}, -1.0f}};
+    if (count == 0) return bounds;
+
+    // Box, sum of positions and sum of normals in one pass
+    struct Sums {
+        AABB box;
+        double position[3];
+        float normal[3];
+    };
+    const auto positionBytes = reinterpret_cast<const uint8_t *>(positions);
+    const auto normalBytes = reinterpret_cast<const uint8_t *>(normals);
+    const Sums sums = Reduce<Sums>(count, [&](size_t begin, size_t end) {
+        const __m256 inf = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+        const __m256 negativeInf = _mm256_sub_ps(_mm256_setzero_ps(), inf);
+        __m256 minX = inf, minY = inf, minZ = inf;
+        __m256 maxX = negativeInf, maxY = negativeInf, maxZ = negativeInf;
+        __m256d sumX = _mm256_setzero_pd(), sumY = _mm256_setzero_pd(), sumZ = _mm256_setzero_pd();
+        __m256 normalX = _mm256_setzero_ps(), normalY = _mm256_setzero_ps(), normalZ = _mm256_setzero_ps();
+        size_t i = begin;
+        for (; i + 8 <= end; i += 8) {
+            __m256 x, y, z;
+            Load8(positionBytes, stride, i, x, y, z);
+            minX = _mm256_min_ps(minX, x);
+            minY = _mm256_min_ps(minY, y);
+            minZ = _mm256_min_ps(minZ, z);
+            maxX = _mm256_max_ps(maxX, x);
+            maxY = _mm256_max_ps(maxY, y);
+            maxZ = _mm256_max_ps(maxZ, z);
+            sumX = AddLanes(sumX, x);
+            sumY = AddLanes(sumY, y);
+            sumZ = AddLanes(sumZ, z);
+            if (normals) {
+                Load8(normalBytes, stride, i, x, y, z);
+                normalX = _mm256_add_ps(normalX, x);
+                normalY = _mm256_add_ps(normalY, y);
+                normalZ = _mm256_add_ps(normalZ, z);
+            }
+        }
+
+        Sums result{{Vec4{HorizontalMin(minX), HorizontalMin(minY), HorizontalMin(minZ), 1.0f},
+                     Vec4{HorizontalMax(maxX), HorizontalMax(maxY), HorizontalMax(maxZ), 1.0f}},
+                    {HorizontalSum(sumX), HorizontalSum(sumY), HorizontalSum(sumZ)},
+                    {HorizontalSum(normalX), HorizontalSum(normalY), HorizontalSum(normalZ)}};
+        for (; i < end; i++) {
+            const Vec4 &p = At(positionBytes, stride, i);
+            result.box = result.box.Union(p);
+            for (int axis = 0; axis < 3; axis++) result.position[axis] += p[axis];
+            if (normals) {
+                const Vec4 &n = At(normalBytes, stride, i);
+                for (int axis = 0; axis < 3; axis++) result.normal[axis] += n[axis];
+            }
+        }
+        return result;
+    }, [](const Sums &a, const Sums &b) {
+        return Sums{a.box.Union(b.box),
+                    {a.position[0] + b.position[0], a.position[1] + b.position[1], a.position[2] + b.position[2]},
+                    {a.normal[0] + b.normal[0], a.normal[1] + b.normal[1], a.normal[2] + b.normal[2]}};
+    });
+
+    bounds.box = sums.box;
+    bounds.centroid = Vec4{static_cast<float>(sums.position[0] / static_cast<double>(count)),
+                           static_cast<float>(sums.position[1] / static_cast<double>(count)),
+                           static_cast<float>(sums.position[2] / static_cast<double>(count)),
+                           1.0f};
+
+    // Ritter: the farthest vertex from the centroid and the farthest vertex from that span the initial sphere
+    const FarthestPoint fromCentroid = Farthest(positions, stride, count, bounds.centroid);
+    const Vec4 &p = At(positionBytes, stride, fromCentroid.index);
+    const Vec4 &q = At(positionBytes, stride, Farthest(positions, stride, count, p).index);
+    BoundingSphere sphere{Vec4{_mm_blend_ps(_mm_mul_ps(_mm_add_ps(p.m, q.m), _mm_set_ps1(0.5f)), _mm_set_ps1(1.0f), 0b1000)},
+                          std::sqrt(DistanceSquared(p, q)) * 0.5f};
+    sphere = Grow(positions, stride, count, sphere);
+    // Merging the range spheres overshoots, the farthest vertex from the final center gives the tight radius
+    sphere.radius = std::sqrt(Farthest(positions, stride, count, sphere.center).distanceSquared);
+    const float centroidRadius = std::sqrt(fromCentroid.distanceSquared);
+    bounds.sphere = centroidRadius < sphere.radius ? BoundingSphere{bounds.centroid, centroidRadius} : sphere;
+
+    if (normals) {
+        const Vec4 sum{sums.normal[0], sums.normal[1], sums.normal[2], 0.0f};
+        const float length = sum.Length();
+        // Normals that cancel out don't have a meaningful average direction
+        if (length > 1e-3f * static_cast<float>(count)) {
+            bounds.normalCone.axis = sum * Vec4{1.0f / length};
+            bounds.normalCone.cosAngle = std::min(MinDot(normals, stride, count, bounds.normalCone.axis), 1.0f);
+        }
+    }
+    return bounds;
+}
@@ -0,0 +1,157 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <immintrin.h>
+#include <vector>
+
+#include "Instrumentation.h"
+
+// Index buffer construction for triangle lists
+namespace MeshIndexing {
+    inline uint32_t HashBytes(const uint8_t *bytes, size_t size) {
+        uint64_t hash = 0;
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            uint64_t word;
+            memcpy(&word, bytes + i, 8);
+            hash = _mm_crc32_u64(hash, word);
+        }
+        for (; i < size; i++) hash = _mm_crc32_u8(static_cast<uint32_t>(hash), bytes[i]);
+        return static_cast<uint32_t>(hash);
+    }
+
+    // Bitwise, so 0.0f and -0.0f are different and a NaN equals itself
+    inline bool EqualBytes(const uint8_t *a, const uint8_t *b, size_t size) {
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16) {
+            const __m128i equal = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i)),
+                                                 _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i)));
+            if (_mm_movemask_epi8(equal) != 0xFFFF) return false;
+        }
+        return memcmp(a + i, b + i, size - i) == 0;
+    }
+
+    // Merges bitwise identical vertices, unique keeps the first of each in input order
+    // indices[i] is the index of vertices[i] in unique, Index has to fit unique.size() - 1
+    // Padding bytes of Vertex take part in the comparison, so they have to be initialized
+    template<typename Vertex, typename Index>
+    void Weld(const Vertex *vertices, size_t count, std::vector<Vertex> &unique, std::vector<Index> &indices) {
+        PROFILE_SCOPE("MeshIndexing::Weld");
+        const auto *bytes = reinterpret_cast<const uint8_t *>(vertices);
+
+        // Open addressing with linear probing, at most half full, slots hold unique index + 1
+        size_t tableSize = 16;
+        while (tableSize < count * 2) tableSize *= 2;
+        const size_t mask = tableSize - 1;
+        std::vector<uint32_t> table(tableSize);
+
+        unique.clear();
+        indices.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            const uint8_t *vertex = bytes + i * sizeof(Vertex);
+            size_t slot = HashBytes(vertex, sizeof(Vertex)) & mask;
+            while (table[slot] && !EqualBytes(reinterpret_cast<const uint8_t *>(&unique[table[slot] - 1]), vertex, sizeof(Vertex))) {
+                slot = (slot + 1) & mask;
+            }
+            if (!table[slot]) {
+                unique.push_back(vertices[i]);
+                table[slot] = static_cast<uint32_t>(unique.size());
+            }
+            indices[i] = static_cast<Index>(table[slot] - 1);
+        }
+    }
+
+    // Average number of vertex shader invocations per triangle with a FIFO post-transform cache
+    // 3 when nothing is reused, approaches 0.5 on large regular grids
+    template<typename Index>
+    float AverageCacheMissRatio(const Index *indices, size_t indexCount, size_t vertexCount, unsigned cacheSize = 16) {
+        // A vertex is cached while fewer than cacheSize misses happened since its own
+        std::vector<uint64_t> missTime(vertexCount, 0);
+        uint64_t misses = 0;
+        for (size_t i = 0; i < indexCount; i++) {
+            const Index v = indices[i];
+            if (missTime[v] == 0 || misses - missTime[v] >= cacheSize) missTime[v] = ++misses;
+        }
+        return indexCount ? static_cast<float>(misses) / static_cast<float>(indexCount / 3) : 0.0f;
+    }
+
+    // Tipsify (Sander et al. 2007), reorders triangles for the post-transform vertex cache in linear time
+    // Triangles keep their winding, cacheSize is the FIFO size it optimizes for
+    template<typename Index>
+    std::vector<Index> OptimizeVertexCache(const Index *indices, size_t indexCount, size_t vertexCount, unsigned cacheSize = 16) {
+        PROFILE_SCOPE("MeshIndexing::OptimizeVertexCache");
+        const size_t triangleCount = indexCount / 3;
+
+        // Triangles of every vertex, triangles[offsets[v]] to triangles[offsets[v + 1]]
+        std::vector<uint32_t> live(vertexCount, 0);
+        for (size_t i = 0; i < triangleCount * 3; i++) live[indices[i]]++;
+        std::vector<size_t> offsets(vertexCount + 1, 0);
+        for (size_t v = 0; v < vertexCount; v++) offsets[v + 1] = offsets[v] + live[v];
+        std::vector<uint32_t> triangles(offsets[vertexCount]);
+        {
+            std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+            for (size_t i = 0; i < triangleCount * 3; i++) triangles[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+
+        std::vector<uint64_t> cacheTime(vertexCount, 0);
+        std::vector<bool> emitted(triangleCount, false);
+        std::vector<Index> deadEnd;
+        std::vector<Index> candidates;
+        std::vector<Index> result;
+        result.reserve(triangleCount * 3);
+        uint64_t time = cacheSize + 1;
+        size_t cursor = 0;
+
+        // Any vertex with triangles left, recently used ones first
+        const auto skipDeadEnd = [&]() -> int64_t {
+            while (!deadEnd.empty()) {
+                const Index v = deadEnd.back();
+                deadEnd.pop_back();
+                if (live[v] > 0) return v;
+            }
+            for (; cursor < vertexCount; cursor++) {
+                if (live[cursor] > 0) return static_cast<int64_t>(cursor);
+            }
+            return -1;
+        };
+
+        int64_t fanning = vertexCount ? skipDeadEnd() : -1;
+        while (fanning >= 0) {
+            candidates.clear();
+            for (size_t t = offsets[fanning]; t < offsets[fanning + 1]; t++) {
+                const uint32_t triangle = triangles[t];
+                if (emitted[triangle]) continue;
+                emitted[triangle] = true;
+                for (size_t corner = 0; corner < 3; corner++) {
+                    const Index v = indices[triangle * 3 + corner];
+                    result.push_back(v);
+                    deadEnd.push_back(v);
+                    candidates.push_back(v);
+                    live[v]--;
+                    if (time - cacheTime[v] > cacheSize) cacheTime[v] = time++;
+                }
+            }
+
+            // The candidate that stays in the cache longest while its remaining triangles are emitted
+            int64_t next = -1;
+            int64_t bestPriority = -1;
+            for (const Index v: candidates) {
+                if (live[v] == 0) continue;
+                int64_t priority = 0;
+                const auto age = static_cast<int64_t>(time - cacheTime[v]);
+                if (age + 2 * static_cast<int64_t>(live[v]) <= static_cast<int64_t>(cacheSize)) priority = age;
+                if (priority > bestPriority) {
+                    bestPriority = priority;
+                    next = v;
+                }
+            }
+            fanning = next >= 0 ? next : skipDeadEnd();
+        }
+        return result;
+    }
+}
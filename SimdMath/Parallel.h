@@ -0,0 +1,173 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Instrumentation.h"
+
+// Minimal fork-join helpers on std::thread
+
+inline unsigned ThreadCount() {
+    const unsigned count = std::thread::hardware_concurrency();
+    return count ? count : 1;
+}
+
+// Runs a on a new thread and b on the calling thread, returns when both are done
+template<typename A, typename B>
+void ParallelInvoke(A &&a, B &&b) {
+    std::thread thread{[&a] {
+        PROFILE_THREAD_NAME("ParallelInvoke worker");
+        PROFILE_SCOPE("ParallelInvoke task");
+        a();
+    }};
+    {
+        PROFILE_SCOPE("ParallelInvoke task");
+        b();
+    }
+    thread.join();
+}
+
+// Default minRangeSize of the SimdMath kernels, below that many elements the thread starts cost more than they save
+constexpr size_t PARALLEL_THRESHOLD = 16 * 1024;
+
+// At most one range per thread, each at least minRangeSize long
+inline size_t RangeCount(size_t count, size_t minRangeSize, size_t threadCount) {
+    const size_t maxRanges = std::max<size_t>(count / std::max<size_t>(minRangeSize, 1), 1);
+    return std::min<size_t>(threadCount, maxRanges);
+}
+
+// Splits [0, count) into at most one contiguous range per hardware thread, each at least minRangeSize long
+// func(rangeIndex, begin, end) runs once per range, the calling thread takes the first range
+// Returns the number of ranges
+// The ranges only depend on count, minRangeSize and ThreadCount(), so calls with the same count and minRangeSize
+// get the same ranges, and a pass can use what the same range of an earlier pass wrote
+template<typename Func>
+size_t ParallelFor(size_t count, size_t minRangeSize, Func &&func) {
+    const size_t rangeCount = RangeCount(count, minRangeSize, ThreadCount());
+    const size_t rangeSize = (count + rangeCount - 1) / rangeCount;
+
+    std::vector<std::thread> threads;
+    threads.reserve(rangeCount - 1);
+    for (size_t range = 1; range < rangeCount; range++) {
+        const size_t begin = std::min(range * rangeSize, count);
+        const size_t end = std::min(begin + rangeSize, count);
+        threads.emplace_back([&func, range, begin, end] {
+            PROFILE_THREAD_NAME("ParallelFor worker");
+            PROFILE_SCOPE("ParallelFor range");
+            func(range, begin, end);
+        });
+    }
+    {
+        PROFILE_SCOPE("ParallelFor range");
+        func(static_cast<size_t>(0), static_cast<size_t>(0), std::min(rangeSize, count));
+    }
+    for (std::thread &thread: threads) thread.join();
+    return rangeCount;
+}
+
+// Threads started once and reused, for callers of ParallelFor in a loop, like every frame
+// ParallelFor starts and joins a thread per range on every call, For only wakes the waiting workers
+class WorkerPool {
+public:
+    explicit WorkerPool(unsigned threadCount = ::ThreadCount())
+        : m_threadCount{std::max(threadCount, 1u)} {
+        m_workers.reserve(m_threadCount - 1);
+        for (unsigned worker = 1; worker < m_threadCount; worker++) m_workers.emplace_back([this, worker] { Work(worker); });
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            m_stop = true;
+        }
+        m_start.notify_all();
+        for (std::thread &worker: m_workers) worker.join();
+    }
+
+    WorkerPool(const WorkerPool &) = delete;
+
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    [[nodiscard]] unsigned ThreadCount() const { return m_threadCount; }
+
+    // Same as ParallelFor with the threads of the pool, one call at a time
+    template<typename Func>
+    size_t For(size_t count, size_t minRangeSize, Func &&func) {
+        const size_t rangeCount = RangeCount(count, minRangeSize, m_threadCount);
+        const size_t rangeSize = (count + rangeCount - 1) / rangeCount;
+        const auto run = [&](size_t range) {
+            const size_t begin = std::min(range * rangeSize, count);
+            func(range, begin, std::min(begin + rangeSize, count));
+        };
+
+        if (rangeCount > 1) {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            m_task = &run;
+            m_invoke = [](const void *task, size_t range) { (*static_cast<const decltype(run) *>(task))(range); };
+            m_rangeCount = rangeCount;
+            m_pending = rangeCount - 1;
+            m_generation++;
+        }
+        if (rangeCount > 1) m_start.notify_all();
+        {
+            PROFILE_SCOPE("WorkerPool range");
+            run(0);
+        }
+        if (rangeCount > 1) {
+            std::unique_lock<std::mutex> lock{m_mutex};
+            m_done.wait(lock, [this] { return m_pending == 0; });
+        }
+        return rangeCount;
+    }
+
+private:
+    void Work(unsigned worker) {
+        PROFILE_THREAD_NAME("WorkerPool worker");
+        uint64_t generation = 0;
+        while (true) {
+            const void *task;
+            void (*invoke)(const void *, size_t);
+            size_t rangeCount;
+            {
+                std::unique_lock<std::mutex> lock{m_mutex};
+                m_start.wait(lock, [&] { return m_stop || m_generation != generation; });
+                if (m_stop) return;
+                generation = m_generation;
+                task = m_task;
+                invoke = m_invoke;
+                rangeCount = m_rangeCount;
+            }
+            // Workers past the range count have nothing to do this time
+            if (worker >= rangeCount) continue;
+            {
+                PROFILE_SCOPE("WorkerPool range");
+                invoke(task, worker);
+            }
+            std::lock_guard<std::mutex> lock{m_mutex};
+            if (--m_pending == 0) m_done.notify_one();
+        }
+    }
+
+    unsigned m_threadCount;
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_start;
+    std::condition_variable m_done;
+    // The range function of the current For, called as m_invoke(m_task, range)
+    const void *m_task = nullptr;
+    void (*m_invoke)(const void *, size_t) = nullptr;
+    size_t m_rangeCount = 0;
+    size_t m_pending = 0;
+    uint64_t m_generation = 0;
+    bool m_stop = false;
+};
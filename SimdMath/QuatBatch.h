@@ -0,0 +1,226 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#pragma once
+
+#include "Mat4.h"
+#include "SoA.h"
+#include "Trig.h"
+
+// Rotation orders name the axes in the order they are applied to a vector
+// XYZ rotates around x first, then y, then z: q = qz * qy * qx
+enum class EulerOrder {
+    XYZ,
+    XZY,
+    YXZ,
+    YZX,
+    ZXY,
+    ZYX
+};
+
+// Axes of each EulerOrder in the order they are applied
+constexpr int EULER_AXES[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+
+// Structure-of-arrays quaternion kernels, 4 quaternions per iteration
+namespace QuatBatch {
+    // 4 quaternions in SoA registers
+    struct Quat4 {
+        __m128 x;
+        __m128 y;
+        __m128 z;
+        __m128 w;
+    };
+
+    // Same as Quat::operator*, lane by lane
+    inline Quat4 Multiply(const Quat4 &a, const Quat4 &b) {
+        return {_mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(a.w, b.x), _mm_mul_ps(a.x, b.w)), _mm_mul_ps(a.y, b.z)), _mm_mul_ps(a.z, b.y)),
+                _mm_add_ps(_mm_add_ps(_mm_sub_ps(_mm_mul_ps(a.w, b.y), _mm_mul_ps(a.x, b.z)), _mm_mul_ps(a.y, b.w)), _mm_mul_ps(a.z, b.x)),
+                _mm_add_ps(_mm_sub_ps(_mm_add_ps(_mm_mul_ps(a.w, b.z), _mm_mul_ps(a.x, b.y)), _mm_mul_ps(a.y, b.x)), _mm_mul_ps(a.z, b.w)),
+                _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(_mm_mul_ps(a.w, b.w), _mm_mul_ps(a.x, b.x)), _mm_mul_ps(a.y, b.y)), _mm_mul_ps(a.z, b.z))};
+    }
+
+    inline Quat4 Load(const Vec4SoA &quats, size_t i, size_t count) {
+        return {LoadLanes(quats.x + i, count),
+                LoadLanes(quats.y + i, count),
+                LoadLanes(quats.z + i, count),
+                LoadLanes(quats.w + i, count)};
+    }
+
+    inline void Store(const Vec4SoA &quats, size_t i, const Quat4 &q, size_t count) {
+        StoreLanes(quats.x + i, q.x, count);
+        StoreLanes(quats.y + i, q.y, count);
+        StoreLanes(quats.z + i, q.z, count);
+        StoreLanes(quats.w + i, q.w, count);
+    }
+
+    // Axes don't need to be normalized, same as Quat(const Vec4 &axis, float theta)
+    inline void FromAxisAngle(size_t count, const Vec3SoA &axes, const float *angles, const Vec4SoA &out) {
+        for (size_t i = 0; i < count; i += 4) {
+            const size_t n = count - i;
+            const __m128 x = LoadLanes(axes.x + i, n);
+            const __m128 y = LoadLanes(axes.y + i, n);
+            const __m128 z = LoadLanes(axes.z + i, n);
+            const __m128 halfTheta = _mm_mul_ps(LoadLanes(angles + i, n), _mm_set_ps1(0.5f));
+
+            __m128 s, c;
+            SinCos(halfTheta, s, c);
+
+            const __m128 lenSqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+            const __m128 scale = _mm_div_ps(s, _mm_sqrt_ps(lenSqr));
+            Store(out, i, {_mm_mul_ps(x, scale), _mm_mul_ps(y, scale), _mm_mul_ps(z, scale), c}, n);
+        }
+    }
+
+    // angles: rotation around x, y and z in radians
+    inline void FromEuler(size_t count, const Vec3SoA &angles, EulerOrder order, const Vec4SoA &out) {
+        const int *axes = EULER_AXES[static_cast<int>(order)];
+        const __m128 half = _mm_set_ps1(0.5f);
+        for (size_t i = 0; i < count; i += 4) {
+            const size_t n = count - i;
+            __m128 s[3], c[3];
+            SinCos(_mm_mul_ps(LoadLanes(angles.x + i, n), half), s[0], c[0]);
+            SinCos(_mm_mul_ps(LoadLanes(angles.y + i, n), half), s[1], c[1]);
+            SinCos(_mm_mul_ps(LoadLanes(angles.z + i, n), half), s[2], c[2]);
+
+            Quat4 q[3];
+            for (int axis = 0; axis < 3; axis++) {
+                __m128 v[3] = {_mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps()};
+                v[axis] = s[axis];
+                q[axis] = {v[0], v[1], v[2], c[axis]};
+            }
+
+            Store(out, i, Multiply(q[axes[2]], Multiply(q[axes[1]], q[axes[0]])), n);
+        }
+    }
+
+    // Inverse of FromEuler, the middle angle is in [-pi/2, pi/2]
+    // Quaternions must be normalized
+    inline void ToEuler(size_t count, const Vec4SoA &quats, EulerOrder order, const Vec3SoA &out) {
+        const int *axes = EULER_AXES[static_cast<int>(order)];
+        const int a = axes[0];
+        const int b = axes[1];
+        const int c = axes[2];
+        // XYZ, YZX and ZXY are even permutations
+        const bool even = (b - a + 3) % 3 == 1;
+        const __m128 sign = _mm_set_ps1(even ? 1.0f : -1.0f);
+        const __m128 one = _mm_set_ps1(1.0f);
+        const __m128 two = _mm_set_ps1(2.0f);
+
+        for (size_t i = 0; i < count; i += 4) {
+            const size_t n = count - i;
+            const Quat4 q = Load(quats, i, n);
+
+            const __m128 xx = _mm_mul_ps(q.x, q.x);
+            const __m128 yy = _mm_mul_ps(q.y, q.y);
+            const __m128 zz = _mm_mul_ps(q.z, q.z);
+            const __m128 xy = _mm_mul_ps(q.x, q.y);
+            const __m128 yz = _mm_mul_ps(q.y, q.z);
+            const __m128 xz = _mm_mul_ps(q.x, q.z);
+            const __m128 wx = _mm_mul_ps(q.w, q.x);
+            const __m128 wy = _mm_mul_ps(q.w, q.y);
+            const __m128 wz = _mm_mul_ps(q.w, q.z);
+
+            // Rotation matrix, r[row][column], same as Quat::ToMat4
+            __m128 r[3][3];
+            r[0][0] = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz)));
+            r[0][1] = _mm_mul_ps(two, _mm_sub_ps(xy, wz));
+            r[0][2] = _mm_mul_ps(two, _mm_add_ps(xz, wy));
+            r[1][0] = _mm_mul_ps(two, _mm_add_ps(xy, wz));
+            r[1][1] = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz)));
+            r[1][2] = _mm_mul_ps(two, _mm_sub_ps(yz, wx));
+            r[2][0] = _mm_mul_ps(two, _mm_sub_ps(xz, wy));
+            r[2][1] = _mm_mul_ps(two, _mm_add_ps(yz, wx));
+            r[2][2] = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy)));
+
+            __m128 result[3];
+            result[a] = Atan2(_mm_mul_ps(sign, r[c][b]), r[c][c]);
+            result[b] = Asin(_mm_mul_ps(sign, _mm_sub_ps(_mm_setzero_ps(), r[c][a])));
+            result[c] = Atan2(_mm_mul_ps(sign, r[b][a]), r[a][a]);
+
+            StoreLanes(out.x + i, result[0], n);
+            StoreLanes(out.y + i, result[1], n);
+            StoreLanes(out.z + i, result[2], n);
+        }
+    }
+
+    // Exponential map of the rotation omega * dt, the delta rotation of one integration step
+    // Stable for zero and tiny angular velocities
+    inline void FromAngularVelocity(size_t count, const Vec3SoA &omega, float dt, const Vec4SoA &out) {
+        const __m128 halfDt = _mm_set_ps1(dt * 0.5f);
+        for (size_t i = 0; i < count; i += 4) {
+            const size_t n = count - i;
+            // Half rotation vector
+            const __m128 x = _mm_mul_ps(LoadLanes(omega.x + i, n), halfDt);
+            const __m128 y = _mm_mul_ps(LoadLanes(omega.y + i, n), halfDt);
+            const __m128 z = _mm_mul_ps(LoadLanes(omega.z + i, n), halfDt);
+
+            const __m128 halfThetaSqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+            const __m128 halfTheta = _mm_sqrt_ps(halfThetaSqr);
+
+            __m128 s, c;
+            SinCos(halfTheta, s, c);
+
+            // sin(h) / h, Taylor series below 1e-2 where the division loses precision
+            const __m128 series = _mm_add_ps(_mm_set_ps1(1.0f),
+                                             _mm_mul_ps(halfThetaSqr,
+                                                        _mm_add_ps(_mm_set_ps1(-1.0f / 6.0f),
+                                                                   _mm_mul_ps(halfThetaSqr, _mm_set_ps1(1.0f / 120.0f)))));
+            const __m128 small = _mm_cmplt_ps(halfTheta, _mm_set_ps1(1e-2f));
+            const __m128 sinc = _mm_blendv_ps(_mm_div_ps(s, halfTheta), series, small);
+
+            Store(out, i, {_mm_mul_ps(x, sinc), _mm_mul_ps(y, sinc), _mm_mul_ps(z, sinc), c}, n);
+        }
+    }
+
+    // Same as Quat::ToMat4 with the translation in the last column, quaternions must be normalized
+    // translations can be nullptr for rotation matrices
+    inline void ToMat4(size_t count, const Vec4SoA &quats, const Vec3SoA *translations, Mat4 *out) {
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set_ps1(1.0f);
+        const __m128 two = _mm_set_ps1(2.0f);
+
+        for (size_t i = 0; i < count; i += 4) {
+            const size_t n = count - i;
+            const Quat4 q = Load(quats, i, n);
+
+            const __m128 xx = _mm_mul_ps(q.x, q.x);
+            const __m128 yy = _mm_mul_ps(q.y, q.y);
+            const __m128 zz = _mm_mul_ps(q.z, q.z);
+            const __m128 xy = _mm_mul_ps(q.x, q.y);
+            const __m128 yz = _mm_mul_ps(q.y, q.z);
+            const __m128 xz = _mm_mul_ps(q.x, q.z);
+            const __m128 wx = _mm_mul_ps(q.w, q.x);
+            const __m128 wy = _mm_mul_ps(q.w, q.y);
+            const __m128 wz = _mm_mul_ps(q.w, q.z);
+
+            // m[column][row] of 4 matrices
+            __m128 m[4][4];
+            m[0][0] = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz)));
+            m[0][1] = _mm_mul_ps(two, _mm_add_ps(xy, wz));
+            m[0][2] = _mm_mul_ps(two, _mm_sub_ps(xz, wy));
+            m[0][3] = zero;
+            m[1][0] = _mm_mul_ps(two, _mm_sub_ps(xy, wz));
+            m[1][1] = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz)));
+            m[1][2] = _mm_mul_ps(two, _mm_add_ps(yz, wx));
+            m[1][3] = zero;
+            m[2][0] = _mm_mul_ps(two, _mm_add_ps(xz, wy));
+            m[2][1] = _mm_mul_ps(two, _mm_sub_ps(yz, wx));
+            m[2][2] = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy)));
+            m[2][3] = zero;
+            m[3][0] = translations ? LoadLanes(translations->x + i, n) : zero;
+            m[3][1] = translations ? LoadLanes(translations->y + i, n) : zero;
+            m[3][2] = translations ? LoadLanes(translations->z + i, n) : zero;
+            m[3][3] = one;
+
+            // Same as CameraBatch::StoreMatrices
+            for (int column = 0; column < 4; column++) {
+                _MM_TRANSPOSE4_PS(m[column][0], m[column][1], m[column][2], m[column][3]);
+            }
+            const size_t views = n < 4 ? n : 4;
+            for (size_t view = 0; view < views; view++) {
+                out[i + view] = {m[0][view], m[1][view], m[2][view], m[3][view]};
+            }
+        }
+    }
+}
@@ -0,0 +1,178 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#pragma once
+
+#include <limits>
+
+#include "AABB.h"
+
+// origin: (x, y, z, 1)
+// direction: (x, y, z, 0), doesn't need to be normalized, distances are in units of its length
+// tMax must be finite, so the +infinity lanes of AABB4 and AABB8 don't count as hits
+struct Ray {
+    Ray() = default;
+
+    Ray(const Vec4 &origin, const Vec4 &direction, float tMin = 0.0f, float tMax = std::numeric_limits<float>::max())
+        : origin{origin}, direction{direction}, invDirection{Vec4{1.0f} / direction}, tMin{tMin}, tMax{tMax} {}
+
+    Vec4 origin;
+    Vec4 direction;
+    // Zero components become infinities, the slab tests below handle them
+    Vec4 invDirection;
+    float tMin = 0.0f;
+    float tMax = std::numeric_limits<float>::max();
+};
+
+// 4 rays in SoA registers, for coherent ray packets
+struct RayPacket4 {
+    RayPacket4() = default;
+
+    explicit RayPacket4(const Ray rays[4]) {
+        __m128 o0 = rays[0].origin.m, o1 = rays[1].origin.m, o2 = rays[2].origin.m, o3 = rays[3].origin.m;
+        _MM_TRANSPOSE4_PS(o0, o1, o2, o3);
+        originX = o0;
+        originY = o1;
+        originZ = o2;
+        __m128 d0 = rays[0].invDirection.m, d1 = rays[1].invDirection.m, d2 = rays[2].invDirection.m, d3 = rays[3].invDirection.m;
+        _MM_TRANSPOSE4_PS(d0, d1, d2, d3);
+        invDirectionX = d0;
+        invDirectionY = d1;
+        invDirectionZ = d2;
+        tMin = _mm_setr_ps(rays[0].tMin, rays[1].tMin, rays[2].tMin, rays[3].tMin);
+        tMax = _mm_setr_ps(rays[0].tMax, rays[1].tMax, rays[2].tMax, rays[3].tMax);
+    }
+
+    __m128 originX;
+    __m128 originY;
+    __m128 originZ;
+    __m128 invDirectionX;
+    __m128 invDirectionY;
+    __m128 invDirectionZ;
+    __m128 tMin;
+    __m128 tMax;
+};
+
+// 8 rays in SoA registers, for coherent ray packets
+struct RayPacket8 {
+    RayPacket8() = default;
+
+    explicit RayPacket8(const Ray rays[8]) {
+        const RayPacket4 lo{rays};
+        const RayPacket4 hi{rays + 4};
+        originX = _mm256_set_m128(hi.originX, lo.originX);
+        originY = _mm256_set_m128(hi.originY, lo.originY);
+        originZ = _mm256_set_m128(hi.originZ, lo.originZ);
+        invDirectionX = _mm256_set_m128(hi.invDirectionX, lo.invDirectionX);
+        invDirectionY = _mm256_set_m128(hi.invDirectionY, lo.invDirectionY);
+        invDirectionZ = _mm256_set_m128(hi.invDirectionZ, lo.invDirectionZ);
+        tMin = _mm256_set_m128(hi.tMin, lo.tMin);
+        tMax = _mm256_set_m128(hi.tMax, lo.tMax);
+    }
+
+    __m256 originX;
+    __m256 originY;
+    __m256 originZ;
+    __m256 invDirectionX;
+    __m256 invDirectionY;
+    __m256 invDirectionZ;
+    __m256 tMin;
+    __m256 tMax;
+};
+
+// Slab tests
+//
+// min/max take their second operand when either operand is NaN, which happens for 0 * infinity when a ray
+// is parallel to a slab and starts exactly on its plane. The operands are ordered so NaN never reaches the
+// result: such an axis is either ignored or rejects the box, but the entry distance is never NaN.
+//
+// tEntry: distance where the ray enters the box, clamped to tMin, only meaningful for hit lanes
+
+inline bool Intersect(const Ray &ray, const AABB &box, float &tEntry) {
+    const __m128 t1 = _mm_mul_ps(_mm_sub_ps(box.min.m, ray.origin.m), ray.invDirection.m);
+    const __m128 t2 = _mm_mul_ps(_mm_sub_ps(box.max.m, ray.origin.m), ray.invDirection.m);
+    // w is replaced by the ray range
+    __m128 tNear = _mm_blend_ps(_mm_min_ps(t1, t2), _mm_set_ps1(ray.tMin), 0b1000);
+    __m128 tFar = _mm_blend_ps(_mm_max_ps(t1, t2), _mm_set_ps1(ray.tMax), 0b1000);
+    tNear = _mm_max_ps(tNear, _mm_set_ps1(ray.tMin));
+    tFar = _mm_min_ps(tFar, _mm_set_ps1(ray.tMax));
+    tNear = _mm_max_ps(tNear, _mm_shuffle_ps(tNear, tNear, _MM_SHUFFLE(2, 3, 0, 1)));
+    tNear = _mm_max_ps(tNear, _mm_shuffle_ps(tNear, tNear, _MM_SHUFFLE(1, 0, 3, 2)));
+    tFar = _mm_min_ps(tFar, _mm_shuffle_ps(tFar, tFar, _MM_SHUFFLE(2, 3, 0, 1)));
+    tFar = _mm_min_ps(tFar, _mm_shuffle_ps(tFar, tFar, _MM_SHUFFLE(1, 0, 3, 2)));
+    tEntry = _mm_cvtss_f32(tNear);
+    return _mm_comile_ss(tNear, tFar);
+}
+
+// 1 ray against 4 boxes, for 4-wide BVH nodes
+// Returns the hit mask, bit i is set when box i is hit
+inline int Intersect(const Ray &ray, const AABB4 &boxes, __m128 &tEntry) {
+    __m128 tNear = _mm_set_ps1(ray.tMin);
+    __m128 tFar = _mm_set_ps1(ray.tMax);
+    const float *mins[3] = {boxes.minX, boxes.minY, boxes.minZ};
+    const float *maxs[3] = {boxes.maxX, boxes.maxY, boxes.maxZ};
+    for (int axis = 0; axis < 3; axis++) {
+        const __m128 origin = _mm_set_ps1(ray.origin[axis]);
+        const __m128 invDirection = _mm_set_ps1(ray.invDirection[axis]);
+        const __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(mins[axis]), origin), invDirection);
+        const __m128 t2 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(maxs[axis]), origin), invDirection);
+        tNear = _mm_max_ps(_mm_min_ps(t1, t2), tNear);
+        tFar = _mm_min_ps(_mm_max_ps(t1, t2), tFar);
+    }
+    tEntry = tNear;
+    return _mm_movemask_ps(_mm_cmple_ps(tNear, tFar));
+}
+
+// 1 ray against 8 boxes, for 8-wide BVH nodes
+// Returns the hit mask, bit i is set when box i is hit
+inline int Intersect(const Ray &ray, const AABB8 &boxes, __m256 &tEntry) {
+    __m256 tNear = _mm256_set1_ps(ray.tMin);
+    __m256 tFar = _mm256_set1_ps(ray.tMax);
+    const float *mins[3] = {boxes.minX, boxes.minY, boxes.minZ};
+    const float *maxs[3] = {boxes.maxX, boxes.maxY, boxes.maxZ};
+    for (int axis = 0; axis < 3; axis++) {
+        const __m256 origin = _mm256_set1_ps(ray.origin[axis]);
+        const __m256 invDirection = _mm256_set1_ps(ray.invDirection[axis]);
+        const __m256 t1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(mins[axis]), origin), invDirection);
+        const __m256 t2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(maxs[axis]), origin), invDirection);
+        tNear = _mm256_max_ps(_mm256_min_ps(t1, t2), tNear);
+        tFar = _mm256_min_ps(_mm256_max_ps(t1, t2), tFar);
+    }
+    tEntry = tNear;
+    return _mm256_movemask_ps(_mm256_cmp_ps(tNear, tFar, _CMP_LE_OQ));
+}
+
+// 4 rays against 1 box
+// Returns the hit mask, bit i is set when ray i hits
+inline int Intersect(const RayPacket4 &rays, const AABB &box, __m128 &tEntry) {
+    const __m128 origins[3] = {rays.originX, rays.originY, rays.originZ};
+    const __m128 invDirections[3] = {rays.invDirectionX, rays.invDirectionY, rays.invDirectionZ};
+    __m128 tNear = rays.tMin;
+    __m128 tFar = rays.tMax;
+    for (int axis = 0; axis < 3; axis++) {
+        const __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_set_ps1(box.min[axis]), origins[axis]), invDirections[axis]);
+        const __m128 t2 = _mm_mul_ps(_mm_sub_ps(_mm_set_ps1(box.max[axis]), origins[axis]), invDirections[axis]);
+        tNear = _mm_max_ps(_mm_min_ps(t1, t2), tNear);
+        tFar = _mm_min_ps(_mm_max_ps(t1, t2), tFar);
+    }
+    tEntry = tNear;
+    return _mm_movemask_ps(_mm_cmple_ps(tNear, tFar));
+}
+
+// 8 rays against 1 box
+// Returns the hit mask, bit i is set when ray i hits
+inline int Intersect(const RayPacket8 &rays, const AABB &box, __m256 &tEntry) {
+    const __m256 origins[3] = {rays.originX, rays.originY, rays.originZ};
+    const __m256 invDirections[3] = {rays.invDirectionX, rays.invDirectionY, rays.invDirectionZ};
+    __m256 tNear = rays.tMin;
+    __m256 tFar = rays.tMax;
+    for (int axis = 0; axis < 3; axis++) {
+        const __m256 t1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(box.min[axis]), origins[axis]), invDirections[axis]);
+        const __m256 t2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(box.max[axis]), origins[axis]), invDirections[axis]);
+        tNear = _mm256_max_ps(_mm256_min_ps(t1, t2), tNear);
+        tFar = _mm256_min_ps(_mm256_max_ps(t1, t2), tFar);
+    }
+    tEntry = tNear;
+    return _mm256_movemask_ps(_mm256_cmp_ps(tNear, tFar, _CMP_LE_OQ));
+}
@@ -0,0 +1,74 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Non-owning structure-of-arrays views
+// Every pointer of a view addresses the same number of floats
+
+struct Vec3SoA {
+    float *x;
+    float *y;
+    float *z;
+};
+
+struct Vec4SoA {
+    float *x;
+    float *y;
+    float *z;
+    float *w;
+};
+
+// Loads min(count, 4) floats, the remaining lanes are 0
+inline __m128 LoadLanes(const float *p, size_t count) {
+    if (count >= 4) return _mm_loadu_ps(p);
+    alignas(16) float lanes[4]{};
+    for (size_t i = 0; i < count; i++) lanes[i] = p[i];
+    return _mm_load_ps(lanes);
+}
+
+// Stores min(count, 4) floats
+inline void StoreLanes(float *p, __m128 v, size_t count) {
+    if (count >= 4) {
+        _mm_storeu_ps(p, v);
+        return;
+    }
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, v);
+    for (size_t i = 0; i < count; i++) p[i] = lanes[i];
+}
+
+// Index of the lowest set bit of a movemask result, mask must not be 0
+inline int LowestLane(unsigned mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+// Smallest of the 8 lanes
+inline float HorizontalMin(__m256 v) {
+    __m128 m = _mm_min_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    m = _mm_min_ps(m, _mm_movehl_ps(m, m));
+    m = _mm_min_ss(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 1, 1, 1)));
+    return _mm_cvtss_f32(m);
+}
+
+// Largest of the 8 lanes
+inline float HorizontalMax(__m256 v) {
+    __m128 m = _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+    m = _mm_max_ss(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 1, 1, 1)));
+    return _mm_cvtss_f32(m);
+}
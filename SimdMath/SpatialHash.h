@@ -0,0 +1,208 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <immintrin.h>
+#include <utility>
+#include <vector>
+
+#include "Instrumentation.h"
+#include "Parallel.h"
+#include "SoA.h"
+#include "Vec4.h"
+
+// Uniform grid over unbounded space, cells are hashed into a table with one bucket per point (rounded up to a power of 2)
+// Rebuilds are counting sorts into flat arrays: the points of a bucket are contiguous and nothing is allocated per cell
+class SpatialHashGrid {
+public:
+    explicit SpatialHashGrid(float cellSize)
+        : m_cellSize{cellSize}, m_invCellSize{1.0f / cellSize} {}
+
+    // positions: w is ignored
+    void Rebuild(const Vec4 *positions, size_t count) {
+        PROFILE_SCOPE("SpatialHash::Rebuild");
+        uint32_t tableSize = 1;
+        while (tableSize < count) tableSize *= 2;
+        m_tableMask = tableSize - 1;
+        m_bucketStarts.resize(tableSize + 1);
+        m_buckets.resize(count);
+        m_indices.resize(count);
+        // 8 padding lanes so the queries can always load 8
+        for (std::vector<float> *coordinates: {&m_x, &m_y, &m_z}) coordinates->resize(count + 8, 0.0f);
+
+        // One histogram per range, so the scatter keeps the point order within buckets without atomics
+        m_rangeCounts.resize(ThreadCount());
+        const size_t rangeCount = ParallelFor(count, PARALLEL_THRESHOLD, [&](size_t range, size_t begin, size_t end) {
+            std::vector<uint32_t> &counts = m_rangeCounts[range];
+            counts.assign(tableSize, 0);
+            for (size_t i = begin; i < end; i++) {
+                const uint32_t bucket = Bucket(Quantize(positions[i].m));
+                m_buckets[i] = bucket;
+                counts[bucket]++;
+            }
+        });
+
+        uint32_t offset = 0;
+        for (uint32_t bucket = 0; bucket < tableSize; bucket++) {
+            m_bucketStarts[bucket] = offset;
+            for (size_t range = 0; range < rangeCount; range++) {
+                const uint32_t rangeBucketCount = m_rangeCounts[range][bucket];
+                m_rangeCounts[range][bucket] = offset;
+                offset += rangeBucketCount;
+            }
+        }
+        m_bucketStarts[tableSize] = offset;
+
+        ParallelFor(count, PARALLEL_THRESHOLD, [&](size_t range, size_t begin, size_t end) {
+            std::vector<uint32_t> &offsets = m_rangeCounts[range];
+            for (size_t i = begin; i < end; i++) {
+                const uint32_t destination = offsets[m_buckets[i]]++;
+                m_indices[destination] = static_cast<uint32_t>(i);
+                m_x[destination] = positions[i].x;
+                m_y[destination] = positions[i].y;
+                m_z[destination] = positions[i].z;
+            }
+        });
+    }
+
+    // func(index, distanceSquared) runs for every point within radius of center, including a point at center itself
+    template<typename Func>
+    void Query(const Vec4 &center, float radius, Func &&func) const {
+        if (m_indices.empty()) return;
+
+        const __m128i minCell = Quantize(_mm_sub_ps(center.m, _mm_set_ps1(radius)));
+        const __m128i maxCell = Quantize(_mm_add_ps(center.m, _mm_set_ps1(radius)));
+        alignas(16) int32_t minCoordinates[4], maxCoordinates[4];
+        _mm_store_si128(reinterpret_cast<__m128i *>(minCoordinates), minCell);
+        _mm_store_si128(reinterpret_cast<__m128i *>(maxCoordinates), maxCell);
+
+        const __m256 cx = _mm256_set1_ps(center.x);
+        const __m256 cy = _mm256_set1_ps(center.y);
+        const __m256 cz = _mm256_set1_ps(center.z);
+        const __m256 radiusSquared = _mm256_set1_ps(radius * radius);
+        const __m256 invCellSize = _mm256_set1_ps(m_invCellSize);
+        const __m256 minX = _mm256_set1_ps(static_cast<float>(minCoordinates[0]));
+        const __m256 maxX = _mm256_set1_ps(static_cast<float>(maxCoordinates[0]));
+
+        const uint32_t tableSize = m_tableMask + 1;
+        const uint32_t rowLength = static_cast<uint32_t>(maxCoordinates[0] - minCoordinates[0] + 1);
+        for (int32_t z = minCoordinates[2]; z <= maxCoordinates[2]; z++) {
+            for (int32_t y = minCoordinates[1]; y <= maxCoordinates[1]; y++) {
+                // Rows of cells are consecutive buckets, wrapping around the end of the table
+                // Points of other cells sharing these buckets are rejected by their cell, so every point is visited once
+                const __m256 rowY = _mm256_set1_ps(static_cast<float>(y));
+                const __m256 rowZ = _mm256_set1_ps(static_cast<float>(z));
+                const auto visit = [&](uint32_t firstBucket, uint32_t lastBucket) {
+                    const uint32_t begin = m_bucketStarts[firstBucket];
+                    const uint32_t end = m_bucketStarts[lastBucket];
+                    for (uint32_t i = begin; i < end; i += 8) {
+                        const __m256 px = _mm256_loadu_ps(&m_x[i]);
+                        const __m256 py = _mm256_loadu_ps(&m_y[i]);
+                        const __m256 pz = _mm256_loadu_ps(&m_z[i]);
+                        const __m256 dx = _mm256_sub_ps(px, cx);
+                        const __m256 dy = _mm256_sub_ps(py, cy);
+                        const __m256 dz = _mm256_sub_ps(pz, cz);
+                        const __m256 distanceSquared = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+                        __m256 accept = _mm256_cmp_ps(distanceSquared, radiusSquared, _CMP_LE_OQ);
+                        const __m256 cellX = _mm256_floor_ps(_mm256_mul_ps(px, invCellSize));
+                        accept = _mm256_and_ps(accept, _mm256_cmp_ps(cellX, minX, _CMP_GE_OQ));
+                        accept = _mm256_and_ps(accept, _mm256_cmp_ps(cellX, maxX, _CMP_LE_OQ));
+                        accept = _mm256_and_ps(accept, _mm256_cmp_ps(_mm256_floor_ps(_mm256_mul_ps(py, invCellSize)), rowY, _CMP_EQ_OQ));
+                        accept = _mm256_and_ps(accept, _mm256_cmp_ps(_mm256_floor_ps(_mm256_mul_ps(pz, invCellSize)), rowZ, _CMP_EQ_OQ));
+                        unsigned mask = _mm256_movemask_ps(accept);
+                        if (end - i < 8) mask &= (1u << (end - i)) - 1;
+                        if (!mask) continue;
+
+                        alignas(32) float distances[8];
+                        _mm256_store_ps(distances, distanceSquared);
+                        while (mask) {
+                            const int lane = LowestLane(mask);
+                            mask &= mask - 1;
+                            func(m_indices[i + lane], distances[lane]);
+                        }
+                    }
+                };
+
+                if (rowLength >= tableSize) {
+                    visit(0, tableSize);
+                    continue;
+                }
+                const uint32_t firstBucket = Bucket(_mm_setr_epi32(minCoordinates[0], y, z, 0));
+                const uint32_t lastBucket = firstBucket + rowLength;
+                if (lastBucket <= tableSize) {
+                    visit(firstBucket, lastBucket);
+                } else {
+                    visit(firstBucket, tableSize);
+                    visit(0, lastBucket - tableSize);
+                }
+            }
+        }
+    }
+
+    // Neighbors of center i are neighbors[offsets[i]] to neighbors[offsets[i + 1]], in no particular order
+    // Queries run in parallel ranges
+    void Query(const Vec4 *centers, size_t count, float radius, std::vector<uint32_t> &offsets, std::vector<uint32_t> &neighbors) const {
+        offsets.resize(count + 1);
+        std::vector<std::vector<uint32_t>> rangeNeighbors(ThreadCount());
+        std::vector<std::pair<size_t, size_t>> ranges(ThreadCount());
+        // A query visits every cell its radius overlaps, far more work per point than a rebuild, so smaller ranges pay off
+        const size_t rangeCount = ParallelFor(count, PARALLEL_THRESHOLD / 16, [&](size_t range, size_t begin, size_t end) {
+            ranges[range] = {begin, end};
+            std::vector<uint32_t> &found = rangeNeighbors[range];
+            for (size_t i = begin; i < end; i++) {
+                // Relative to the range for now
+                offsets[i] = static_cast<uint32_t>(found.size());
+                Query(centers[i], radius, [&](uint32_t index, float) { found.push_back(index); });
+            }
+        });
+
+        size_t total = 0;
+        for (size_t range = 0; range < rangeCount; range++) total += rangeNeighbors[range].size();
+        neighbors.resize(total);
+
+        uint32_t base = 0;
+        for (size_t range = 0; range < rangeCount; range++) {
+            for (size_t i = ranges[range].first; i < ranges[range].second; i++) offsets[i] += base;
+            std::copy(rangeNeighbors[range].begin(), rangeNeighbors[range].end(), neighbors.begin() + base);
+            base += static_cast<uint32_t>(rangeNeighbors[range].size());
+        }
+        offsets[count] = base;
+    }
+
+    [[nodiscard]] float CellSize() const { return m_cellSize; }
+
+    // Point indices grouped by bucket, bucket b is m_indices[BucketStarts()[b]] to m_indices[BucketStarts()[b + 1]]
+    [[nodiscard]] const std::vector<uint32_t> &Indices() const { return m_indices; }
+
+    [[nodiscard]] const std::vector<uint32_t> &BucketStarts() const { return m_bucketStarts; }
+
+private:
+    // Integer cell coordinates, w is garbage
+    [[nodiscard]] __m128i Quantize(__m128 position) const {
+        return _mm_cvtps_epi32(_mm_floor_ps(_mm_mul_ps(position, _mm_set_ps1(m_invCellSize))));
+    }
+
+    // x is added instead of hashed, so a row of cells along x is a contiguous range of buckets
+    [[nodiscard]] uint32_t Bucket(__m128i cell) const {
+        // Large primes, from "Optimized Spatial Hashing for Collision Detection of Deformable Objects"
+        const __m128i h = _mm_mullo_epi32(cell, _mm_setr_epi32(1, 19349663, 83492791, 0));
+        const uint32_t hash = (_mm_extract_epi32(h, 1) ^ _mm_extract_epi32(h, 2)) + _mm_cvtsi128_si32(h);
+        return hash & m_tableMask;
+    }
+
+    float m_cellSize;
+    float m_invCellSize;
+    uint32_t m_tableMask = 0;
+    std::vector<uint32_t> m_bucketStarts;
+    std::vector<uint32_t> m_buckets;
+    std::vector<uint32_t> m_indices;
+    // Positions in the order of m_indices
+    std::vector<float> m_x;
+    std::vector<float> m_y;
+    std::vector<float> m_z;
+    std::vector<std::vector<uint32_t>> m_rangeCounts;
+};
@@ -0,0 +1,160 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "Ray.h"
+#include "SoA.h"
+
+// 8 triangles in SoA, stored as the first vertex and the two edges from it
+// Unused lanes have zero edges, they never intersect anything
+struct alignas(32) TriangleBlock8 {
+    float v0x[8];
+    float v0y[8];
+    float v0z[8];
+    float e1x[8];
+    float e1y[8];
+    float e1z[8];
+    float e2x[8];
+    float e2y[8];
+    float e2z[8];
+};
+
+// Barycentrics: hit point = (1 - u - v) * v0 + u * v1 + v * v2
+struct TriangleHit {
+    float t = std::numeric_limits<float>::max();
+    float u = 0.0f;
+    float v = 0.0f;
+    uint32_t triangle = UINT32_MAX;
+};
+
+// Möller–Trumbore, with Vec4::Cross and Vec4::Dot
+inline bool Intersect(const Ray &ray, const Vec4 &v0, const Vec4 &v1, const Vec4 &v2, float &t, float &u, float &v) {
+    const Vec4 e1 = v1 - v0;
+    const Vec4 e2 = v2 - v0;
+    const Vec4 p = ray.direction.Cross(e2);
+    const float det = e1.Dot(p);
+    if (std::fabs(det) < 1e-12f) return false;
+    const float invDet = 1.0f / det;
+    const Vec4 s = ray.origin - v0;
+    u = s.Dot(p) * invDet;
+    if (u < 0.0f || u > 1.0f) return false;
+    const Vec4 q = s.Cross(e1);
+    v = ray.direction.Dot(q) * invDet;
+    if (v < 0.0f || u + v > 1.0f) return false;
+    t = e2.Dot(q) * invDet;
+    return t >= ray.tMin && t <= ray.tMax;
+}
+
+// Möller–Trumbore, 1 ray against 8 triangles
+// Returns the hit mask, bit i is set when triangle i is hit within [tMin, tMax]
+inline int Intersect(const Ray &ray, const TriangleBlock8 &triangles, __m256 &t, __m256 &u, __m256 &v) {
+    const __m256 dx = _mm256_set1_ps(ray.direction.x);
+    const __m256 dy = _mm256_set1_ps(ray.direction.y);
+    const __m256 dz = _mm256_set1_ps(ray.direction.z);
+    const __m256 e1x = _mm256_load_ps(triangles.e1x);
+    const __m256 e1y = _mm256_load_ps(triangles.e1y);
+    const __m256 e1z = _mm256_load_ps(triangles.e1z);
+    const __m256 e2x = _mm256_load_ps(triangles.e2x);
+    const __m256 e2y = _mm256_load_ps(triangles.e2y);
+    const __m256 e2z = _mm256_load_ps(triangles.e2z);
+
+    // p = d x e2
+    const __m256 px = _mm256_sub_ps(_mm256_mul_ps(dy, e2z), _mm256_mul_ps(dz, e2y));
+    const __m256 py = _mm256_sub_ps(_mm256_mul_ps(dz, e2x), _mm256_mul_ps(dx, e2z));
+    const __m256 pz = _mm256_sub_ps(_mm256_mul_ps(dx, e2y), _mm256_mul_ps(dy, e2x));
+
+    const __m256 det = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e1x, px), _mm256_mul_ps(e1y, py)), _mm256_mul_ps(e1z, pz));
+    const __m256 invDet = _mm256_div_ps(_mm256_set1_ps(1.0f), det);
+
+    // s = o - v0
+    const __m256 sx = _mm256_sub_ps(_mm256_set1_ps(ray.origin.x), _mm256_load_ps(triangles.v0x));
+    const __m256 sy = _mm256_sub_ps(_mm256_set1_ps(ray.origin.y), _mm256_load_ps(triangles.v0y));
+    const __m256 sz = _mm256_sub_ps(_mm256_set1_ps(ray.origin.z), _mm256_load_ps(triangles.v0z));
+
+    u = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(sx, px), _mm256_mul_ps(sy, py)), _mm256_mul_ps(sz, pz)), invDet);
+
+    // q = s x e1
+    const __m256 qx = _mm256_sub_ps(_mm256_mul_ps(sy, e1z), _mm256_mul_ps(sz, e1y));
+    const __m256 qy = _mm256_sub_ps(_mm256_mul_ps(sz, e1x), _mm256_mul_ps(sx, e1z));
+    const __m256 qz = _mm256_sub_ps(_mm256_mul_ps(sx, e1y), _mm256_mul_ps(sy, e1x));
+
+    v = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, qx), _mm256_mul_ps(dy, qy)), _mm256_mul_ps(dz, qz)), invDet);
+    t = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e2x, qx), _mm256_mul_ps(e2y, qy)), _mm256_mul_ps(e2z, qz)), invDet);
+
+    // Ordered comparisons are false for the NaNs of degenerate lanes
+    const __m256 absDet = _mm256_and_ps(det, _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF)));
+    __m256 hit = _mm256_cmp_ps(absDet, _mm256_set1_ps(1e-12f), _CMP_GE_OQ);
+    hit = _mm256_and_ps(hit, _mm256_cmp_ps(u, _mm256_setzero_ps(), _CMP_GE_OQ));
+    hit = _mm256_and_ps(hit, _mm256_cmp_ps(v, _mm256_setzero_ps(), _CMP_GE_OQ));
+    hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_add_ps(u, v), _mm256_set1_ps(1.0f), _CMP_LE_OQ));
+    hit = _mm256_and_ps(hit, _mm256_cmp_ps(t, _mm256_set1_ps(ray.tMin), _CMP_GE_OQ));
+    hit = _mm256_and_ps(hit, _mm256_cmp_ps(t, _mm256_set1_ps(ray.tMax), _CMP_LE_OQ));
+    return _mm256_movemask_ps(hit);
+}
+
+// Closest hit among triangles [first, first + count), triangle i is lane i % 8 of block i / 8
+// Matches the leaf ranges of Bvh when the blocks are built in Bvh::Indices() order
+// Returns true after updating hit when a triangle is hit closer than both hit.t and ray.tMax
+inline bool IntersectTriangles(const Ray &ray, const TriangleBlock8 *blocks, uint32_t first, uint32_t count, TriangleHit &hit) {
+    bool found = false;
+    const uint32_t end = first + count;
+    for (uint32_t block = first / 8; block * 8 < end; block++) {
+        __m256 t, u, v;
+        unsigned mask = Intersect(ray, blocks[block], t, u, v);
+
+        // Lanes outside of the range
+        const uint32_t blockFirst = block * 8;
+        if (first > blockFirst) mask &= ~0u << (first - blockFirst);
+        if (end < blockFirst + 8) mask &= (1u << (end - blockFirst)) - 1;
+        if (!mask) continue;
+
+        alignas(32) float ts[8], us[8], vs[8];
+        _mm256_store_ps(ts, t);
+        _mm256_store_ps(us, u);
+        _mm256_store_ps(vs, v);
+        while (mask) {
+            const int lane = LowestLane(mask);
+            mask &= mask - 1;
+            if (ts[lane] < hit.t) {
+                hit = {ts[lane], us[lane], vs[lane], blockFirst + lane};
+                found = true;
+            }
+        }
+    }
+    return found;
+}
+
+// positions: 3 vertices per triangle, vertex i at byte offset i * stride, so Vertex arrays can be used directly
+// order: triangle of every lane, nullptr for 0, 1, 2...
+inline std::vector<TriangleBlock8> BuildTriangleBlocks(const Vec4 *positions, size_t stride, size_t triangleCount, const uint32_t *order = nullptr) {
+    const auto *bytes = reinterpret_cast<const char *>(positions);
+    const auto vertex = [&](size_t triangle, size_t corner) -> const Vec4 & {
+        return *reinterpret_cast<const Vec4 *>(bytes + (triangle * 3 + corner) * stride);
+    };
+
+    std::vector<TriangleBlock8> blocks((triangleCount + 7) / 8, TriangleBlock8{});
+    for (size_t i = 0; i < triangleCount; i++) {
+        const size_t triangle = order ? order[i] : i;
+        const Vec4 &v0 = vertex(triangle, 0);
+        const Vec4 e1 = vertex(triangle, 1) - v0;
+        const Vec4 e2 = vertex(triangle, 2) - v0;
+        TriangleBlock8 &block = blocks[i / 8];
+        const size_t lane = i % 8;
+        block.v0x[lane] = v0.x;
+        block.v0y[lane] = v0.y;
+        block.v0z[lane] = v0.z;
+        block.e1x[lane] = e1.x;
+        block.e1y[lane] = e1.y;
+        block.e1z[lane] = e1.z;
+        block.e2x[lane] = e2.x;
+        block.e2y[lane] = e2.y;
+        block.e2z[lane] = e2.z;
+    }
+    return blocks;
+}
@@ -0,0 +1,78 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#pragma once
+
+#include <smmintrin.h>
+#include <xmmintrin.h>
+
+// 4-wide trigonometric functions for structure-of-arrays kernels
+// Polynomials are the single precision minimax approximations from Cephes
+
+// Maximum absolute error: about 1.2e-7 for |x| < 8192
+inline void SinCos(__m128 x, __m128 &s, __m128 &c) {
+    // Round to the nearest multiple of pi/2, then subtract it in three steps (Cody-Waite)
+    const __m128i quadrant = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set_ps1(0.636619772367581343f)));
+    const __m128 q = _mm_cvtepi32_ps(quadrant);
+    __m128 r = _mm_sub_ps(x, _mm_mul_ps(q, _mm_set_ps1(1.5703125f)));
+    r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set_ps1(4.837512969970703125e-4f)));
+    r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set_ps1(7.54978995489188216e-8f)));
+
+    // r is in [-pi/4, pi/4]
+    const __m128 r2 = _mm_mul_ps(r, r);
+
+    __m128 sr = _mm_add_ps(_mm_mul_ps(_mm_set_ps1(-1.9515295891e-4f), r2), _mm_set_ps1(8.3321608736e-3f));
+    sr = _mm_add_ps(_mm_mul_ps(sr, r2), _mm_set_ps1(-1.6666654611e-1f));
+    sr = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sr, r2), r), r);
+
+    __m128 cr = _mm_add_ps(_mm_mul_ps(_mm_set_ps1(2.443315711809948e-5f), r2), _mm_set_ps1(-1.388731625493765e-3f));
+    cr = _mm_add_ps(_mm_mul_ps(cr, r2), _mm_set_ps1(4.166664568298827e-2f));
+    cr = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(cr, r2), r2), _mm_sub_ps(_mm_set_ps1(1.0f), _mm_mul_ps(r2, _mm_set_ps1(0.5f))));
+
+    // Quadrant 1 and 3 swap sin and cos, quadrant 2 and 3 negate sin, quadrant 1 and 2 negate cos
+    const __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+    const __m128 sinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(2)), 30));
+    const __m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(2)), 30));
+    s = _mm_xor_ps(_mm_blendv_ps(sr, cr, swap), sinSign);
+    c = _mm_xor_ps(_mm_blendv_ps(cr, sr, swap), cosSign);
+}
+
+// Maximum absolute error: about 2.4e-7
+// Signed zeros are handled like std::atan2, both zero gives +-0 for x = +0 and +-pi for x = -0
+inline __m128 Atan2(__m128 y, __m128 x) {
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x80000000)));
+    const __m128 absY = _mm_and_ps(y, absMask);
+    const __m128 absX = _mm_and_ps(x, absMask);
+
+    // Reduce to atan(a) with a in [0, 1]
+    const __m128 minimum = _mm_min_ps(absY, absX);
+    const __m128 maximum = _mm_max_ps(absY, absX);
+    const __m128 zero = _mm_cmpeq_ps(maximum, _mm_setzero_ps());
+    __m128 a = _mm_div_ps(minimum, _mm_blendv_ps(maximum, _mm_set_ps1(1.0f), zero));
+
+    // Reduce further to [0, tan(pi/8)] with atan(a) = pi/4 + atan((a - 1) / (a + 1))
+    const __m128 large = _mm_cmpgt_ps(a, _mm_set_ps1(0.414213562373095f));
+    const __m128 one = _mm_set_ps1(1.0f);
+    a = _mm_blendv_ps(a, _mm_div_ps(_mm_sub_ps(a, one), _mm_add_ps(a, one)), large);
+
+    const __m128 z = _mm_mul_ps(a, a);
+    __m128 p = _mm_add_ps(_mm_mul_ps(_mm_set_ps1(8.05374449538e-2f), z), _mm_set_ps1(-1.38776856032e-1f));
+    p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set_ps1(1.99777106478e-1f));
+    p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set_ps1(-3.33329491539e-1f));
+    __m128 r = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(p, z), a), a);
+    r = _mm_add_ps(r, _mm_and_ps(large, _mm_set_ps1(0.785398163397448f)));
+
+    // Undo the octant reduction
+    r = _mm_blendv_ps(r, _mm_sub_ps(_mm_set_ps1(1.57079632679490f), r), _mm_cmpgt_ps(absY, absX));
+    r = _mm_blendv_ps(r, _mm_sub_ps(_mm_set_ps1(3.14159265358979f), r), x);
+    return _mm_or_ps(r, _mm_and_ps(y, signMask));
+}
+
+// Inputs are clamped to [-1, 1]
+inline __m128 Asin(__m128 x) {
+    const __m128 one = _mm_set_ps1(1.0f);
+    x = _mm_max_ps(_mm_min_ps(x, one), _mm_set_ps1(-1.0f));
+    return Atan2(x, _mm_sqrt_ps(_mm_sub_ps(one, _mm_mul_ps(x, x))));
+}
@@ -0,0 +1,88 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <immintrin.h>
+#include <type_traits>
+
+#include "AABB.h"
+#include "Vec4.h"
+
+// Compact vertex attributes, one vertex per SSE register
+// Like MeshReduction, vertex i is at byte offset i * stride on both sides, so interleaved vertex arrays can be used directly
+namespace VertexPacking {
+    // Positions are quantized relative to a box, dequantized = unorm * scale + offset
+    struct Quantization {
+        static Quantization FromBounds(const AABB &bounds) {
+            // A flat axis still needs a non-zero scale
+            const __m128 extent = _mm_sub_ps(bounds.max.m, bounds.min.m);
+            const __m128 flat = _mm_cmple_ps(extent, _mm_setzero_ps());
+            return {Vec4{_mm_blend_ps(bounds.min.m, _mm_setzero_ps(), 0b1000)},
+                    Vec4{_mm_blend_ps(_mm_blendv_ps(extent, _mm_set_ps1(1.0f), flat), _mm_setzero_ps(), 0b1000)}};
+        }
+
+        Vec4 offset;
+        Vec4 scale;
+    };
+
+    template<typename T>
+    inline T *At(T *base, size_t stride, size_t i) {
+        using Byte = std::conditional_t<std::is_const_v<T>, const uint8_t, uint8_t>;
+        return reinterpret_cast<T *>(reinterpret_cast<Byte *>(base) + i * stride);
+    }
+
+    // xyz to 16-bit unsigned normalized, for GL_UNSIGNED_SHORT attributes with normalized set, w is 0
+    inline void PackPositions(const Vec4 *positions, size_t stride, size_t count, const Quantization &quantization,
+                              uint16_t *out, size_t outStride) {
+        const __m128 scale = _mm_blend_ps(_mm_div_ps(_mm_set_ps1(65535.0f), quantization.scale.m), _mm_setzero_ps(), 0b1000);
+        const __m128 offset = quantization.offset.m;
+        const __m128 max = _mm_set_ps1(65535.0f);
+        for (size_t i = 0; i < count; i++) {
+            const __m128 p = _mm_mul_ps(_mm_sub_ps(At(positions, stride, i)->m, offset), scale);
+            const __m128i q = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(p, _mm_setzero_ps()), max));
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(At(out, outStride, i)), _mm_packus_epi32(q, q));
+        }
+    }
+
+    // w of the positions is 1
+    inline void UnpackPositions(const uint16_t *packed, size_t packedStride, size_t count, const Quantization &quantization,
+                                Vec4 *out, size_t stride) {
+        const __m128 scale = _mm_mul_ps(quantization.scale.m, _mm_set_ps1(1.0f / 65535.0f));
+        const __m128 offset = _mm_blend_ps(quantization.offset.m, _mm_set_ps1(1.0f), 0b1000);
+        for (size_t i = 0; i < count; i++) {
+            const __m128i q = _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(At(packed, packedStride, i))));
+            At(out, stride, i)->m = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(q), scale), offset);
+        }
+    }
+
+    // xyz to GL_INT_2_10_10_10_REV signed normalized, x in the lowest bits, w is 0
+    inline void PackNormals(const Vec4 *normals, size_t stride, size_t count, uint32_t *out, size_t outStride) {
+        const __m128 one = _mm_set_ps1(1.0f);
+        const __m128 minusOne = _mm_set_ps1(-1.0f);
+        const __m128 scale = _mm_setr_ps(511.0f, 511.0f, 511.0f, 0.0f);
+        const __m128i mask = _mm_set1_epi32(1023);
+        const __m128i shifts = _mm_setr_epi32(0, 10, 20, 0);
+        for (size_t i = 0; i < count; i++) {
+            const __m128 n = _mm_mul_ps(_mm_min_ps(_mm_max_ps(At(normals, stride, i)->m, minusOne), one), scale);
+            __m128i c = _mm_sllv_epi32(_mm_and_si128(_mm_cvtps_epi32(n), mask), shifts);
+            c = _mm_or_si128(c, _mm_shuffle_epi32(c, _MM_SHUFFLE(1, 0, 3, 2)));
+            c = _mm_or_si128(c, _mm_shuffle_epi32(c, _MM_SHUFFLE(2, 3, 0, 1)));
+            *At(out, outStride, i) = static_cast<uint32_t>(_mm_cvtsi128_si32(c));
+        }
+    }
+
+    // Same conversion as GL, max(c / 511, -1), w of the normals is 0
+    inline void UnpackNormals(const uint32_t *packed, size_t packedStride, size_t count, Vec4 *out, size_t stride) {
+        // Each field to the top bits, the arithmetic shift back sign extends it
+        const __m128i shifts = _mm_setr_epi32(22, 12, 2, 0);
+        const __m128 scale = _mm_setr_ps(1.0f / 511.0f, 1.0f / 511.0f, 1.0f / 511.0f, 0.0f);
+        const __m128 minusOne = _mm_set_ps1(-1.0f);
+        for (size_t i = 0; i < count; i++) {
+            const __m128i c = _mm_srai_epi32(_mm_sllv_epi32(_mm_set1_epi32(static_cast<int>(*At(packed, packedStride, i))), shifts), 22);
+            At(out, stride, i)->m = _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(c), scale), _mm_blend_ps(minusOne, _mm_setzero_ps(), 0b1000));
+        }
+    }
+}
@@ -0,0 +1,292 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "TestUtils.h"
+#include "Trig.h"
+
+// Error of the approximate kernels against a double reference, next to their speed
+// Ranges cover the inputs games actually see and the ones that break kernels: denormals, near zero, huge
+
+struct AccuracyStats {
+    double maxUlp = 0.0;
+    double sumUlp = 0.0;
+    double maxRelative = 0.0;
+    double maxAbsolute = 0.0;
+    size_t count = 0;
+    // Results that aren't finite while the reference is, kept out of the other numbers
+    size_t nonFinite = 0;
+
+    void Add(float value, double reference) {
+        if (!std::isfinite(value)) {
+            nonFinite++;
+            return;
+        }
+        const double ulp = UlpError(value, reference);
+        const double absolute = std::abs(static_cast<double>(value) - reference);
+        maxUlp = std::max(maxUlp, ulp);
+        sumUlp += ulp;
+        maxAbsolute = std::max(maxAbsolute, absolute);
+        if (reference != 0.0) maxRelative = std::max(maxRelative, absolute / std::abs(reference));
+        count++;
+    }
+
+    [[nodiscard]] double MeanUlp() const { return count ? sumUlp / static_cast<double>(count) : 0.0; }
+};
+
+struct AccuracyRow {
+    const char *function;
+    const char *kernel;
+    const char *range;
+    AccuracyStats stats;
+    double nsPerValue;
+};
+
+// Inputs of one range, a and b are the two arguments, b is unused by unary kernels
+struct AccuracyInputs {
+    const char *range;
+    std::vector<Vec4> a;
+    std::vector<Vec4> b;
+};
+
+static constexpr size_t ACCURACY_INPUT_COUNT = 16 * 1024;
+
+// Log-uniform magnitude in [low, high] with a random sign
+static float LogUniform(std::mt19937 &rng, double low, double high) {
+    std::uniform_real_distribution<double> exponent{std::log(low), std::log(high)};
+    const double magnitude = std::exp(exponent(rng));
+    return static_cast<float>(rng() & 1 ? magnitude : -magnitude);
+}
+
+// Directions with w = 0 and a length in [low, high]
+static AccuracyInputs VectorInputs(const char *range, double low, double high, std::mt19937 &rng) {
+    AccuracyInputs inputs{range, {}, {}};
+    std::normal_distribution<float> direction;
+    for (size_t i = 0; i < ACCURACY_INPUT_COUNT; i++) {
+        Vec4 v{direction(rng), direction(rng), direction(rng), 0.0f};
+        const float length = std::abs(LogUniform(rng, low, high));
+        const double scale = length / std::sqrt(static_cast<double>(v.x) * v.x + static_cast<double>(v.y) * v.y + static_cast<double>(v.z) * v.z);
+        v = Vec4{static_cast<float>(v.x * scale), static_cast<float>(v.y * scale), static_cast<float>(v.z * scale), 0.0f};
+        inputs.a.push_back(v);
+    }
+    return inputs;
+}
+
+// Every lane uniform in [low, high], or log-uniform magnitudes when logarithmic
+static AccuracyInputs ScalarInputs(const char *range, double low, double high, bool logarithmic, std::mt19937 &rng) {
+    AccuracyInputs inputs{range, {}, {}};
+    std::uniform_real_distribution<double> uniform{low, high};
+    const auto next = [&] { return logarithmic ? LogUniform(rng, low, high) : static_cast<float>(uniform(rng)); };
+    for (size_t i = 0; i < ACCURACY_INPUT_COUNT; i++) {
+        const float x = next(), y = next(), z = next(), w = next();
+        inputs.a.emplace_back(x, y, z, w);
+    }
+    return inputs;
+}
+
+// Points on every angle with a distance from the origin in [low, high], a is y and b is x
+static AccuracyInputs PolarInputs(const char *range, double low, double high, std::mt19937 &rng) {
+    AccuracyInputs inputs{range, {}, {}};
+    std::uniform_real_distribution<double> angle{-M_PI, M_PI};
+    float y[4], x[4];
+    for (size_t i = 0; i < ACCURACY_INPUT_COUNT; i++) {
+        for (int lane = 0; lane < 4; lane++) {
+            const double theta = angle(rng);
+            const double radius = std::abs(LogUniform(rng, low, high));
+            y[lane] = static_cast<float>(radius * std::sin(theta));
+            x[lane] = static_cast<float>(radius * std::cos(theta));
+        }
+        inputs.a.emplace_back(y[0], y[1], y[2], y[3]);
+        inputs.b.emplace_back(x[0], x[1], x[2], x[3]);
+    }
+    return inputs;
+}
+
+template<typename Func>
+static double SecondsPerRun(Func &&func) {
+    using Clock = std::chrono::steady_clock;
+    func();
+    const Clock::time_point start = Clock::now();
+    size_t runs = 0;
+    while (runs < 2 || Clock::now() - start < std::chrono::milliseconds(20)) {
+        func();
+        runs++;
+    }
+    return std::chrono::duration<double>(Clock::now() - start).count() / static_cast<double>(runs);
+}
+
+// Runs kernel(a, b) over every input, checks the first lanes of each result against reference(a, b, lane)
+// Reference arguments are the float inputs, so only the error of the kernel is measured
+template<typename Kernel, typename Reference>
+static AccuracyRow Characterize(const char *function, const char *kernel, const AccuracyInputs &inputs, int lanes, Kernel &&func, Reference &&reference) {
+    const std::vector<Vec4> &b = inputs.b.empty() ? inputs.a : inputs.b;
+    std::vector<Vec4> results(inputs.a.size());
+    const double seconds = SecondsPerRun([&] {
+        for (size_t i = 0; i < inputs.a.size(); i++) results[i] = func(inputs.a[i], b[i]);
+    });
+
+    AccuracyRow row{function, kernel, inputs.range, {}, seconds / static_cast<double>(inputs.a.size() * lanes) * 1e9};
+    for (size_t i = 0; i < inputs.a.size(); i++) {
+        for (int lane = 0; lane < lanes; lane++) {
+            row.stats.Add(results[i][lane], reference(inputs.a[i], b[i], lane));
+        }
+    }
+    return row;
+}
+
+static double ReferenceNormalize(const Vec4 &v, int lane) {
+    const double x = v.x, y = v.y, z = v.z;
+    return v[lane] / std::sqrt(x * x + y * y + z * z);
+}
+
+static double ReferenceLength(const Vec4 &v) {
+    const double x = v.x, y = v.y, z = v.z;
+    return std::sqrt(x * x + y * y + z * z);
+}
+
+// Applies a float function to every lane, the scalar baseline of the SIMD kernels
+template<typename Func>
+static Vec4 PerLane(const Vec4 &a, const Vec4 &b, Func &&func) {
+    return Vec4{func(a.x, b.x), func(a.y, b.y), func(a.z, b.z), func(a.w, b.w)};
+}
+
+// A row is on the Pareto front when no other kernel of the same function and range is both as fast and as accurate
+static bool ParetoOptimal(const AccuracyRow &row, const std::vector<AccuracyRow> &rows) {
+    const auto worse = [](const AccuracyRow &a, const AccuracyRow &b) {
+        if (a.stats.nonFinite != b.stats.nonFinite) return a.stats.nonFinite > b.stats.nonFinite;
+        return a.stats.maxUlp > b.stats.maxUlp;
+    };
+    for (const AccuracyRow &other: rows) {
+        if (&other == &row || strcmp(other.function, row.function) != 0 || strcmp(other.range, row.range) != 0) continue;
+        const bool asAccurate = !worse(other, row);
+        const bool asFast = other.nsPerValue <= row.nsPerValue;
+        const bool better = worse(row, other) || other.nsPerValue < row.nsPerValue;
+        if (asAccurate && asFast && better) return false;
+    }
+    return true;
+}
+
+static void PrintAccuracyTable(const std::vector<AccuracyRow> &rows) {
+    printf("%-9s %-14s %-22s %12s %10s %10s %10s %9s %9s  %s\n",
+           "Function", "Kernel", "Inputs", "Max ULP", "Mean ULP", "Max rel", "Max abs", "NonFinite", "ns/value", "Pareto");
+    for (const AccuracyRow &row: rows) {
+        printf("%-9s %-14s %-22s %12.4g %10.3g %10.3g %10.3g %9zu %9.3f  %s\n",
+               row.function, row.kernel, row.range, row.stats.maxUlp, row.stats.MeanUlp(), row.stats.maxRelative, row.stats.maxAbsolute,
+               row.stats.nonFinite, row.nsPerValue, ParetoOptimal(row, rows) ? "*" : "");
+    }
+}
+
+static const AccuracyStats &FindStats(const std::vector<AccuracyRow> &rows, const char *function, const char *kernel, const char *range) {
+    for (const AccuracyRow &row: rows) {
+        if (strcmp(row.function, function) == 0 && strcmp(row.kernel, kernel) == 0 && strcmp(row.range, range) == 0) return row.stats;
+    }
+    FAIL("No accuracy row " << function << " " << kernel << " " << range);
+    return rows.front().stats;
+}
+
+// Run with: Benchmarks [accuracy]
+// Checks hold the documented bounds on the ranges they are documented for, the rest of the table is informational
+TEST_CASE("Accuracy Characterization", "[accuracy]") {
+    std::mt19937 rng{41};
+    std::vector<AccuracyRow> rows;
+
+    const std::vector<AccuracyInputs> vectorInputs = {
+            VectorInputs("length [1e-40, 1e-38]", 1e-40, 1e-38, rng),
+            VectorInputs("length [1e-30, 1e-20]", 1e-30, 1e-20, rng),
+            VectorInputs("length [1e-8, 1e-3]", 1e-8, 1e-3, rng),
+            VectorInputs("length [0.1, 10]", 0.1, 10.0, rng),
+            VectorInputs("length [1e3, 1e10]", 1e3, 1e10, rng),
+            VectorInputs("length [1e18, 1e38]", 1e18, 1e38, rng),
+    };
+    for (const AccuracyInputs &inputs: vectorInputs) {
+        const auto normalize = [](const Vec4 &a, const Vec4 &, int lane) { return ReferenceNormalize(a, lane); };
+        rows.push_back(Characterize("normalize", "Normalize", inputs, 3, [](const Vec4 &a, const Vec4 &) { return a.Normalize(); }, normalize));
+        rows.push_back(Characterize("normalize", "FastNormalize", inputs, 3, [](const Vec4 &a, const Vec4 &) { return a.FastNormalize(); }, normalize));
+        rows.push_back(Characterize("normalize", "scalar", inputs, 3, [](const Vec4 &a, const Vec4 &) {
+            const float length = std::sqrt(a.x * a.x + a.y * a.y + a.z * a.z);
+            return Vec4{a.x / length, a.y / length, a.z / length, 0.0f};
+        }, normalize));
+        rows.push_back(Characterize("length", "Length", inputs, 1, [](const Vec4 &a, const Vec4 &) { return Vec4{a.Length()}; },
+                                    [](const Vec4 &a, const Vec4 &, int) { return ReferenceLength(a); }));
+    }
+
+    const std::vector<AccuracyInputs> angleInputs = {
+            ScalarInputs("[-1e-38, 1e-38] denorm", 1e-45, 1e-38, true, rng),
+            ScalarInputs("[-1e-3, 1e-3] log", 1e-20, 1e-3, true, rng),
+            ScalarInputs("[-pi, pi]", -M_PI, M_PI, false, rng),
+            ScalarInputs("[-100, 100]", -100.0, 100.0, false, rng),
+            ScalarInputs("[-8192, 8192]", -8192.0, 8192.0, false, rng),
+            ScalarInputs("[8192, 1e6] log", 8192.0, 1e6, true, rng),
+    };
+    for (const AccuracyInputs &inputs: angleInputs) {
+        const auto sinCos = [](const Vec4 &a, bool sine) {
+            __m128 s, c;
+            SinCos(a.m, s, c);
+            return Vec4{sine ? s : c};
+        };
+        const auto sin = [](const Vec4 &a, const Vec4 &, int lane) { return std::sin(static_cast<double>(a[lane])); };
+        const auto cos = [](const Vec4 &a, const Vec4 &, int lane) { return std::cos(static_cast<double>(a[lane])); };
+        rows.push_back(Characterize("sin", "SinCos", inputs, 4, [&](const Vec4 &a, const Vec4 &) { return sinCos(a, true); }, sin));
+        rows.push_back(Characterize("sin", "std::sin", inputs, 4, [](const Vec4 &a, const Vec4 &b) {
+            return PerLane(a, b, [](float x, float) { return std::sin(x); });
+        }, sin));
+        rows.push_back(Characterize("cos", "SinCos", inputs, 4, [&](const Vec4 &a, const Vec4 &) { return sinCos(a, false); }, cos));
+        rows.push_back(Characterize("cos", "std::cos", inputs, 4, [](const Vec4 &a, const Vec4 &b) {
+            return PerLane(a, b, [](float x, float) { return std::cos(x); });
+        }, cos));
+    }
+
+    const std::vector<AccuracyInputs> atan2Inputs = {
+            PolarInputs("radius [1e-40, 1e-38]", 1e-40, 1e-38, rng),
+            PolarInputs("radius [1e-8, 1e-3]", 1e-8, 1e-3, rng),
+            PolarInputs("radius [0.1, 10]", 0.1, 10.0, rng),
+            PolarInputs("radius [1e18, 1e38]", 1e18, 1e38, rng),
+    };
+    for (const AccuracyInputs &inputs: atan2Inputs) {
+        const auto atan2 = [](const Vec4 &a, const Vec4 &b, int lane) { return std::atan2(static_cast<double>(a[lane]), static_cast<double>(b[lane])); };
+        rows.push_back(Characterize("atan2", "Atan2", inputs, 4, [](const Vec4 &a, const Vec4 &b) { return Vec4{Atan2(a.m, b.m)}; }, atan2));
+        rows.push_back(Characterize("atan2", "std::atan2", inputs, 4, [](const Vec4 &a, const Vec4 &b) {
+            return PerLane(a, b, [](float y, float x) { return std::atan2(y, x); });
+        }, atan2));
+    }
+
+    const std::vector<AccuracyInputs> asinInputs = {
+            ScalarInputs("[-1, 1]", -1.0, 1.0, false, rng),
+            ScalarInputs("[0.999, 1]", 0.999, 1.0, false, rng),
+            ScalarInputs("[-1e-3, 1e-3] log", 1e-20, 1e-3, true, rng),
+    };
+    for (const AccuracyInputs &inputs: asinInputs) {
+        const auto asin = [](const Vec4 &a, const Vec4 &, int lane) { return std::asin(static_cast<double>(a[lane])); };
+        rows.push_back(Characterize("asin", "Asin", inputs, 4, [](const Vec4 &a, const Vec4 &) { return Vec4{Asin(a.m)}; }, asin));
+        rows.push_back(Characterize("asin", "std::asin", inputs, 4, [](const Vec4 &a, const Vec4 &b) {
+            return PerLane(a, b, [](float x, float) { return std::asin(x); });
+        }, asin));
+    }
+
+    PrintAccuracyTable(rows);
+
+    // Documented bounds
+    const AccuracyStats &fastNormalize = FindStats(rows, "normalize", "FastNormalize", "length [0.1, 10]");
+    CHECK(fastNormalize.maxRelative <= 1.5 / 4096.0);
+    CHECK(fastNormalize.nonFinite == 0);
+    // Rounding of the dot product, the square root and the division
+    CHECK(FindStats(rows, "normalize", "Normalize", "length [0.1, 10]").maxUlp <= 3.0);
+    for (const char *range: {"[-pi, pi]", "[-100, 100]", "[-8192, 8192]"}) {
+        for (const char *function: {"sin", "cos"}) {
+            const AccuracyStats &sinCos = FindStats(rows, function, "SinCos", range);
+            CHECK(sinCos.maxAbsolute <= 1.2e-7 * 1.5);
+            CHECK(sinCos.nonFinite == 0);
+        }
+    }
+    CHECK(FindStats(rows, "atan2", "Atan2", "radius [0.1, 10]").maxAbsolute <= 2.4e-7 * 1.5);
+    CHECK(FindStats(rows, "asin", "Asin", "[-1, 1]").nonFinite == 0);
+}
@@ -0,0 +1,81 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_session.hpp>
+#include <catch2/reporters/catch_reporter_event_listener.hpp>
+#include <catch2/reporters/catch_reporter_registrars.hpp>
+#include <cstdio>
+
+#include "BenchmarkReport.h"
+#include "PerfCounters.h"
+
+// Collects the samples of every BENCHMARK next to the usual console output
+class BenchmarkListener final : public Catch::EventListenerBase {
+public:
+    using Catch::EventListenerBase::EventListenerBase;
+
+    void testCaseStarting(const Catch::TestCaseInfo &testInfo) override {
+        m_testCase = testInfo.name;
+    }
+
+    void benchmarkEnded(const Catch::BenchmarkStats<> &stats) override {
+        std::vector<double> samples;
+        samples.reserve(stats.samples.size());
+        for (const auto &sample: stats.samples) samples.push_back(sample.count());
+        if (!samples.empty()) BenchmarkResults().push_back(SummarizeSamples(m_testCase, stats.info.name, std::move(samples)));
+    }
+
+private:
+    std::string m_testCase;
+};
+
+CATCH_REGISTER_LISTENER(BenchmarkListener)
+
+// Catch2's command line plus:
+// --json <path>, --csv <path>: write the results with the machine and build metadata
+// --baseline <path>: compare to a file written by --csv, exits with 1 when a benchmark regressed
+// --regression-threshold <percent>: slowdown of the median that counts as a regression, 10 by default
+// --perf-counters: hardware counters per element after every benchmark with an element count, Linux only
+int main(int argc, char *argv[]) {
+    Catch::Session session;
+
+    std::string jsonPath, csvPath, baselinePath;
+    double threshold = 10.0;
+    bool perfCounters = false;
+    using Catch::Clara::Opt;
+    session.cli(session.cli()
+                | Opt(jsonPath, "path")["--json"]("write benchmark results as JSON")
+                | Opt(csvPath, "path")["--csv"]("write benchmark results as CSV")
+                | Opt(baselinePath, "path")["--baseline"]("compare benchmark medians to a CSV baseline")
+                | Opt(threshold, "percent")["--regression-threshold"]("slowdown that fails the baseline comparison")
+                | Opt(perfCounters)["--perf-counters"]("print hardware performance counters per element"));
+
+    if (const int result = session.applyCommandLine(argc, argv)) return result;
+
+    // Read before running, a missing baseline shouldn't cost a full run
+    std::vector<BenchmarkResult> baseline;
+    if (!baselinePath.empty() && !ReadCsv(baselinePath, baseline)) {
+        fprintf(stderr, "Failed to read baseline %s\n", baselinePath.c_str());
+        return 1;
+    }
+
+    if (perfCounters) EnablePerfCounters();
+
+    const int result = session.run();
+
+    const BenchmarkMetadata metadata = CollectMetadata();
+    if (!jsonPath.empty() && !WriteJson(jsonPath, metadata, BenchmarkResults())) {
+        fprintf(stderr, "Failed to write %s\n", jsonPath.c_str());
+        return 1;
+    }
+    if (!csvPath.empty() && !WriteCsv(csvPath, metadata, BenchmarkResults())) {
+        fprintf(stderr, "Failed to write %s\n", csvPath.c_str());
+        return 1;
+    }
+
+    if (result) return result;
+    if (!baselinePath.empty() && CompareToBaseline(BenchmarkResults(), baseline, threshold) > 0) return 1;
+    return 0;
+}
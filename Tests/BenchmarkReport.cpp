@@ -0,0 +1,290 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#include "BenchmarkReport.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+// Build settings from CMake, see Tests/CMakeLists.txt
+#ifndef BENCHMARK_BUILD_TYPE
+#define BENCHMARK_BUILD_TYPE "unknown"
+#endif
+
+#ifndef BENCHMARK_CXX_FLAGS
+#define BENCHMARK_CXX_FLAGS ""
+#endif
+
+BenchmarkResult SummarizeSamples(std::string testCase, std::string name, std::vector<double> samples) {
+    std::sort(samples.begin(), samples.end());
+    const size_t count = samples.size();
+
+    double sum = 0.0;
+    for (const double sample: samples) sum += sample;
+    const double mean = sum / static_cast<double>(count);
+    double squares = 0.0;
+    for (const double sample: samples) squares += (sample - mean) * (sample - mean);
+    const double standardDeviation = count > 1 ? std::sqrt(squares / static_cast<double>(count - 1)) : 0.0;
+
+    const double median = count % 2 ? samples[count / 2] : (samples[count / 2 - 1] + samples[count / 2]) * 0.5;
+    // Nearest rank
+    const auto p99Rank = static_cast<size_t>(std::ceil(0.99 * static_cast<double>(count)));
+    const double p99 = samples[std::max<size_t>(p99Rank, 1) - 1];
+
+    return {std::move(testCase), std::move(name), mean, median, standardDeviation, p99, samples.front()};
+}
+
+static void Cpuid(unsigned leaf, unsigned subleaf, unsigned registers[4]) {
+#ifdef _MSC_VER
+    int r[4];
+    __cpuidex(r, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; i++) registers[i] = static_cast<unsigned>(r[i]);
+#else
+    __cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+#endif
+}
+
+static std::string CpuBrand() {
+    unsigned registers[4];
+    Cpuid(0x80000000, 0, registers);
+    if (registers[0] < 0x80000004) return "unknown";
+
+    char brand[49]{};
+    for (unsigned leaf = 0; leaf < 3; leaf++) {
+        Cpuid(0x80000002 + leaf, 0, registers);
+        std::copy_n(reinterpret_cast<const char *>(registers), 16, brand + leaf * 16);
+    }
+    std::string result = brand;
+    result.erase(0, result.find_first_not_of(' '));
+    return result;
+}
+
+static std::string SupportedIsa() {
+    unsigned leaf1[4], leaf7[4]{};
+    Cpuid(0, 0, leaf1);
+    const unsigned maxLeaf = leaf1[0];
+    Cpuid(1, 0, leaf1);
+    if (maxLeaf >= 7) Cpuid(7, 0, leaf7);
+
+    std::string isa;
+    const auto add = [&](bool supported, const char *name) {
+        if (!supported) return;
+        if (!isa.empty()) isa += ' ';
+        isa += name;
+    };
+    // ecx and edx of leaf 1, ebx of leaf 7
+    add(leaf1[3] & (1u << 26), "SSE2");
+    add(leaf1[2] & (1u << 19), "SSE4.1");
+    add(leaf1[2] & (1u << 20), "SSE4.2");
+    add(leaf1[2] & (1u << 28), "AVX");
+    add(leaf1[2] & (1u << 12), "FMA");
+    add(leaf7[1] & (1u << 5), "AVX2");
+    add(leaf7[1] & (1u << 16), "AVX512F");
+    return isa;
+}
+
+static std::string CompiledIsa() {
+    std::string isa = "SSE2";
+#if defined(__SSE4_1__) || defined(__AVX__)
+    isa += " SSE4.1";
+#endif
+#if defined(__SSE4_2__) || defined(__AVX__)
+    isa += " SSE4.2";
+#endif
+#ifdef __AVX__
+    isa += " AVX";
+#endif
+#if defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__))
+    isa += " FMA";
+#endif
+#ifdef __AVX2__
+    isa += " AVX2";
+#endif
+#ifdef __AVX512F__
+    isa += " AVX512F";
+#endif
+    return isa;
+}
+
+static std::string Compiler() {
+#if defined(__clang__)
+    return "Clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "GCC " __VERSION__;
+#elif defined(_MSC_VER)
+    return "MSVC " + std::to_string(_MSC_FULL_VER);
+#else
+    return "unknown";
+#endif
+}
+
+BenchmarkMetadata CollectMetadata() {
+    // Empty flag variables leave extra spaces
+    std::istringstream words{std::string{BENCHMARK_BUILD_TYPE} + ' ' + BENCHMARK_CXX_FLAGS};
+    std::string flags, word;
+    while (words >> word) flags += (flags.empty() ? "" : " ") + word;
+    return {CpuBrand(), CompiledIsa(), SupportedIsa(), Compiler(), flags};
+}
+
+std::vector<BenchmarkResult> &BenchmarkResults() {
+    static std::vector<BenchmarkResult> results;
+    return results;
+}
+
+static std::string JsonString(const std::string &s) {
+    std::string result = "\"";
+    for (const char c: s) {
+        if (c == '"' || c == '\\') {
+            result += '\\';
+            result += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            result += escaped;
+        } else {
+            result += c;
+        }
+    }
+    return result + '"';
+}
+
+bool WriteJson(const std::string &path, const BenchmarkMetadata &metadata, const std::vector<BenchmarkResult> &results) {
+    std::ofstream file{path};
+    if (!file) return false;
+    file.precision(17);
+
+    file << "{\n"
+         << "  \"metadata\": {\n"
+         << "    \"cpu\": " << JsonString(metadata.cpu) << ",\n"
+         << "    \"compiledIsa\": " << JsonString(metadata.compiledIsa) << ",\n"
+         << "    \"supportedIsa\": " << JsonString(metadata.supportedIsa) << ",\n"
+         << "    \"compiler\": " << JsonString(metadata.compiler) << ",\n"
+         << "    \"flags\": " << JsonString(metadata.flags) << "\n"
+         << "  },\n"
+         << "  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchmarkResult &result = results[i];
+        file << (i ? ",\n" : "\n")
+             << "    {\"testCase\": " << JsonString(result.testCase)
+             << ", \"name\": " << JsonString(result.name)
+             << ", \"meanNs\": " << result.mean
+             << ", \"medianNs\": " << result.median
+             << ", \"stddevNs\": " << result.standardDeviation
+             << ", \"p99Ns\": " << result.p99
+             << ", \"minNs\": " << result.min << "}";
+    }
+    file << "\n  ]\n}\n";
+    return static_cast<bool>(file);
+}
+
+static std::string CsvString(const std::string &s) {
+    std::string result = "\"";
+    for (const char c: s) {
+        if (c == '"') result += '"';
+        result += c;
+    }
+    return result + '"';
+}
+
+bool WriteCsv(const std::string &path, const BenchmarkMetadata &metadata, const std::vector<BenchmarkResult> &results) {
+    std::ofstream file{path};
+    if (!file) return false;
+    file.precision(17);
+
+    // Metadata as comment lines, skipped by ReadCsv
+    file << "# cpu: " << metadata.cpu << "\n"
+         << "# compiledIsa: " << metadata.compiledIsa << "\n"
+         << "# supportedIsa: " << metadata.supportedIsa << "\n"
+         << "# compiler: " << metadata.compiler << "\n"
+         << "# flags: " << metadata.flags << "\n"
+         << "testCase,name,meanNs,medianNs,stddevNs,p99Ns,minNs\n";
+    for (const BenchmarkResult &result: results) {
+        file << CsvString(result.testCase) << ',' << CsvString(result.name) << ','
+             << result.mean << ',' << result.median << ',' << result.standardDeviation << ','
+             << result.p99 << ',' << result.min << '\n';
+    }
+    return static_cast<bool>(file);
+}
+
+// Splits a line into fields, quoted fields may contain commas and doubled quotes
+static std::vector<std::string> SplitCsvLine(const std::string &line) {
+    std::vector<std::string> fields(1);
+    bool quoted = false;
+    for (size_t i = 0; i < line.size(); i++) {
+        const char c = line[i];
+        if (quoted) {
+            if (c != '"') {
+                fields.back() += c;
+            } else if (i + 1 < line.size() && line[i + 1] == '"') {
+                fields.back() += '"';
+                i++;
+            } else {
+                quoted = false;
+            }
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == ',') {
+            fields.emplace_back();
+        } else if (c != '\r') {
+            fields.back() += c;
+        }
+    }
+    return fields;
+}
+
+bool ReadCsv(const std::string &path, std::vector<BenchmarkResult> &results) {
+    std::ifstream file{path};
+    if (!file) return false;
+
+    std::string line;
+    bool header = true;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        if (header) {
+            header = false;
+            continue;
+        }
+        const std::vector<std::string> fields = SplitCsvLine(line);
+        if (fields.size() != 7) return false;
+        BenchmarkResult result{fields[0], fields[1], 0.0, 0.0, 0.0, 0.0, 0.0};
+        double *values[5] = {&result.mean, &result.median, &result.standardDeviation, &result.p99, &result.min};
+        for (int i = 0; i < 5; i++) {
+            std::istringstream stream{fields[i + 2]};
+            if (!(stream >> *values[i])) return false;
+        }
+        results.push_back(std::move(result));
+    }
+    return true;
+}
+
+int CompareToBaseline(const std::vector<BenchmarkResult> &results, const std::vector<BenchmarkResult> &baseline, double thresholdPercent) {
+    int regressions = 0;
+    printf("\n%-60s %14s %14s %9s\n", "Benchmark", "Baseline ns", "Current ns", "Change");
+    for (const BenchmarkResult &result: results) {
+        const auto old = std::find_if(baseline.begin(), baseline.end(), [&](const BenchmarkResult &b) {
+            return b.testCase == result.testCase && b.name == result.name;
+        });
+        if (old == baseline.end()) {
+            printf("%-60s %14s %14.1f %9s\n", result.name.c_str(), "-", result.median, "new");
+            continue;
+        }
+        // Medians, a few slow samples from other processes don't flag a regression
+        const double change = (result.median / old->median - 1.0) * 100.0;
+        const bool regressed = change > thresholdPercent;
+        regressions += regressed;
+        printf("%-60s %14.1f %14.1f %+8.1f%%%s\n", result.name.c_str(), old->median, result.median, change, regressed ? "  REGRESSION" : "");
+    }
+    printf("%d of %zu benchmarks regressed by more than %.1f%%\n", regressions, results.size(), thresholdPercent);
+    return regressions;
+}
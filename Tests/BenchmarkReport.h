@@ -0,0 +1,48 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Times are nanoseconds per run
+struct BenchmarkResult {
+    std::string testCase;
+    std::string name;
+    double mean;
+    double median;
+    double standardDeviation;
+    double p99;
+    double min;
+};
+
+// Statistics of the samples of one benchmark, samples must not be empty
+BenchmarkResult SummarizeSamples(std::string testCase, std::string name, std::vector<double> samples);
+
+struct BenchmarkMetadata {
+    std::string cpu;
+    // Instruction sets the benchmarks were compiled for, and the ones the CPU supports
+    std::string compiledIsa;
+    std::string supportedIsa;
+    std::string compiler;
+    std::string flags;
+};
+
+BenchmarkMetadata CollectMetadata();
+
+// Results of the benchmarks that ran so far, in order
+std::vector<BenchmarkResult> &BenchmarkResults();
+
+// Return false when the file can't be written
+bool WriteJson(const std::string &path, const BenchmarkMetadata &metadata, const std::vector<BenchmarkResult> &results);
+
+bool WriteCsv(const std::string &path, const BenchmarkMetadata &metadata, const std::vector<BenchmarkResult> &results);
+
+// Reads a file written by WriteCsv, returns false when the file can't be read
+bool ReadCsv(const std::string &path, std::vector<BenchmarkResult> &results);
+
+// Compares medians of benchmarks with the same test case and name, prints a table
+// Returns the number of benchmarks more than thresholdPercent slower than the baseline
+int CompareToBaseline(const std::vector<BenchmarkResult> &results, const std::vector<BenchmarkResult> &baseline, double thresholdPercent);
@@ -4,11 +4,83 @@
 
 #include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <cstdio>
 #include <glm/gtc/matrix_transform.hpp>
+#include <random>
+#include <string>
+#include <vector>
 
+#include "AABB.h"
+#include "Broadphase.h"
+#include "Bvh.h"
+#include "CameraBatch.h"
+#include "Cascades.h"
+#include "DepthRasterizer.h"
 #include "Mat4.h"
+#include "MeshBounds.h"
+#include "PerfCounters.h"
 #include "PlainMath.h"
 #include "Quat.h"
+#include "QuatBatch.h"
+#include "Ray.h"
+#include "SpatialHash.h"
+#include "TestUtils.h"
+#include "Triangle.h"
+#include "Trig.h"
+
+// A BENCHMARK of a kernel that processes elementsPerRun elements per run, named "<name> x<elementsPerRun>"
+// With --perf-counters the counters of exactly the measured runs are printed per element, Catch2's analysis excluded
+template<typename Func>
+static void BenchmarkElements(const std::string &name, size_t elementsPerRun, Func &&func) {
+    const std::string fullName = name + " x" + std::to_string(elementsPerRun);
+    PerfCounters *counters = ActivePerfCounters();
+    size_t runs = 0;
+    BENCHMARK_ADVANCED(fullName)(Catch::Benchmark::Chronometer meter) {
+        if (counters) {
+            if (runs) counters->Resume();
+            else counters->Start();
+        }
+        meter.measure(func);
+        if (counters) counters->Stop();
+        runs += static_cast<size_t>(meter.runs());
+    };
+    if (counters && runs) {
+        printf("%s:\n", fullName.c_str());
+        PrintPerfCounters(*counters, static_cast<double>(runs * elementsPerRun));
+    }
+}
+
+// Latency: every result is the input of the next call, so the calls can't overlap
+// Throughput: independent chains interleaved, so the CPU can overlap them, the way constant inputs do
+// inputs: one starting value per chain, distinct so the compiler can't merge the chains, latency uses the first
+// step: one call of the operation, with at most a free reinterpretation to turn its result into the next input
+template<typename T, typename Step>
+static void BenchmarkLatencyAndThroughput(const std::string &name, const std::vector<T> &inputs, Step &&step) {
+    constexpr size_t length = 1024;
+    constexpr size_t streams = 8;
+    REQUIRE(inputs.size() == streams);
+    // Written at the end of every run so no chain is dead code
+    std::vector<T> results(streams);
+
+    const auto latency = [&] {
+        T x = inputs[0];
+        for (size_t i = 0; i < length; i++) x = step(x);
+        results[0] = x;
+        return 0;
+    };
+    const auto throughput = [&] {
+        T x[streams];
+        for (size_t s = 0; s < streams; s++) x[s] = inputs[s];
+        for (size_t i = 0; i < length / streams; i++) {
+            for (size_t s = 0; s < streams; s++) x[s] = step(x[s]);
+        }
+        for (size_t s = 0; s < streams; s++) results[s] = x[s];
+        return 0;
+    };
+
+    BenchmarkElements(name + " Latency", length, latency);
+    BenchmarkElements(name + " Throughput 8 Streams", length, throughput);
+}
 
 TEST_CASE("Normalization Benchmarks") {
     const PlainVec plain{1.0f, 2.0f, 3.0f, 4.0f};
@@ -28,6 +100,28 @@ TEST_CASE("Normalization Benchmarks") {
         volatile Vec4 result = simd.FastNormalize();
         (void) result;
     };
+
+    // Batches for the per element numbers: _mm_dp_ps against a horizontal sum of shuffles
+    constexpr size_t count = 4096;
+    std::vector<Vec4> vectors(count);
+    for (size_t i = 0; i < count; i++) vectors[i] = Vec4{static_cast<float>(i) + 1.0f, 2.0f, 3.0f, 0.0f};
+    std::vector<Vec4> normalized(count);
+    const auto dotProduct = [&] {
+        for (size_t i = 0; i < count; i++) normalized[i] = vectors[i].Normalize();
+        return normalized.back().x;
+    };
+    const auto shuffles = [&] {
+        for (size_t i = 0; i < count; i++) {
+            const __m128 squares = _mm_mul_ps(vectors[i].m, vectors[i].m);
+            __m128 sum = _mm_add_ps(squares, _mm_shuffle_ps(squares, squares, _MM_SHUFFLE(2, 3, 0, 1)));
+            sum = _mm_add_ps(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 0, 3, 2)));
+            normalized[i] = Vec4{_mm_div_ps(vectors[i].m, _mm_sqrt_ps(sum))};
+        }
+        return normalized.back().x;
+    };
+
+    BenchmarkElements("SIMD Normalize _mm_dp_ps", count, dotProduct);
+    BenchmarkElements("SIMD Normalize Shuffles", count, shuffles);
 }
 
 TEST_CASE("Cross Product Benchmarks") {
@@ -48,6 +142,101 @@ TEST_CASE("Cross Product Benchmarks") {
     };
 }
 
+TEST_CASE("Latency And Throughput Benchmarks") {
+    std::vector<PlainVec> plainVectors;
+    std::vector<Vec4> vectors;
+    std::vector<glm::mat4> plainMatrices;
+    std::vector<Mat4> matrices;
+    std::vector<PlainQuat> plainQuats;
+    std::vector<Quat> quats;
+    std::vector<glm::vec3> plainEyes;
+    std::vector<Vec4> eyes;
+    for (int i = 0; i < 8; i++) {
+        const auto f = static_cast<float>(i);
+        // Repeated cross products with the unit axis below rotate these around it, their length stays bounded
+        plainVectors.push_back({1.0f + f, -1.0f - f, 0.5f, 0.0f});
+        vectors.emplace_back(1.0f + f, -1.0f - f, 0.5f, 0.0f);
+        const Mat4 rotation = Mat4::RotateY(0.1f + f) * Mat4::RotateX(0.2f * f);
+        matrices.push_back(rotation);
+        plainMatrices.emplace_back(rotation[0], rotation[1], rotation[2], rotation[3],
+                                   rotation[4], rotation[5], rotation[6], rotation[7],
+                                   rotation[8], rotation[9], rotation[10], rotation[11],
+                                   rotation[12], rotation[13], rotation[14], rotation[15]);
+        const Quat q{Vec4{1.0f, f, 2.0f, 0.0f}.Normalize(), 0.3f + f};
+        quats.push_back(q);
+        plainQuats.push_back({q.x, q.y, q.z, q.w});
+        // On the z axis, other eyes converge to it through denormals
+        plainEyes.emplace_back(0.0f, 0.0f, 3.0f + f);
+        eyes.emplace_back(0.0f, 0.0f, 3.0f + f, 1.0f);
+    }
+    const PlainVec plainAxis{0.0f, 0.0f, 1.0f, 0.0f};
+    const Vec4 axis{0.0f, 0.0f, 1.0f, 0.0f};
+    const Mat4 rotation = matrices[3];
+    const glm::mat4 plainRotation = plainMatrices[3];
+    const Quat spin = quats[3];
+    const PlainQuat plainSpin = plainQuats[3];
+
+    // Averaging weights keep the broadcast dot product from growing or shrinking
+    const PlainVec plainQuarter{0.25f, 0.25f, 0.25f, 0.25f};
+    const Vec4 quarter{0.25f};
+    BenchmarkLatencyAndThroughput("Plain Dot Product", plainVectors, [&](const PlainVec &v) {
+        const float d = plainQuarter.Dot(v);
+        return PlainVec{d, d, d, d};
+    });
+    BenchmarkLatencyAndThroughput("SIMD Dot Product", vectors, [&](const Vec4 &v) { return Vec4{quarter.Dot(v)}; });
+    // The length goes back into x with the other lanes cleared, so it stays the same
+    BenchmarkLatencyAndThroughput("Plain Length", plainVectors, [](const PlainVec &v) { return PlainVec{v.Length(), 0.0f, 0.0f, 0.0f}; });
+    BenchmarkLatencyAndThroughput("SIMD Length", vectors, [](const Vec4 &v) { return Vec4{_mm_set_ss(v.Length())}; });
+
+    BenchmarkLatencyAndThroughput("Plain Normalize", plainVectors, [](const PlainVec &v) { return v.Normalize(); });
+    BenchmarkLatencyAndThroughput("SIMD Normalize", vectors, [](const Vec4 &v) { return v.Normalize(); });
+    BenchmarkLatencyAndThroughput("SIMD Fast Normalize", vectors, [](const Vec4 &v) { return v.FastNormalize(); });
+
+    BenchmarkLatencyAndThroughput("Plain Cross Product", plainVectors, [&](const PlainVec &v) { return plainAxis.Cross(v); });
+    BenchmarkLatencyAndThroughput("SIMD Cross Product", vectors, [&](const Vec4 &v) { return axis.Cross(v); });
+
+    BenchmarkLatencyAndThroughput("Plain Matrix Multiplication", plainMatrices, [&](const glm::mat4 &m) { return plainRotation * m; });
+    BenchmarkLatencyAndThroughput("SIMD Matrix Multiplication", matrices, [&](const Mat4 &m) { return rotation * m; });
+    BenchmarkLatencyAndThroughput("SIMD Matrix Vector Multiplication", vectors, [&](const Vec4 &v) { return rotation * v; });
+    BenchmarkLatencyAndThroughput("Plain Transpose", plainMatrices, [](const glm::mat4 &m) { return glm::transpose(m); });
+    BenchmarkLatencyAndThroughput("SIMD Transpose", matrices, [](const Mat4 &m) { return m.Transpose(); });
+
+    // sin + cos and atan stay within [-sqrt(2), sqrt(2)], 4 lanes per call on both sides
+    BenchmarkLatencyAndThroughput("Plain SinCos", plainVectors, [](const PlainVec &v) {
+        return PlainVec{std::sin(v.x) + std::cos(v.x), std::sin(v.y) + std::cos(v.y),
+                        std::sin(v.z) + std::cos(v.z), std::sin(v.w) + std::cos(v.w)};
+    });
+    BenchmarkLatencyAndThroughput("SIMD SinCos", vectors, [](const Vec4 &v) {
+        __m128 s, c;
+        SinCos(v.m, s, c);
+        return Vec4{_mm_add_ps(s, c)};
+    });
+    BenchmarkLatencyAndThroughput("Plain Atan2", plainVectors, [](const PlainVec &v) {
+        return PlainVec{std::atan2(v.x, 1.0f), std::atan2(v.y, 1.0f), std::atan2(v.z, 1.0f), std::atan2(v.w, 1.0f)};
+    });
+    BenchmarkLatencyAndThroughput("SIMD Atan2", vectors, [](const Vec4 &v) { return Vec4{Atan2(v.m, _mm_set_ps1(1.0f))}; });
+
+    // Like m_rotation = Quat{...} * m_rotation in Visualization
+    BenchmarkLatencyAndThroughput("Plain Quat Hamilton Product", plainQuats, [&](const PlainQuat &q) { return plainSpin * q; });
+    BenchmarkLatencyAndThroughput("SIMD Quat Hamilton Product", quats, [&](const Quat &q) { return spin * q; });
+
+    // The first column of a rotation is a unit vector, read back as the next quaternion
+    BenchmarkLatencyAndThroughput("Plain Quat To Matrix", plainQuats, [](const PlainQuat &q) {
+        const Mat4 m = q.ToMat4();
+        return PlainQuat{m.c0.x, m.c0.y, m.c0.z, m.c0.w};
+    });
+    BenchmarkLatencyAndThroughput("SIMD Quat To Matrix", quats, [](const Quat &q) { return Quat{q.ToMat4().c0.m}; });
+
+    // Looking at the origin, the translation of the view is (0, 0, -distance), the next eye
+    BenchmarkLatencyAndThroughput("Plain LookAt", plainEyes, [](const glm::vec3 &eye) {
+        const glm::mat4 view = glm::lookAt(eye, glm::vec3{0.0f, 0.0f, 0.0f}, glm::vec3{0.0f, 1.0f, 0.0f});
+        return glm::vec3{view[3].x, view[3].y, view[3].z};
+    });
+    BenchmarkLatencyAndThroughput("SIMD LookAt", eyes, [](const Vec4 &eye) {
+        return Mat4::LookAt(eye, {0.0f, 0.0f, 0.0f, 1.0f}, {0.0f, 1.0f, 0.0f, 0.0f}).c3;
+    });
+}
+
 TEST_CASE("Matrix Multiplication Benchmarks") {
     const glm::mat4 plain{1.0f, 2.0f, 3.0f, 4.0f,
                           5.0f, 6.0f, 7.0f, 8.0f,
@@ -121,3 +310,518 @@ TEST_CASE("Quaternion To Matrix Benchmarks") {
         (void) result;
     };
 }
+
+TEST_CASE("Batch Quaternion Construction Benchmarks") {
+    constexpr size_t count = 4096;
+    std::vector<float> x(count), y(count), z(count), angles(count);
+    for (size_t i = 0; i < count; i++) {
+        x[i] = static_cast<float>(i % 7) - 3.0f;
+        y[i] = static_cast<float>(i % 5) + 1.0f;
+        z[i] = static_cast<float>(i % 3) - 1.0f;
+        angles[i] = static_cast<float>(i) * 0.01f;
+    }
+    const Vec3SoA vectors{x.data(), y.data(), z.data()};
+
+    std::vector<Quat> quats(count);
+    std::vector<float> qx(count), qy(count), qz(count), qw(count);
+    const Vec4SoA quatsSoA{qx.data(), qy.data(), qz.data(), qw.data()};
+
+    BENCHMARK("Plain Quat From Axis Angle x4096") {
+        for (size_t i = 0; i < count; i++) {
+            quats[i] = Quat{{x[i], y[i], z[i], 0.0f}, angles[i]};
+        }
+        return quats[count - 1].w;
+    };
+
+    BENCHMARK("SIMD Batch Quat From Axis Angle x4096") {
+        QuatBatch::FromAxisAngle(count, vectors, angles.data(), quatsSoA);
+        return qw[count - 1];
+    };
+
+    BENCHMARK("Plain Quat From Euler x4096") {
+        for (size_t i = 0; i < count; i++) {
+            quats[i] = Quat{{0.0f, 0.0f, 1.0f, 0.0f}, z[i]} *
+                       Quat{{0.0f, 1.0f, 0.0f, 0.0f}, y[i]} *
+                       Quat{{1.0f, 0.0f, 0.0f, 0.0f}, x[i]};
+        }
+        return quats[count - 1].w;
+    };
+
+    BENCHMARK("SIMD Batch Quat From Euler x4096") {
+        QuatBatch::FromEuler(count, vectors, EulerOrder::XYZ, quatsSoA);
+        return qw[count - 1];
+    };
+
+    std::vector<float> ex(count), ey(count), ez(count);
+    BENCHMARK("SIMD Batch Quat To Euler x4096") {
+        QuatBatch::ToEuler(count, quatsSoA, EulerOrder::XYZ, {ex.data(), ey.data(), ez.data()});
+        return ez[count - 1];
+    };
+
+    BENCHMARK("Plain Quat From Angular Velocity x4096") {
+        for (size_t i = 0; i < count; i++) {
+            const Vec4 omega{x[i], y[i], z[i], 0.0f};
+            quats[i] = Quat{omega, omega.Length() * (1.0f / 60.0f)};
+        }
+        return quats[count - 1].w;
+    };
+
+    BENCHMARK("SIMD Batch Quat From Angular Velocity x4096") {
+        QuatBatch::FromAngularVelocity(count, vectors, 1.0f / 60.0f, quatsSoA);
+        return qw[count - 1];
+    };
+}
+
+TEST_CASE("Camera Batch Benchmarks") {
+    constexpr size_t count = 1000;
+    std::vector<float> eyeX(count), eyeY(count), eyeZ(count);
+    std::vector<float> targetX(count, 0.0f), targetY(count, 0.0f), targetZ(count, 0.0f);
+    std::vector<float> upX(count, 0.0f), upY(count, 1.0f), upZ(count, 0.0f);
+    std::vector<float> fov(count, M_PI / 3.0f), aspectRatio(count, 16.0f / 9.0f), near(count, 0.1f), far(count, 100.0f);
+    for (size_t i = 0; i < count; i++) {
+        eyeX[i] = static_cast<float>(i % 17) + 1.0f;
+        eyeY[i] = static_cast<float>(i % 13) + 2.0f;
+        eyeZ[i] = static_cast<float>(i % 11) + 3.0f;
+    }
+    const CameraSoA cameras{{eyeX.data(), eyeY.data(), eyeZ.data()},
+                            {targetX.data(), targetY.data(), targetZ.data()},
+                            {upX.data(), upY.data(), upZ.data()},
+                            fov.data(),
+                            aspectRatio.data(),
+                            near.data(),
+                            far.data()};
+
+    std::vector<Mat4> views(count), projections(count), viewProjections(count);
+
+    BENCHMARK("Plain Camera Matrices x1000") {
+        for (size_t i = 0; i < count; i++) {
+            views[i] = Mat4::LookAt({eyeX[i], eyeY[i], eyeZ[i], 1.0f},
+                                    {targetX[i], targetY[i], targetZ[i], 1.0f},
+                                    {upX[i], upY[i], upZ[i], 0.0f});
+            projections[i] = Mat4::Perspective(fov[i], aspectRatio[i], near[i], far[i]);
+            viewProjections[i] = projections[i] * views[i];
+        }
+        return viewProjections[count - 1].c3.w;
+    };
+
+    BENCHMARK("SIMD Batch Camera Matrices x1000") {
+        CameraBatch::Build(count, cameras, DepthMode::Standard, views.data(), projections.data(), viewProjections.data());
+        return viewProjections[count - 1].c3.w;
+    };
+
+    BENCHMARK("SIMD Batch Reverse-Z Infinite Camera Matrices x1000") {
+        CameraBatch::Build(count, cameras, DepthMode::ReverseZInfinite, views.data(), projections.data(), viewProjections.data());
+        return viewProjections[count - 1].c3.w;
+    };
+}
+
+TEST_CASE("Cascaded Shadow Map Benchmarks") {
+    const CascadeCamera camera{{1.0f, 2.0f, 3.0f, 1.0f},
+                               {0.0f, 0.0f, 0.0f, 1.0f},
+                               {0.0f, 1.0f, 0.0f, 0.0f},
+                               M_PI / 3.0f,
+                               16.0f / 9.0f,
+                               0.1f,
+                               100.0f};
+
+    constexpr int cascadeCount = 4;
+    constexpr size_t lightCount = 64;
+    std::vector<Vec4> lights(lightCount);
+    for (size_t i = 0; i < lightCount; i++) {
+        lights[i] = Vec4{std::cos(static_cast<float>(i)), -1.0f, std::sin(static_cast<float>(i)), 0.0f};
+    }
+
+    CascadeSlice slices[cascadeCount];
+    std::vector<CascadeMatrices> matrices(cascadeCount * lightCount);
+
+    BENCHMARK("SIMD Cascade Slices x4") {
+        Cascades::ComputeSlices(camera, cascadeCount, 0.75f, slices);
+        return slices[cascadeCount - 1].radius;
+    };
+
+    BENCHMARK("SIMD Cascade Sphere Fit x4 x64 Lights") {
+        Cascades::FitLights(slices, cascadeCount, lights.data(), lightCount, CascadeFit::Sphere, 2048.0f, 50.0f, matrices.data());
+        return matrices.back().viewProjection.c3.w;
+    };
+
+    BENCHMARK("SIMD Cascade Tight Fit x4 x64 Lights") {
+        Cascades::FitLights(slices, cascadeCount, lights.data(), lightCount, CascadeFit::Tight, 2048.0f, 50.0f, matrices.data());
+        return matrices.back().viewProjection.c3.w;
+    };
+}
+
+TEST_CASE("Ray Box Benchmarks") {
+    constexpr size_t count = 1024;
+    std::vector<Ray> rays(count);
+    std::vector<AABB4> boxes4(count);
+    std::vector<AABB8> boxes8(count);
+    std::vector<AABB> boxes(count);
+    for (size_t i = 0; i < count; i++) {
+        const auto f = static_cast<float>(i);
+        rays[i] = Ray{{std::sin(f) * 10.0f, std::cos(f) * 10.0f, -20.0f, 1.0f}, {std::sin(f * 3.0f), std::cos(f * 5.0f), 1.0f, 0.0f}};
+        boxes[i] = AABB{{-f * 0.01f, -1.0f, -1.0f, 1.0f}, {f * 0.01f, 1.0f, 1.0f, 1.0f}};
+        for (int lane = 0; lane < 8; lane++) {
+            const float offset = static_cast<float>(lane) - 4.0f;
+            if (lane < 4) {
+                boxes4[i].minX[lane] = boxes4[i].minY[lane] = boxes4[i].minZ[lane] = offset;
+                boxes4[i].maxX[lane] = boxes4[i].maxY[lane] = boxes4[i].maxZ[lane] = offset + 2.0f;
+            }
+            boxes8[i].minX[lane] = boxes8[i].minY[lane] = boxes8[i].minZ[lane] = offset;
+            boxes8[i].maxX[lane] = boxes8[i].maxY[lane] = boxes8[i].maxZ[lane] = offset + 2.0f;
+        }
+    }
+    std::vector<RayPacket4> packets4(count / 4);
+    std::vector<RayPacket8> packets8(count / 8);
+    for (size_t i = 0; i < count / 4; i++) packets4[i] = RayPacket4{&rays[i * 4]};
+    for (size_t i = 0; i < count / 8; i++) packets8[i] = RayPacket8{&rays[i * 8]};
+
+    const auto oneByOne = [&] {
+        int hits = 0;
+        float tEntry;
+        for (size_t i = 0; i < count; i++) hits += Intersect(rays[i], boxes[i], tEntry);
+        return hits;
+    };
+    const auto oneVsFour = [&] {
+        int hits = 0;
+        __m128 tEntry;
+        for (size_t i = 0; i < count; i++) hits += Intersect(rays[i], boxes4[i], tEntry);
+        return hits;
+    };
+    const auto oneVsEight = [&] {
+        int hits = 0;
+        __m256 tEntry;
+        for (size_t i = 0; i < count; i++) hits += Intersect(rays[i], boxes8[i], tEntry);
+        return hits;
+    };
+    const auto fourVsOne = [&] {
+        int hits = 0;
+        __m128 tEntry;
+        for (size_t i = 0; i < count / 4; i++) hits += Intersect(packets4[i], boxes[i], tEntry);
+        return hits;
+    };
+    const auto eightVsOne = [&] {
+        int hits = 0;
+        __m256 tEntry;
+        for (size_t i = 0; i < count / 8; i++) hits += Intersect(packets8[i], boxes[i], tEntry);
+        return hits;
+    };
+
+    // Elements are ray box tests
+    BenchmarkElements("SIMD 1 Ray vs 1 Box", count, oneByOne);
+    BenchmarkElements("SIMD 1 Ray vs 4 Boxes", count * 4, oneVsFour);
+    BenchmarkElements("SIMD 1 Ray vs 8 Boxes", count * 8, oneVsEight);
+    BenchmarkElements("SIMD 4 Rays vs 1 Box", count, fourVsOne);
+    BenchmarkElements("SIMD 8 Rays vs 1 Box", count, eightVsOne);
+}
+
+TEST_CASE("Bvh Benchmarks") {
+    constexpr size_t count = 100000;
+    std::mt19937 rng{42};
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> extent(0.01f, 1.0f);
+    std::vector<AABB> boxes(count);
+    for (AABB &box: boxes) {
+        box.min = Vec4{position(rng), position(rng), position(rng), 1.0f};
+        box.max = box.min + Vec4{extent(rng), extent(rng), extent(rng), 0.0f};
+    }
+    std::vector<Ray> rays(256);
+    for (Ray &ray: rays) {
+        ray = Ray{{position(rng), position(rng), position(rng), 1.0f},
+                  Vec4{position(rng), position(rng), position(rng), 0.0f}.Normalize()};
+    }
+
+    BENCHMARK("SAH Bvh4 Build x100000") {
+        return Bvh<4>{boxes.data(), count}.Nodes().size();
+    };
+
+    BENCHMARK("SAH Bvh8 Build x100000") {
+        return Bvh<8>{boxes.data(), count}.Nodes().size();
+    };
+
+    const Bvh<4> bvh4{boxes.data(), count};
+    const Bvh<8> bvh8{boxes.data(), count};
+
+    BENCHMARK("Bvh4 Refit x100000") {
+        Bvh<4> bvh = bvh4;
+        bvh.Refit(boxes.data());
+        return bvh.Nodes().size();
+    };
+
+    const auto closestHits = [&](const auto &bvh, size_t rayCount) {
+        const auto intersectLeaf = [&](const Ray &ray, uint32_t first, uint32_t leafCount, BvhHit &hit) {
+            bool found = false;
+            for (uint32_t i = first; i < first + leafCount; i++) {
+                float t;
+                if (Intersect(ray, boxes[bvh.Indices()[i]], t) && t < hit.t) {
+                    hit = {t, bvh.Indices()[i]};
+                    found = true;
+                }
+            }
+            return found;
+        };
+        int hits = 0;
+        for (size_t i = 0; i < rayCount; i++) {
+            BvhHit hit;
+            hits += bvh.ClosestHit(rays[i], intersectLeaf, hit);
+        }
+        return hits;
+    };
+
+    BENCHMARK("Brute Force Closest Hit x16 Rays") {
+        int hits = 0;
+        for (size_t i = 0; i < 16; i++) {
+            float closest = std::numeric_limits<float>::max();
+            for (const AABB &box: boxes) {
+                float t;
+                if (Intersect(rays[i], box, t) && t < closest) closest = t;
+            }
+            hits += closest < std::numeric_limits<float>::max();
+        }
+        return hits;
+    };
+
+    // Elements are rays
+    BenchmarkElements("Bvh4 Closest Hit", rays.size(), [&] { return closestHits(bvh4, rays.size()); });
+    BenchmarkElements("Bvh8 Closest Hit", rays.size(), [&] { return closestHits(bvh8, rays.size()); });
+}
+
+TEST_CASE("Ray Triangle Benchmarks") {
+    constexpr size_t count = 1024;
+    std::mt19937 rng{31};
+    std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> offset(-2.0f, 2.0f);
+    std::vector<Vec4> positions(count * 3);
+    for (size_t i = 0; i < count; i++) {
+        const Vec4 center{position(rng), position(rng), 0.0f, 1.0f};
+        for (int corner = 0; corner < 3; corner++) positions[i * 3 + corner] = center + Vec4{offset(rng), offset(rng), offset(rng), 0.0f};
+    }
+    const std::vector<TriangleBlock8> blocks = BuildTriangleBlocks(positions.data(), sizeof(Vec4), count);
+    const Ray ray{{1.0f, 2.0f, -20.0f, 1.0f}, Vec4{0.01f, -0.02f, 1.0f, 0.0f}.Normalize()};
+
+    const auto scalar = [&] {
+        TriangleHit hit;
+        for (size_t i = 0; i < count; i++) {
+            float t, u, v;
+            if (Intersect(ray, positions[i * 3], positions[i * 3 + 1], positions[i * 3 + 2], t, u, v) && t < hit.t) {
+                hit = {t, u, v, static_cast<uint32_t>(i)};
+            }
+        }
+        return hit.triangle;
+    };
+    const auto wide = [&] {
+        TriangleHit hit;
+        IntersectTriangles(ray, blocks.data(), 0, count, hit);
+        return hit.triangle;
+    };
+
+    // Elements are ray triangle tests
+    BenchmarkElements("SIMD 1 Ray vs 1 Triangle", count, scalar);
+    BenchmarkElements("SIMD 1 Ray vs 8 Triangles", count, wide);
+}
+
+TEST_CASE("Broadphase Benchmarks") {
+    constexpr size_t count = 100000;
+    std::mt19937 rng{32};
+    std::uniform_real_distribution<float> position(0.0f, 1000.0f);
+    std::uniform_real_distribution<float> extent(0.5f, 4.0f);
+    std::uniform_real_distribution<float> jitter(-0.05f, 0.05f);
+    std::vector<Vec4> mins(count), maxs(count);
+    for (size_t i = 0; i < count; i++) {
+        mins[i] = Vec4{position(rng), position(rng) * 0.2f, position(rng), 1.0f};
+        maxs[i] = mins[i] + Vec4{extent(rng), extent(rng), extent(rng), 0.0f};
+    }
+
+    BENCHMARK("Brute Force Pairs x5000") {
+        size_t pairs = 0;
+        for (size_t a = 0; a < 5000; a++) {
+            for (size_t b = a + 1; b < 5000; b++) {
+                const __m128 overlap = _mm_and_ps(_mm_cmple_ps(mins[a].m, maxs[b].m), _mm_cmple_ps(mins[b].m, maxs[a].m));
+                pairs += (_mm_movemask_ps(overlap) & 0b0111) == 0b0111;
+            }
+        }
+        return pairs;
+    };
+
+    Broadphase broadphase;
+    BENCHMARK("Sort And Sweep x100000") {
+        broadphase.Update(mins.data(), maxs.data(), count);
+        return broadphase.Pairs().size();
+    };
+
+    // Coherent frames, every box moves a little
+    BENCHMARK("Incremental Sort And Sweep x100000") {
+        for (size_t i = 0; i < count; i++) {
+            const Vec4 offset{jitter(rng), jitter(rng), jitter(rng), 0.0f};
+            mins[i] = mins[i] + offset;
+            maxs[i] = maxs[i] + offset;
+        }
+        broadphase.Update(mins.data(), maxs.data(), count, true);
+        return broadphase.Pairs().size();
+    };
+}
+
+TEST_CASE("Transform AABB Benchmarks") {
+    constexpr size_t count = 10000;
+    std::vector<Mat4> matrices(count);
+    std::vector<Affine3x4> affines(count);
+    std::vector<AABB> boxes(count);
+    for (size_t i = 0; i < count; i++) {
+        const auto f = static_cast<float>(i);
+        matrices[i] = Mat4::Translate({f, 0.5f * f, -f, 1.0f}) * Mat4::RotateY(f * 0.1f) * Mat4::RotateX(f * 0.3f);
+        affines[i] = Affine3x4{matrices[i]};
+        boxes[i] = {{-1.0f, -2.0f, -0.5f, 1.0f}, {1.0f, f * 0.001f, 0.5f, 1.0f}};
+    }
+    // Same SoA output for every method
+    std::vector<float> soa(6 * count);
+    const Vec3SoA mins{soa.data(), soa.data() + count, soa.data() + 2 * count};
+    const Vec3SoA maxs{soa.data() + 3 * count, soa.data() + 4 * count, soa.data() + 5 * count};
+
+    const auto corners = [&] {
+        for (size_t i = 0; i < count; i++) {
+            const AABB &box = boxes[i];
+            AABB world = AABB::Empty();
+            for (int corner = 0; corner < 8; corner++) {
+                const Vec4 p{corner & 1 ? box.max.x : box.min.x,
+                             corner & 2 ? box.max.y : box.min.y,
+                             corner & 4 ? box.max.z : box.min.z,
+                             1.0f};
+                world = world.Union(matrices[i] * p);
+            }
+            mins.x[i] = world.min.x;
+            mins.y[i] = world.min.y;
+            mins.z[i] = world.min.z;
+            maxs.x[i] = world.max.x;
+            maxs.y[i] = world.max.y;
+            maxs.z[i] = world.max.z;
+        }
+        return maxs.x[count - 1];
+    };
+    const auto arvo = [&] {
+        TransformAABBs(matrices.data(), boxes.data(), count, mins, maxs);
+        return maxs.x[count - 1];
+    };
+    const auto arvoAffine = [&] {
+        TransformAABBs(affines.data(), boxes.data(), count, mins, maxs);
+        return maxs.x[count - 1];
+    };
+
+    BenchmarkElements("8 Corners Transform AABB", count, corners);
+    BenchmarkElements("Arvo Transform AABB Mat4", count, arvo);
+    BenchmarkElements("Arvo Transform AABB Affine3x4", count, arvoAffine);
+}
+
+TEST_CASE("Spatial Hash Benchmarks") {
+    constexpr size_t count = 1000000;
+    constexpr size_t queryCount = 100000;
+    std::mt19937 rng{34};
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::vector<Vec4> positions(count);
+    for (Vec4 &p: positions) p = Vec4{position(rng), position(rng), position(rng), 1.0f};
+
+    SpatialHashGrid grid{2.0f};
+    std::vector<uint32_t> offsets, neighbors;
+
+    BENCHMARK("Spatial Hash Rebuild x1000000") {
+        grid.Rebuild(positions.data(), count);
+        return grid.Indices().size();
+    };
+
+    grid.Rebuild(positions.data(), count);
+    BENCHMARK("Spatial Hash Radius Queries x100000") {
+        grid.Query(positions.data(), queryCount, 2.0f, offsets, neighbors);
+        return neighbors.size();
+    };
+
+    // Queries in bucket order touch neighboring memory
+    std::vector<Vec4> bucketOrder(queryCount);
+    for (size_t i = 0; i < queryCount; i++) bucketOrder[i] = positions[grid.Indices()[i * (count / queryCount)]];
+    BENCHMARK("Spatial Hash Radius Queries In Bucket Order x100000") {
+        grid.Query(bucketOrder.data(), queryCount, 2.0f, offsets, neighbors);
+        return neighbors.size();
+    };
+
+    // The per frame cost for a particle simulation
+    BENCHMARK("Spatial Hash Rebuild x1000000 And Queries x100000") {
+        grid.Rebuild(positions.data(), count);
+        grid.Query(positions.data(), queryCount, 2.0f, offsets, neighbors);
+        return neighbors.size();
+    };
+}
+
+TEST_CASE("Depth Rasterizer Benchmarks") {
+    constexpr int width = 512;
+    constexpr int height = 256;
+    const Mat4 view = Mat4::LookAt({0.0f, 2.0f, 0.0f, 1.0f}, {0.0f, 2.0f, -1.0f, 1.0f}, {0.0f, 1.0f, 0.0f, 0.0f});
+    const Mat4 projection = Mat4::Perspective(static_cast<float>(M_PI) / 3.0f, static_cast<float>(width) / height, 0.1f, 500.0f);
+    const Mat4 viewProjection = projection * view;
+
+    // A street of 256 walls, each a CreateBox mesh
+    std::vector<std::vector<Vec4>> occluders;
+    for (int i = 0; i < 256; i++) {
+        const auto f = static_cast<float>(i);
+        const float x = (i % 2 ? 1.0f : -1.0f) * (6.0f + std::sin(f) * 3.0f);
+        const float z = -5.0f - f * 1.5f;
+        occluders.push_back(CreateBoxPositions({x - 4.0f, 0.0f, z - 1.0f, 1.0f}, {x + 4.0f, 8.0f + std::cos(f) * 3.0f, z, 1.0f}));
+    }
+
+    std::mt19937 rng{35};
+    std::uniform_real_distribution<float> position(-40.0f, 40.0f);
+    std::uniform_real_distribution<float> depth(-400.0f, -3.0f);
+    std::vector<AABB> boxes(10000);
+    for (AABB &box: boxes) {
+        const Vec4 center{position(rng), position(rng) * 0.1f + 2.0f, depth(rng), 1.0f};
+        box = {center - Vec4{0.5f, 0.5f, 0.5f, 0.0f}, center + Vec4{0.5f, 0.5f, 0.5f, 0.0f}};
+    }
+    std::vector<uint8_t> visible(boxes.size());
+
+    DepthRasterizer rasterizer{width, height};
+    const auto render = [&] {
+        rasterizer.Clear();
+        for (const std::vector<Vec4> &occluder: occluders) rasterizer.AddOccluder(viewProjection, occluder.data(), sizeof(Vec4), occluder.size() / 3);
+        rasterizer.Render();
+        return rasterizer.Levels().back().depth[0];
+    };
+
+    BENCHMARK("Rasterize 256 Occluders 512x256") { return render(); };
+
+    render();
+    BENCHMARK("Hierarchical Z Test x10000 Boxes") {
+        rasterizer.TestVisibility(viewProjection, boxes.data(), boxes.size(), visible.data());
+        return visible.back();
+    };
+
+    // Some boxes are hidden behind the occluders, but not all of them
+    rasterizer.TestVisibility(viewProjection, boxes.data(), boxes.size(), visible.data());
+    size_t visibleCount = 0;
+    for (const uint8_t v: visible) visibleCount += v;
+    CHECK(0 < visibleCount);
+    CHECK(visibleCount < boxes.size());
+}
+
+TEST_CASE("Mesh Bounds Benchmarks") {
+    // Same layout as the Vertex of Visualization
+    struct Vertex {
+        Vec4 position;
+        Vec4 normal;
+    };
+    constexpr size_t count = 100000;
+    std::mt19937 rng{36};
+    std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+    std::vector<Vertex> vertices(count);
+    for (Vertex &vertex: vertices) {
+        vertex.position = Vec4{position(rng), position(rng), position(rng), 1.0f};
+        vertex.normal = Vec4{position(rng), position(rng), std::abs(position(rng)), 0.0f}.Normalize();
+    }
+
+    const auto scalar = [&] {
+        AABB box = AABB::Empty();
+        for (const Vertex &vertex: vertices) box = box.Union(vertex.position);
+        return box.max.x;
+    };
+    const auto simd = [&] { return ComputeAABB(&vertices[0].position, sizeof(Vertex), count).max.x; };
+    const auto all = [&] { return ComputeMeshBounds(&vertices[0].position, &vertices[0].normal, sizeof(Vertex), count).sphere.radius; };
+
+    BenchmarkElements("Scalar Vertex AABB", count, scalar);
+    BenchmarkElements("SIMD Parallel Vertex AABB", count, simd);
+    BenchmarkElements("SIMD Parallel Mesh Bounds", count, all);
+}
@@ -0,0 +1,166 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "Broadphase.h"
+#include "Parallel.h"
+#include "TestUtils.h"
+
+struct Boxes {
+    std::vector<Vec4> mins;
+    std::vector<Vec4> maxs;
+};
+
+static Boxes RandomBoxes(size_t count, const Vec4 &worldSize, float maxExtent, std::mt19937 &rng) {
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    Boxes boxes;
+    for (size_t i = 0; i < count; i++) {
+        const Vec4 min = Vec4{unit(rng), unit(rng), unit(rng), 1.0f} * worldSize;
+        boxes.mins.push_back(min);
+        boxes.maxs.push_back(min + Vec4{unit(rng), unit(rng), unit(rng), 0.0f} * Vec4{maxExtent});
+    }
+    return boxes;
+}
+
+static bool Overlap(const Boxes &boxes, size_t a, size_t b) {
+    for (int axis = 0; axis < 3; axis++) {
+        if (boxes.mins[a][axis] > boxes.maxs[b][axis] || boxes.mins[b][axis] > boxes.maxs[a][axis]) return false;
+    }
+    return true;
+}
+
+static std::vector<uint64_t> Sorted(const std::vector<BroadphasePair> &pairs) {
+    std::vector<uint64_t> keys;
+    for (const BroadphasePair &pair: pairs) {
+        CHECK(pair.a < pair.b);
+        keys.push_back(static_cast<uint64_t>(pair.a) << 32 | pair.b);
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+static std::vector<uint64_t> BruteForce(const Boxes &boxes) {
+    std::vector<BroadphasePair> pairs;
+    for (size_t a = 0; a < boxes.mins.size(); a++) {
+        for (size_t b = a + 1; b < boxes.mins.size(); b++) {
+            if (Overlap(boxes, a, b)) pairs.push_back({static_cast<uint32_t>(a), static_cast<uint32_t>(b)});
+        }
+    }
+    return Sorted(pairs);
+}
+
+// Scalar sort and sweep, for counts too large for the brute force
+static std::vector<uint64_t> ScalarSweep(const Boxes &boxes, int axis) {
+    std::vector<uint32_t> order(boxes.mins.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = static_cast<uint32_t>(i);
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return boxes.mins[a][axis] < boxes.mins[b][axis]; });
+    std::vector<BroadphasePair> pairs;
+    for (size_t i = 0; i < order.size(); i++) {
+        for (size_t j = i + 1; j < order.size() && boxes.mins[order[j]][axis] <= boxes.maxs[order[i]][axis]; j++) {
+            if (Overlap(boxes, order[i], order[j])) pairs.push_back({std::min(order[i], order[j]), std::max(order[i], order[j])});
+        }
+    }
+    return Sorted(pairs);
+}
+
+static void CheckOrder(const Broadphase &broadphase, const Boxes &boxes) {
+    const std::vector<uint32_t> &order = broadphase.Order();
+    REQUIRE(order.size() == boxes.mins.size());
+    for (size_t i = 1; i < order.size(); i++) {
+        CHECK(boxes.mins[order[i - 1]][broadphase.Axis()] <= boxes.mins[order[i]][broadphase.Axis()]);
+    }
+}
+
+TEST_CASE("Broadphase") {
+    SECTION("Matches Brute Force") {
+        std::mt19937 rng{32};
+        // Negative coordinates, so the radix sort sees both signs
+        Boxes boxes = RandomBoxes(3000, {100.0f, 40.0f, 60.0f, 0.0f}, 4.0f, rng);
+        for (Vec4 &min: boxes.mins) min = min - Vec4{50.0f, 20.0f, 30.0f, 0.0f};
+        for (Vec4 &max: boxes.maxs) max = max - Vec4{50.0f, 20.0f, 30.0f, 0.0f};
+
+        Broadphase broadphase;
+        broadphase.Update(boxes.mins.data(), boxes.maxs.data(), boxes.mins.size());
+        CHECK(broadphase.Axis() == 0);
+        CheckOrder(broadphase, boxes);
+        const std::vector<uint64_t> expected = BruteForce(boxes);
+        CHECK(expected.size() > 100);
+        CHECK(Sorted(broadphase.Pairs()) == expected);
+    }
+
+    SECTION("Largest Variance Axis") {
+        std::mt19937 rng{33};
+        const Boxes boxes = RandomBoxes(500, {10.0f, 10.0f, 200.0f, 0.0f}, 2.0f, rng);
+        Broadphase broadphase;
+        broadphase.Update(boxes.mins.data(), boxes.maxs.data(), boxes.mins.size());
+        CHECK(broadphase.Axis() == 2);
+        CheckOrder(broadphase, boxes);
+        CHECK(Sorted(broadphase.Pairs()) == BruteForce(boxes));
+    }
+
+    SECTION("Touching And Degenerate") {
+        const Vec4 mins[4]{{0, 0, 0, 1}, {1, 0, 0, 1}, {2.5f, 0, 0, 1}, {2.5f, 0, 0, 1}};
+        const Vec4 maxs[4]{{1, 1, 1, 1}, {2, 1, 1, 1}, {2.5f, 0, 0, 1}, {2.5f, 0, 0, 1}};
+        Broadphase broadphase;
+        broadphase.Update(mins, maxs, 4);
+        const std::vector<uint64_t> pairs = Sorted(broadphase.Pairs());
+        REQUIRE(pairs.size() == 2);
+        CHECK(pairs[0] == (0ull << 32 | 1));
+        CHECK(pairs[1] == (2ull << 32 | 3));
+
+        broadphase.Update(mins, maxs, 0);
+        CHECK(broadphase.Pairs().empty());
+    }
+
+    SECTION("Infinite And Huge") {
+        // A box reaching to +infinity overlaps the padding after the sorted bounds too
+        std::mt19937 rng{36};
+        Boxes boxes = RandomBoxes(13, {10.0f, 10.0f, 10.0f, 0.0f}, 2.0f, rng);
+        boxes.maxs[4] = Vec4{std::numeric_limits<float>::infinity()};
+        boxes.mins[7] = Vec4{-std::numeric_limits<float>::max()};
+        boxes.maxs[7] = Vec4{std::numeric_limits<float>::max()};
+        for (const size_t count: {size_t{13}, size_t{9}, size_t{5}}) {
+            Broadphase broadphase;
+            broadphase.Update(boxes.mins.data(), boxes.maxs.data(), count);
+            Boxes prefix{{boxes.mins.begin(), boxes.mins.begin() + count}, {boxes.maxs.begin(), boxes.maxs.begin() + count}};
+            const std::vector<uint64_t> pairs = Sorted(broadphase.Pairs());
+            for (const uint64_t pair: pairs) CHECK((pair & 0xFFFFFFFF) < count);
+            CHECK(pairs == BruteForce(prefix));
+        }
+    }
+
+    SECTION("Incremental") {
+        std::mt19937 rng{34};
+        std::uniform_real_distribution<float> jitter(-0.2f, 0.2f);
+        Boxes boxes = RandomBoxes(2000, {80.0f, 20.0f, 20.0f, 0.0f}, 3.0f, rng);
+
+        Broadphase broadphase;
+        broadphase.Update(boxes.mins.data(), boxes.maxs.data(), boxes.mins.size());
+        for (int frame = 0; frame < 10; frame++) {
+            for (size_t i = 0; i < boxes.mins.size(); i++) {
+                const Vec4 offset{jitter(rng), jitter(rng), jitter(rng), 0.0f};
+                boxes.mins[i] = boxes.mins[i] + offset;
+                boxes.maxs[i] = boxes.maxs[i] + offset;
+            }
+            broadphase.Update(boxes.mins.data(), boxes.maxs.data(), boxes.mins.size(), true);
+            CheckOrder(broadphase, boxes);
+            CHECK(Sorted(broadphase.Pairs()) == BruteForce(boxes));
+        }
+    }
+
+    SECTION("Parallel") {
+        // Enough boxes for several ranges
+        std::mt19937 rng{35};
+        const Boxes boxes = RandomBoxes(PARALLEL_THRESHOLD * 4, {300.0f, 300.0f, 300.0f, 0.0f}, 3.0f, rng);
+        Broadphase broadphase;
+        broadphase.Update(boxes.mins.data(), boxes.maxs.data(), boxes.mins.size());
+        CheckOrder(broadphase, boxes);
+        CHECK(Sorted(broadphase.Pairs()) == ScalarSweep(boxes, broadphase.Axis()));
+    }
+}
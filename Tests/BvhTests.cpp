@@ -0,0 +1,167 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <vector>
+
+#include "Bvh.h"
+#include "TestUtils.h"
+
+static std::vector<AABB> RandomBoxes(size_t count, std::mt19937 &rng) {
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> extent(0.01f, 2.0f);
+    std::vector<AABB> boxes(count);
+    for (AABB &box: boxes) {
+        box.min = Vec4{position(rng), position(rng), position(rng), 1.0f};
+        box.max = box.min + Vec4{extent(rng), extent(rng), extent(rng), 0.0f};
+    }
+    return boxes;
+}
+
+static std::vector<Ray> RandomRays(size_t count, std::mt19937 &rng) {
+    std::uniform_real_distribution<float> position(-120.0f, 120.0f);
+    std::uniform_real_distribution<float> direction(-1.0f, 1.0f);
+    std::vector<Ray> rays(count);
+    for (Ray &ray: rays) {
+        ray = Ray{{position(rng), position(rng), position(rng), 1.0f},
+                  Vec4{direction(rng), direction(rng), direction(rng), 0.0f}.Normalize()};
+    }
+    return rays;
+}
+
+static BvhHit BruteForce(const Ray &ray, const std::vector<AABB> &boxes) {
+    BvhHit hit;
+    for (size_t i = 0; i < boxes.size(); i++) {
+        float t;
+        if (Intersect(ray, boxes[i], t) && t < hit.t) hit = {t, static_cast<uint32_t>(i)};
+    }
+    return hit;
+}
+
+template<int Width>
+static void CheckQueries(const Bvh<Width> &bvh, const std::vector<AABB> &boxes, const std::vector<Ray> &rays) {
+    const auto intersectLeaf = [&](const Ray &ray, uint32_t first, uint32_t count, BvhHit &hit) {
+        bool found = false;
+        for (uint32_t i = first; i < first + count; i++) {
+            const uint32_t primitive = bvh.Indices()[i];
+            float t;
+            if (Intersect(ray, boxes[primitive], t) && t < ray.tMax && t < hit.t) {
+                hit = {t, primitive};
+                found = true;
+            }
+        }
+        return found;
+    };
+
+    for (const Ray &ray: rays) {
+        const BvhHit expected = BruteForce(ray, boxes);
+        BvhHit hit;
+        const bool found = bvh.ClosestHit(ray, intersectLeaf, hit);
+        CHECK(found == (expected.primitive != UINT32_MAX));
+        CHECK(bvh.AnyHit(ray, intersectLeaf) == found);
+        if (found) CHECK_THAT(hit.t, WithinAbs(expected.t, 1e-4));
+    }
+}
+
+template<int Width>
+static void CheckLeafSizes(const Bvh<Width> &bvh, uint32_t maxLeafSize) {
+    for (const auto &node: bvh.Nodes()) {
+        for (int lane = 0; lane < Width; lane++) {
+            if (node.children[lane] != Bvh<Width>::EMPTY) CHECK(node.counts[lane] <= maxLeafSize);
+        }
+    }
+}
+
+template<int Width>
+static void CheckStructure(const Bvh<Width> &bvh, size_t primitiveCount) {
+    // Every primitive is referenced by exactly one leaf, children come after their parents
+    std::vector<int> references(primitiveCount, 0);
+    const auto &nodes = bvh.Nodes();
+    for (size_t i = 0; i < nodes.size(); i++) {
+        for (int lane = 0; lane < Width; lane++) {
+            if (nodes[i].children[lane] == Bvh<Width>::EMPTY) continue;
+            if (nodes[i].counts[lane]) {
+                for (uint32_t j = 0; j < nodes[i].counts[lane]; j++) references[bvh.Indices()[nodes[i].children[lane] + j]]++;
+            } else {
+                CHECK(nodes[i].children[lane] > i);
+            }
+        }
+    }
+    for (const int count: references) CHECK(count == 1);
+}
+
+TEST_CASE("Bvh Queries") {
+    std::mt19937 rng{1};
+    for (const size_t count: {1, 2, 7, 100, 5000}) {
+        const std::vector<AABB> boxes = RandomBoxes(count, rng);
+        const std::vector<Ray> rays = RandomRays(200, rng);
+
+        const Bvh<4> bvh4{boxes.data(), boxes.size()};
+        const Bvh<8> bvh8{boxes.data(), boxes.size()};
+        CheckStructure(bvh4, count);
+        CheckStructure(bvh8, count);
+        CheckQueries(bvh4, boxes, rays);
+        CheckQueries(bvh8, boxes, rays);
+    }
+}
+
+TEST_CASE("Bvh Parallel Build") {
+    // Large enough for parallel binning and subtree builds
+    std::mt19937 rng{2};
+    const std::vector<AABB> boxes = RandomBoxes(100000, rng);
+    const std::vector<Ray> rays = RandomRays(100, rng);
+
+    const Bvh<8> bvh{boxes.data(), boxes.size()};
+    CheckStructure(bvh, boxes.size());
+    CheckQueries(bvh, boxes, rays);
+}
+
+TEST_CASE("Bvh Degenerate Input") {
+    // Identical boxes can't be split by the surface area heuristic
+    const std::vector<AABB> boxes(1000, AABB{{0.0f, 0.0f, 0.0f, 1.0f}, {1.0f, 1.0f, 1.0f, 1.0f}});
+    const Bvh<4> bvh{boxes.data(), boxes.size()};
+    CheckStructure(bvh, boxes.size());
+
+    std::mt19937 rng{3};
+    CheckQueries(bvh, boxes, RandomRays(50, rng));
+
+    // Points on a line have no surface area at all, large enough to build in parallel
+    std::vector<AABB> points(50000);
+    for (size_t i = 0; i < points.size(); i++) {
+        const Vec4 p{static_cast<float>(i % 100) - 50.0f, 0.0f, 0.0f, 1.0f};
+        points[i] = {p, p};
+    }
+    const Bvh<8> pointBvh{points.data(), points.size()};
+    CheckStructure(pointBvh, points.size());
+    CheckLeafSizes(pointBvh, 4);
+
+    // Identical points, only median splits bring the leaves down to the maximum size
+    const Vec4 p{1.0f, 2.0f, 3.0f, 1.0f};
+    const std::vector<AABB> same(100, AABB{p, p});
+    const Bvh<4> sameBvh{same.data(), same.size(), 2};
+    CheckStructure(sameBvh, same.size());
+    CheckLeafSizes(sameBvh, 2);
+}
+
+TEST_CASE("Bvh Refit") {
+    std::mt19937 rng{4};
+    std::vector<AABB> boxes = RandomBoxes(3000, rng);
+    const std::vector<Ray> rays = RandomRays(200, rng);
+
+    Bvh<4> bvh4{boxes.data(), boxes.size()};
+    Bvh<8> bvh8{boxes.data(), boxes.size()};
+
+    // Animate: move every box, the tree stays valid but gets looser
+    std::uniform_real_distribution<float> offset(-10.0f, 10.0f);
+    for (AABB &box: boxes) {
+        const Vec4 delta{offset(rng), offset(rng), offset(rng), 0.0f};
+        box.min = box.min + delta;
+        box.max = box.max + delta;
+    }
+    bvh4.Refit(boxes.data());
+    bvh8.Refit(boxes.data());
+    CheckQueries(bvh4, boxes, rays);
+    CheckQueries(bvh8, boxes, rays);
+}
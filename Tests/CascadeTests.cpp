@@ -0,0 +1,130 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "Cascades.h"
+#include "TestUtils.h"
+
+using Catch::Matchers::WithinRel;
+
+static const CascadeCamera CAMERA{{1.0f, 2.0f, 3.0f, 1.0f},
+                                  {0.0f, 0.0f, 0.0f, 1.0f},
+                                  {0.0f, 1.0f, 0.0f, 0.0f},
+                                  M_PI / 3.0f,
+                                  16.0f / 9.0f,
+                                  0.1f,
+                                  100.0f};
+
+TEST_CASE("Splits") {
+    float splits[5];
+
+    Cascades::ComputeSplits(4, 1.0f, 81.0f, 0.0f, splits);
+    CHECK_THAT(splits[0], WithinRel(1.0f));
+    CHECK_THAT(splits[1], WithinRel(21.0f));
+    CHECK_THAT(splits[2], WithinRel(41.0f));
+    CHECK_THAT(splits[3], WithinRel(61.0f));
+    CHECK_THAT(splits[4], WithinRel(81.0f));
+
+    Cascades::ComputeSplits(4, 1.0f, 81.0f, 1.0f, splits);
+    CHECK_THAT(splits[0], WithinRel(1.0f));
+    CHECK_THAT(splits[1], WithinRel(3.0f));
+    CHECK_THAT(splits[2], WithinRel(9.0f));
+    CHECK_THAT(splits[3], WithinRel(27.0f));
+    CHECK_THAT(splits[4], WithinRel(81.0f));
+
+    Cascades::ComputeSplits(4, 1.0f, 81.0f, 0.5f, splits);
+    CHECK_THAT(splits[1], WithinRel(12.0f));
+    CHECK_THAT(splits[2], WithinRel(25.0f));
+    CHECK_THAT(splits[3], WithinRel(44.0f));
+}
+
+TEST_CASE("Slice Corners") {
+    const Mat4 viewProjection = Mat4::Perspective(CAMERA.fov, CAMERA.aspectRatio, CAMERA.near, CAMERA.far) *
+                                Mat4::LookAt(CAMERA.eye, CAMERA.target, CAMERA.up);
+
+    CascadeSlice slices[4];
+    Cascades::ComputeSlices(CAMERA, 4, 0.75f, slices);
+    CHECK_THAT(slices[0].near, WithinRel(CAMERA.near));
+    CHECK_THAT(slices[3].far, WithinRel(CAMERA.far));
+
+    for (const CascadeSlice &slice: slices) {
+        for (int i = 0; i < 8; i++) {
+            const Vec4 clip = viewProjection * slice.corners[i];
+            const Vec4 ndc = clip / Vec4{clip.w};
+            CHECK_THAT(ndc.x, WithinAbs(i & 1 ? 1.0f : -1.0f, 1e-4));
+            CHECK_THAT(ndc.y, WithinAbs(i & 2 ? 1.0f : -1.0f, 1e-4));
+            CHECK_THAT(clip.w, WithinRel(i & 4 ? slice.far : slice.near, 1e-4f));
+            CHECK(slice.corners[i].Distance(slice.center) <= slice.radius);
+        }
+    }
+}
+
+TEST_CASE("Light Fit") {
+    CascadeSlice slices[4];
+    Cascades::ComputeSlices(CAMERA, 4, 0.75f, slices);
+
+    // 5 lights to cover the tail of the batch, the last one straight down uses the other up vector
+    const Vec4 lights[5] = {{-1.0f, -2.0f, -0.5f, 0.0f},
+                            {0.3f, -1.0f, 0.8f, 0.0f},
+                            {2.0f, -0.5f, 0.0f, 0.0f},
+                            {-0.2f, -3.0f, -1.0f, 0.0f},
+                            {0.0f, -1.0f, 0.0f, 0.0f}};
+    CascadeMatrices matrices[20];
+
+    for (const CascadeFit fit: {CascadeFit::Sphere, CascadeFit::Tight}) {
+        Cascades::FitLights(slices, 4, lights, 5, fit, 2048.0f, 0.0f, matrices);
+        for (int i = 0; i < 20; i++) {
+            const CascadeSlice &slice = slices[i % 4];
+            // Same as fitting one light at a time
+            const CascadeMatrices expected = Cascades::FitLight(slice, lights[i / 4], fit, 2048.0f, 0.0f);
+            CHECK_THAT(matrices[i].view, EqualsMat4(expected.view, 1e-5f));
+            CHECK_THAT(matrices[i].projection, EqualsMat4(expected.projection, 1e-4f));
+            CHECK_THAT(matrices[i].viewProjection, EqualsMat4(expected.viewProjection, 1e-4f));
+
+            // Every corner of the slice lands inside the shadow map
+            for (const Vec4 &corner: slice.corners) {
+                const Vec4 clip = matrices[i].viewProjection * corner;
+                CHECK(std::fabs(clip.x) <= 1.0f + 1e-4f);
+                CHECK(std::fabs(clip.y) <= 1.0f + 1e-4f);
+                CHECK(std::fabs(clip.z) <= 1.0f + 1e-4f);
+            }
+
+            // The whole bounding sphere too, on the far edges as well after snapping
+            if (fit == CascadeFit::Sphere) {
+                const Vec4 center = matrices[i].view * slice.center;
+                const float scaleX = matrices[i].projection.c0.x;
+                const float scaleY = matrices[i].projection.c1.y;
+                const float offsetX = matrices[i].projection.c3.x;
+                const float offsetY = matrices[i].projection.c3.y;
+                CHECK((center.x - slice.radius) * scaleX + offsetX >= -1.0f - 1e-5f);
+                CHECK((center.x + slice.radius) * scaleX + offsetX <= 1.0f + 1e-5f);
+                CHECK((center.y - slice.radius) * scaleY + offsetY >= -1.0f - 1e-5f);
+                CHECK((center.y + slice.radius) * scaleY + offsetY <= 1.0f + 1e-5f);
+            }
+        }
+    }
+
+    // Small camera moves keep the texel grid where it was, the projection only shifts by whole texels
+    for (const float offset: {0.001f, 0.05f, 0.3f}) {
+        CascadeCamera moved = CAMERA;
+        moved.eye = moved.eye + Vec4{offset, 0.0f, -offset * 0.5f, 0.0f};
+        moved.target = moved.target + Vec4{offset, 0.0f, -offset * 0.5f, 0.0f};
+        CascadeSlice movedSlices[4];
+        Cascades::ComputeSlices(moved, 4, 0.75f, movedSlices);
+
+        for (int i = 0; i < 4; i++) {
+            const CascadeMatrices a = Cascades::FitLight(slices[i], lights[0], CascadeFit::Sphere, 2048.0f, 0.0f);
+            const CascadeMatrices b = Cascades::FitLight(movedSlices[i], lights[0], CascadeFit::Sphere, 2048.0f, 0.0f);
+            REQUIRE(movedSlices[i].radius == slices[i].radius);
+            CHECK(b.projection.c0.x == a.projection.c0.x);
+            CHECK(b.projection.c1.y == a.projection.c1.y);
+            // NDC spans 2048 texels over 2 units
+            const float texelsX = (b.projection.c3.x - a.projection.c3.x) * 2048.0f * 0.5f;
+            const float texelsY = (b.projection.c3.y - a.projection.c3.y) * 2048.0f * 0.5f;
+            CHECK_THAT(texelsX, WithinAbs(std::round(texelsX), 1e-2));
+            CHECK_THAT(texelsY, WithinAbs(std::round(texelsY), 1e-2));
+        }
+    }
+}
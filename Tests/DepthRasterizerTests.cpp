@@ -0,0 +1,94 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+#include "DepthRasterizer.h"
+#include "TestUtils.h"
+
+TEST_CASE("Depth Rasterizer") {
+    constexpr int width = 320;
+    constexpr int height = 190;
+    const Mat4 view = Mat4::LookAt({0.0f, 0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, -1.0f, 1.0f}, {0.0f, 1.0f, 0.0f, 0.0f});
+    const Mat4 projection = Mat4::Perspective(static_cast<float>(M_PI) / 3.0f, static_cast<float>(width) / height, 0.1f, 100.0f);
+    const Mat4 viewProjection = projection * view;
+
+    DepthRasterizer rasterizer{width, height};
+    REQUIRE(rasterizer.Levels().size() == 10);
+    CHECK(rasterizer.Levels()[0].width == 320);
+    CHECK(rasterizer.Levels()[0].height == 192);
+    CHECK(rasterizer.Levels().back().width == 1);
+    CHECK(rasterizer.Levels().back().height == 1);
+
+    // Nothing rendered, everything inside of the frustum is visible
+    rasterizer.Render();
+    CHECK(rasterizer.IsVisible(viewProjection, {{-1.0f, -1.0f, -30.0f, 1.0f}, {1.0f, 1.0f, -20.0f, 1.0f}}));
+
+    // A wall 10 units in front of the camera
+    const std::vector<Vec4> wall = CreateBoxPositions({-5.0f, -5.0f, -11.0f, 1.0f}, {5.0f, 5.0f, -10.0f, 1.0f});
+    rasterizer.AddOccluder(viewProjection, wall.data(), sizeof(Vec4), wall.size() / 3);
+    rasterizer.Render();
+
+    SECTION("Depth") {
+        const Vec4 clip = viewProjection * Vec4{0.0f, 0.0f, -10.0f, 1.0f};
+        const float expected = clip.z / clip.w * 0.5f + 0.5f;
+        const DepthRasterizer::Level &depth = rasterizer.Levels()[0];
+        CHECK_THAT(depth.depth[height / 2 * depth.width + width / 2], WithinAbs(expected, 1e-5));
+        // Corners of the screen see past the wall
+        CHECK(depth.depth[0] == 1.0f);
+        CHECK(depth.depth[(height - 1) * depth.width + width - 1] == 1.0f);
+    }
+
+    SECTION("Hierarchical Z") {
+        const std::vector<DepthRasterizer::Level> &levels = rasterizer.Levels();
+        for (size_t i = 1; i < levels.size(); i++) {
+            for (int y = 0; y < levels[i - 1].height; y++) {
+                for (int x = 0; x < levels[i - 1].width; x++) {
+                    CHECK(levels[i].depth[y / 2 * levels[i].width + x / 2] >= levels[i - 1].depth[y * levels[i - 1].width + x]);
+                }
+            }
+        }
+        CHECK(levels.back().depth[0] == 1.0f);
+    }
+
+    SECTION("Occlusion") {
+        // Behind the wall
+        CHECK_FALSE(rasterizer.IsVisible(viewProjection, {{-1.0f, -1.0f, -30.0f, 1.0f}, {1.0f, 1.0f, -20.0f, 1.0f}}));
+        CHECK_FALSE(rasterizer.IsVisible(viewProjection, {{-4.0f, -4.0f, -12.0f, 1.0f}, {4.0f, 4.0f, -11.5f, 1.0f}}));
+        // In front of the wall
+        CHECK(rasterizer.IsVisible(viewProjection, {{-1.0f, -1.0f, -8.0f, 1.0f}, {1.0f, 1.0f, -6.0f, 1.0f}}));
+        // Behind the wall but reaching past its edge
+        CHECK(rasterizer.IsVisible(viewProjection, {{4.0f, -1.0f, -30.0f, 1.0f}, {12.0f, 1.0f, -20.0f, 1.0f}}));
+        // Crossing the near plane
+        CHECK(rasterizer.IsVisible(viewProjection, {{-1.0f, -1.0f, -1.0f, 1.0f}, {1.0f, 1.0f, 1.0f, 1.0f}}));
+        // Outside of the frustum
+        CHECK_FALSE(rasterizer.IsVisible(viewProjection, {{-1.0f, -1.0f, 5.0f, 1.0f}, {1.0f, 1.0f, 6.0f, 1.0f}}));
+        CHECK_FALSE(rasterizer.IsVisible(viewProjection, {{100.0f, -1.0f, -20.0f, 1.0f}, {101.0f, 1.0f, -19.0f, 1.0f}}));
+        CHECK_FALSE(rasterizer.IsVisible(viewProjection, {{-1.0f, -1.0f, -300.0f, 1.0f}, {1.0f, 1.0f, -200.0f, 1.0f}}));
+    }
+
+    SECTION("Batch") {
+        std::vector<AABB> boxes;
+        for (int i = 0; i < 200; i++) {
+            const auto f = static_cast<float>(i);
+            const Vec4 center{std::sin(f) * 15.0f, std::cos(f * 1.3f) * 8.0f, -5.0f - f * 0.2f, 1.0f};
+            boxes.push_back({center - Vec4{0.5f, 0.5f, 0.5f, 0.0f}, center + Vec4{0.5f, 0.5f, 0.5f, 0.0f}});
+        }
+        std::vector<uint8_t> visible(boxes.size());
+        rasterizer.TestVisibility(viewProjection, boxes.data(), boxes.size(), visible.data());
+        int occluded = 0;
+        for (size_t i = 0; i < boxes.size(); i++) {
+            CHECK(visible[i] == rasterizer.IsVisible(viewProjection, boxes[i]));
+            occluded += !visible[i];
+        }
+        CHECK(occluded > 10);
+    }
+
+    SECTION("Clear") {
+        rasterizer.Clear();
+        rasterizer.Render();
+        CHECK(rasterizer.IsVisible(viewProjection, {{-1.0f, -1.0f, -30.0f, 1.0f}, {1.0f, 1.0f, -20.0f, 1.0f}}));
+    }
+}
@@ -0,0 +1,535 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#include <catch2/catch_get_random_seed.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <glm/geometric.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/matrix.hpp>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Parallel.h"
+#include "PlainMath.h"
+#include "Quat.h"
+#include "TestUtils.h"
+
+// Differential fuzzing: every operation runs on the same random inputs through SimdMath, PlainMath and glm
+// Results have to agree within a tolerance scaled by the magnitude of the terms summed for each output
+// Input i of an operation only depends on the seed, the operation and i, so serial and parallel runs find the same failures
+
+// How the inputs of an operation are drawn, per group of 4 floats
+enum class FuzzDomain {
+    // Mix of unit range, wide magnitudes, integers, special values and denormals per component
+    General,
+    // General without zeros and denormals, for divisors
+    NonZero,
+    // Vectors with one magnitude in [1e-15, 1e15], their squared length stays a normal float
+    Scaled,
+    // Unit quaternions, sometimes exact ones or slightly off unit length
+    Quat
+};
+
+using FuzzKernel = void (*)(const float *in, float *out);
+// Magnitude of the terms each output is computed from, the error of a sum of products is proportional to it
+using FuzzScale = void (*)(const float *in, double *scale);
+
+struct FuzzOperation {
+    const char *name;
+    FuzzDomain domain;
+    int inputCount;
+    int outputCount;
+    FuzzKernel simd;
+    FuzzKernel plain;
+    FuzzKernel glm;
+    FuzzScale scale;
+    // Allowed difference in FLT_EPSILON times the scale
+    double tolerance;
+};
+
+static constexpr int FUZZ_MAX_INPUTS = 32;
+static constexpr int FUZZ_MAX_OUTPUTS = 16;
+
+// splitmix64, cheap to seed for every input
+struct FuzzRandom {
+    uint64_t state;
+
+    uint64_t Next() {
+        uint64_t z = state += 0x9E3779B97F4A7C15;
+        z = (z ^ z >> 30) * 0xBF58476D1CE4E5B9;
+        z = (z ^ z >> 27) * 0x94D049BB133111EB;
+        return z ^ z >> 31;
+    }
+
+    // [0, 1)
+    double Uniform() { return static_cast<double>(Next() >> 11) * 0x1.0p-53; }
+
+    double Uniform(double low, double high) { return low + (high - low) * Uniform(); }
+
+    float Sign() { return Next() & 1 ? 1.0f : -1.0f; }
+
+    float LogUniform(double low, double high) {
+        return Sign() * static_cast<float>(std::exp(Uniform(std::log(low), std::log(high))));
+    }
+};
+
+static float FuzzComponent(FuzzRandom &random) {
+    static const float specials[] = {0.0f, -0.0f, 1.0f, -1.0f, 0.5f, -0.5f, 2.0f};
+    const double bucket = random.Uniform();
+    if (bucket < 0.3) return static_cast<float>(random.Uniform(-1.0, 1.0));
+    if (bucket < 0.5) return random.LogUniform(1e-4, 1e4);
+    if (bucket < 0.6) return static_cast<float>(static_cast<int>(random.Next() % 17) - 8);
+    if (bucket < 0.7) return specials[random.Next() % std::size(specials)];
+    if (bucket < 0.85) return random.LogUniform(1e-18, 1e18);
+    // Cancellation next to 1
+    if (bucket < 0.95) return random.Sign() * (1.0f + static_cast<float>(static_cast<int>(random.Next() % 9) - 4) * FLT_EPSILON);
+    return random.LogUniform(1e-44, 1e-38);
+}
+
+static void FuzzGroup(FuzzDomain domain, FuzzRandom &random, float *out) {
+    switch (domain) {
+        case FuzzDomain::General:
+            for (int i = 0; i < 4; i++) out[i] = FuzzComponent(random);
+            break;
+        case FuzzDomain::NonZero:
+            for (int i = 0; i < 4; i++) {
+                do {
+                    out[i] = FuzzComponent(random);
+                } while (std::abs(out[i]) < FLT_MIN);
+            }
+            break;
+        case FuzzDomain::Scaled: {
+            const float scale = std::abs(random.LogUniform(1e-15, 1e15));
+            for (int i = 0; i < 4; i++) out[i] = random.Uniform() < 0.15 ? 0.0f : static_cast<float>(random.Uniform(-1.0, 1.0)) * scale;
+            if (out[0] == 0.0f && out[1] == 0.0f && out[2] == 0.0f && out[3] == 0.0f) out[0] = scale;
+            break;
+        }
+        case FuzzDomain::Quat: {
+            const double bucket = random.Uniform();
+            if (bucket < 0.1) {
+                // Identity, half turns and quarter turns around the axes
+                static const float values[] = {0.0f, 1.0f, -1.0f, 0.70710678f, -0.70710678f};
+                for (int i = 0; i < 4; i++) out[i] = values[random.Next() % std::size(values)];
+                break;
+            }
+            double q[4], lengthSqr = 0.0;
+            for (double &v: q) {
+                v = random.Uniform(-1.0, 1.0);
+                lengthSqr += v * v;
+            }
+            const double length = std::sqrt(lengthSqr) * (bucket < 0.2 ? random.Uniform(0.99, 1.01) : 1.0);
+            for (int i = 0; i < 4; i++) out[i] = static_cast<float>(q[i] / length);
+            break;
+        }
+    }
+}
+
+static void FuzzInputs(const FuzzOperation &op, uint64_t seed, size_t operation, size_t index, float *in) {
+    FuzzRandom random{seed ^ operation << 48 ^ index * 0xD1B54A32D192ED03};
+    random.Next();
+    for (int i = 0; i < op.inputCount; i += 4) FuzzGroup(op.domain, random, in + i);
+}
+
+// Loading and storing in the memory layout of every library: x y z w, column major
+
+static Vec4 LoadVec4(const float *in) { return Vec4{in[0], in[1], in[2], in[3]}; }
+
+static Mat4 LoadMat4(const float *in) { return Mat4{LoadVec4(in), LoadVec4(in + 4), LoadVec4(in + 8), LoadVec4(in + 12)}; }
+
+static Quat LoadQuat(const float *in) { return Quat{in[0], in[1], in[2], in[3]}; }
+
+static void Store(const Vec4 &v, float *out) { memcpy(out, &v, sizeof(float) * 4); }
+
+static void Store(const Mat4 &m, float *out) { memcpy(out, &m, sizeof(float) * 16); }
+
+static void Store(const Quat &q, float *out) { memcpy(out, &q, sizeof(float) * 4); }
+
+static PlainVec LoadPlainVec(const float *in) { return {in[0], in[1], in[2], in[3]}; }
+
+static PlainMat LoadPlainMat(const float *in) { return {LoadPlainVec(in), LoadPlainVec(in + 4), LoadPlainVec(in + 8), LoadPlainVec(in + 12)}; }
+
+static PlainQuat LoadPlainQuat(const float *in) { return {in[0], in[1], in[2], in[3]}; }
+
+static void Store(const PlainVec &v, float *out) { memcpy(out, &v, sizeof(float) * 4); }
+
+static void Store(const PlainMat &m, float *out) { memcpy(out, &m, sizeof(float) * 16); }
+
+static void Store(const PlainQuat &q, float *out) { memcpy(out, &q, sizeof(float) * 4); }
+
+static glm::vec4 LoadGlmVec4(const float *in) { return {in[0], in[1], in[2], in[3]}; }
+
+static glm::mat4 LoadGlmMat4(const float *in) {
+    glm::mat4 m;
+    for (int i = 0; i < 16; i++) m[i / 4][i % 4] = in[i];
+    return m;
+}
+
+static glm::quat LoadGlmQuat(const float *in) {
+    glm::quat q;
+    q.x = in[0];
+    q.y = in[1];
+    q.z = in[2];
+    q.w = in[3];
+    return q;
+}
+
+static void Store(const glm::vec4 &v, float *out) {
+    for (int i = 0; i < 4; i++) out[i] = v[i];
+}
+
+static void Store(const glm::mat4 &m, float *out) {
+    for (int i = 0; i < 16; i++) out[i] = m[i / 4][i % 4];
+}
+
+static void Store(const glm::quat &q, float *out) {
+    out[0] = q.x;
+    out[1] = q.y;
+    out[2] = q.z;
+    out[3] = q.w;
+}
+
+// Scales, in double so they don't round or overflow themselves
+
+static double Abs(const float *in, int i) { return std::abs(static_cast<double>(in[i])); }
+
+static void SumScale(const float *in, double *scale) {
+    for (int i = 0; i < 4; i++) scale[i] = Abs(in, i) + Abs(in, 4 + i);
+}
+
+static void ProductScale(const float *in, double *scale) {
+    for (int i = 0; i < 4; i++) scale[i] = Abs(in, i) * Abs(in, 4 + i);
+}
+
+static void QuotientScale(const float *in, double *scale) {
+    for (int i = 0; i < 4; i++) scale[i] = Abs(in, i) / Abs(in, 4 + i);
+}
+
+static void DotScale(const float *in, double *scale) {
+    scale[0] = 0.0;
+    for (int i = 0; i < 4; i++) scale[0] += Abs(in, i) * Abs(in, 4 + i);
+}
+
+static void LengthScale(const float *in, double *scale) {
+    scale[0] = 0.0;
+    for (int i = 0; i < 4; i++) scale[0] += Abs(in, i) * Abs(in, i);
+    scale[0] = std::sqrt(scale[0]);
+}
+
+static void DistanceScale(const float *in, double *scale) {
+    scale[0] = 0.0;
+    for (int i = 0; i < 4; i++) scale[0] += (Abs(in, i) + Abs(in, 4 + i)) * (Abs(in, i) + Abs(in, 4 + i));
+    scale[0] = std::sqrt(scale[0]);
+}
+
+static void UnitScale(const float *, double *scale) {
+    for (int i = 0; i < 4; i++) scale[i] = 1.0;
+}
+
+static void CrossScale(const float *in, double *scale) {
+    scale[0] = Abs(in, 1) * Abs(in, 6) + Abs(in, 2) * Abs(in, 5);
+    scale[1] = Abs(in, 2) * Abs(in, 4) + Abs(in, 0) * Abs(in, 6);
+    scale[2] = Abs(in, 0) * Abs(in, 5) + Abs(in, 1) * Abs(in, 4);
+    scale[3] = Abs(in, 3) * Abs(in, 7);
+}
+
+// Column major matrix in[0..15] times vector in[vector..vector + 3], all absolute
+static void MatVecScale(const float *in, int vector, double *scale) {
+    for (int row = 0; row < 4; row++) {
+        scale[row] = 0.0;
+        for (int k = 0; k < 4; k++) scale[row] += Abs(in, k * 4 + row) * Abs(in, vector + k);
+    }
+}
+
+static void MatVecScale(const float *in, double *scale) { MatVecScale(in, 16, scale); }
+
+static void VecMatScale(const float *in, double *scale) {
+    for (int column = 0; column < 4; column++) {
+        scale[column] = 0.0;
+        for (int k = 0; k < 4; k++) scale[column] += Abs(in, k) * Abs(in, 4 + column * 4 + k);
+    }
+}
+
+static void MatMatScale(const float *in, double *scale) {
+    for (int column = 0; column < 4; column++) MatVecScale(in, 16 + column * 4, scale + column * 4);
+}
+
+static void TransposeScale(const float *in, double *scale) {
+    for (int i = 0; i < 16; i++) scale[i] = Abs(in, i % 4 * 4 + i / 4);
+}
+
+static void QuatProductScale(const float *in, double *scale) {
+    double sum = 0.0;
+    for (int i = 0; i < 4; i++) sum += Abs(in, i);
+    double other = 0.0;
+    for (int i = 0; i < 4; i++) other += Abs(in, 4 + i);
+    for (int i = 0; i < 4; i++) scale[i] = sum * other;
+}
+
+static void QuatToMat4Scale(const float *in, double *scale) {
+    double lengthSqr = 0.0;
+    for (int i = 0; i < 4; i++) lengthSqr += Abs(in, i) * Abs(in, i);
+    for (int i = 0; i < 16; i++) scale[i] = 1.0 + 2.0 * lengthSqr;
+}
+
+static const FuzzOperation FUZZ_OPERATIONS[] = {
+        {"Vec4 + Vec4", FuzzDomain::General, 8, 4,
+                [](const float *in, float *out) { Store(LoadVec4(in) + LoadVec4(in + 4), out); },
+                [](const float *in, float *out) { Store(LoadPlainVec(in) + LoadPlainVec(in + 4), out); },
+                [](const float *in, float *out) { Store(LoadGlmVec4(in) + LoadGlmVec4(in + 4), out); },
+                SumScale, 1.0},
+        {"Vec4 - Vec4", FuzzDomain::General, 8, 4,
+                [](const float *in, float *out) { Store(LoadVec4(in) - LoadVec4(in + 4), out); },
+                [](const float *in, float *out) { Store(LoadPlainVec(in) - LoadPlainVec(in + 4), out); },
+                [](const float *in, float *out) { Store(LoadGlmVec4(in) - LoadGlmVec4(in + 4), out); },
+                SumScale, 1.0},
+        {"Vec4 * Vec4", FuzzDomain::General, 8, 4,
+                [](const float *in, float *out) { Store(LoadVec4(in) * LoadVec4(in + 4), out); },
+                [](const float *in, float *out) { Store(LoadPlainVec(in) * LoadPlainVec(in + 4), out); },
+                [](const float *in, float *out) { Store(LoadGlmVec4(in) * LoadGlmVec4(in + 4), out); },
+                ProductScale, 1.0},
+        {"Vec4 / Vec4", FuzzDomain::NonZero, 8, 4,
+                [](const float *in, float *out) { Store(LoadVec4(in) / LoadVec4(in + 4), out); },
+                [](const float *in, float *out) { Store(LoadPlainVec(in) / LoadPlainVec(in + 4), out); },
+                [](const float *in, float *out) { Store(LoadGlmVec4(in) / LoadGlmVec4(in + 4), out); },
+                QuotientScale, 1.0},
+        {"Vec4::Dot", FuzzDomain::General, 8, 1,
+                [](const float *in, float *out) { out[0] = LoadVec4(in).Dot(LoadVec4(in + 4)); },
+                [](const float *in, float *out) { out[0] = LoadPlainVec(in).Dot(LoadPlainVec(in + 4)); },
+                [](const float *in, float *out) { out[0] = glm::dot(LoadGlmVec4(in), LoadGlmVec4(in + 4)); },
+                DotScale, 4.0},
+        {"Vec4::Length", FuzzDomain::Scaled, 4, 1,
+                [](const float *in, float *out) { out[0] = LoadVec4(in).Length(); },
+                [](const float *in, float *out) { out[0] = LoadPlainVec(in).Length(); },
+                [](const float *in, float *out) { out[0] = glm::length(LoadGlmVec4(in)); },
+                LengthScale, 4.0},
+        {"Vec4::Distance", FuzzDomain::Scaled, 8, 1,
+                [](const float *in, float *out) { out[0] = LoadVec4(in).Distance(LoadVec4(in + 4)); },
+                [](const float *in, float *out) { out[0] = (LoadPlainVec(in) - LoadPlainVec(in + 4)).Length(); },
+                [](const float *in, float *out) { out[0] = glm::distance(LoadGlmVec4(in), LoadGlmVec4(in + 4)); },
+                DistanceScale, 4.0},
+        {"Vec4::Normalize", FuzzDomain::Scaled, 4, 4,
+                [](const float *in, float *out) { Store(LoadVec4(in).Normalize(), out); },
+                [](const float *in, float *out) { Store(LoadPlainVec(in).Normalize(), out); },
+                [](const float *in, float *out) { Store(glm::normalize(LoadGlmVec4(in)), out); },
+                UnitScale, 4.0},
+        {"Vec4::Cross", FuzzDomain::General, 8, 4,
+                [](const float *in, float *out) { Store(LoadVec4(in).Cross(LoadVec4(in + 4)), out); },
+                [](const float *in, float *out) { Store(LoadPlainVec(in).Cross(LoadPlainVec(in + 4)), out); },
+                [](const float *in, float *out) {
+                    const glm::vec3 cross = glm::cross(glm::vec3{in[0], in[1], in[2]}, glm::vec3{in[4], in[5], in[6]});
+                    Store(glm::vec4{cross.x, cross.y, cross.z, 0.0f}, out);
+                },
+                CrossScale, 2.0},
+        {"Mat4 * Vec4", FuzzDomain::General, 20, 4,
+                [](const float *in, float *out) { Store(LoadMat4(in) * LoadVec4(in + 16), out); },
+                [](const float *in, float *out) { Store(LoadPlainMat(in) * LoadPlainVec(in + 16), out); },
+                [](const float *in, float *out) { Store(LoadGlmMat4(in) * LoadGlmVec4(in + 16), out); },
+                MatVecScale, 4.0},
+        {"Vec4 * Mat4", FuzzDomain::General, 20, 4,
+                [](const float *in, float *out) { Store(LoadVec4(in) * LoadMat4(in + 4), out); },
+                [](const float *in, float *out) {
+                    const PlainVec v = LoadPlainVec(in);
+                    const PlainMat m = LoadPlainMat(in + 4);
+                    Store(PlainVec{v.Dot(m.c0), v.Dot(m.c1), v.Dot(m.c2), v.Dot(m.c3)}, out);
+                },
+                [](const float *in, float *out) { Store(LoadGlmVec4(in) * LoadGlmMat4(in + 4), out); },
+                VecMatScale, 4.0},
+        {"Mat4 * Mat4", FuzzDomain::General, 32, 16,
+                [](const float *in, float *out) { Store(LoadMat4(in) * LoadMat4(in + 16), out); },
+                [](const float *in, float *out) { Store(LoadPlainMat(in) * LoadPlainMat(in + 16), out); },
+                [](const float *in, float *out) { Store(LoadGlmMat4(in) * LoadGlmMat4(in + 16), out); },
+                MatMatScale, 4.0},
+        {"Mat4::Transpose", FuzzDomain::General, 16, 16,
+                [](const float *in, float *out) { Store(LoadMat4(in).Transpose(), out); },
+                [](const float *in, float *out) { Store(LoadPlainMat(in).Transpose(), out); },
+                [](const float *in, float *out) { Store(glm::transpose(LoadGlmMat4(in)), out); },
+                TransposeScale, 0.0},
+        {"Quat * Quat", FuzzDomain::Quat, 8, 4,
+                [](const float *in, float *out) { Store(LoadQuat(in) * LoadQuat(in + 4), out); },
+                [](const float *in, float *out) { Store(LoadPlainQuat(in) * LoadPlainQuat(in + 4), out); },
+                [](const float *in, float *out) { Store(LoadGlmQuat(in) * LoadGlmQuat(in + 4), out); },
+                QuatProductScale, 4.0},
+        {"Quat::ToMat4", FuzzDomain::Quat, 4, 16,
+                [](const float *in, float *out) { Store(LoadQuat(in).ToMat4(), out); },
+                [](const float *in, float *out) { Store(LoadPlainQuat(in).ToMat4(), out); },
+                [](const float *in, float *out) { Store(glm::mat4_cast(LoadGlmQuat(in)), out); },
+                QuatToMat4Scale, 4.0},
+};
+
+static constexpr size_t FUZZ_OPERATION_COUNT = std::size(FUZZ_OPERATIONS);
+
+enum FuzzLibrary {
+    Simd,
+    Plain,
+    Glm,
+    LIBRARY_COUNT
+};
+
+struct FuzzEvaluation {
+    float outputs[LIBRARY_COUNT][FUZZ_MAX_OUTPUTS];
+    double scale[FUZZ_MAX_OUTPUTS];
+};
+
+static void Evaluate(const FuzzOperation &op, const float *in, FuzzEvaluation &evaluation) {
+    op.simd(in, evaluation.outputs[Simd]);
+    op.plain(in, evaluation.outputs[Plain]);
+    op.glm(in, evaluation.outputs[Glm]);
+    op.scale(in, evaluation.scale);
+}
+
+// NaN agrees with NaN and infinities with the same infinity, libraries have to fail the same way
+static bool Agree(float a, float b, double scale, double tolerance) {
+    if (std::isnan(a) || std::isnan(b)) return std::isnan(a) && std::isnan(b);
+    if (a == b) return true;
+    if (!std::isfinite(a) || !std::isfinite(b)) return false;
+    // Results below FLT_MIN lost their precision to gradual underflow
+    return std::abs(static_cast<double>(a) - static_cast<double>(b)) <= tolerance * FLT_EPSILON * scale + tolerance * FLT_MIN;
+}
+
+static bool Fails(const FuzzOperation &op, const float *in) {
+    FuzzEvaluation evaluation;
+    Evaluate(op, in, evaluation);
+    for (int i = 0; i < op.outputCount; i++) {
+        const float simd = evaluation.outputs[Simd][i];
+        if (!Agree(simd, evaluation.outputs[Plain][i], evaluation.scale[i], op.tolerance)) return true;
+        if (!Agree(simd, evaluation.outputs[Glm][i], evaluation.scale[i], op.tolerance)) return true;
+    }
+    return false;
+}
+
+// Lower is simpler: zero, small integers, then fewer mantissa bits and exponents closer to 0
+static int Complexity(float x) {
+    if (x == 0.0f) return 0;
+    if (x == std::trunc(x) && std::abs(x) <= 16.0f) return 1 + static_cast<int>(std::abs(x)) * 2 + (x < 0.0f);
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    const uint32_t mantissa = bits & 0x7FFFFF;
+    const int exponent = static_cast<int>(bits >> 23 & 0xFF) - 127;
+    int mantissaBits = 0;
+    for (uint32_t m = mantissa; m & 0x7FFFFF; m <<= 1) mantissaBits++;
+    return 64 + (mantissaBits + std::abs(exponent)) * 2 + (x < 0.0f);
+}
+
+// x with only the highest bits of its mantissa
+static float TruncateMantissa(float x, int bitCount) {
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    bits &= ~((1u << (23 - bitCount)) - 1);
+    memcpy(&x, &bits, sizeof(x));
+    return x;
+}
+
+// Greedily replaces inputs with simpler values while the operation keeps failing
+static void Shrink(const FuzzOperation &op, float *in) {
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (int i = 0; i < op.inputCount; i++) {
+            std::vector<float> candidates = {0.0f, 1.0f, -1.0f, std::trunc(in[i]), std::round(in[i] * 16.0f) / 16.0f, -in[i]};
+            for (int bitCount = 0; bitCount < 23; bitCount++) candidates.push_back(TruncateMantissa(in[i], bitCount));
+            for (const float candidate: candidates) {
+                if (Complexity(candidate) >= Complexity(in[i])) continue;
+                const float original = in[i];
+                in[i] = candidate;
+                if (Fails(op, in)) {
+                    changed = true;
+                    break;
+                }
+                in[i] = original;
+            }
+        }
+    }
+}
+
+struct FuzzResult {
+    size_t failures = 0;
+    // Index of the first failing input, SIZE_MAX when there was none
+    size_t firstFailure = SIZE_MAX;
+};
+
+struct alignas(64) FuzzRangeResult {
+    FuzzResult result;
+};
+
+static FuzzResult FuzzRange(const FuzzOperation &op, uint64_t seed, size_t operation, size_t begin, size_t end) {
+    FuzzResult result;
+    float in[FUZZ_MAX_INPUTS];
+    for (size_t i = begin; i < end; i++) {
+        FuzzInputs(op, seed, operation, i, in);
+        if (!Fails(op, in)) continue;
+        if (result.failures++ == 0) result.firstFailure = i;
+    }
+    return result;
+}
+
+static FuzzResult FuzzOperationInputs(const FuzzOperation &op, uint64_t seed, size_t operation, size_t count, bool parallel) {
+    if (!parallel) return FuzzRange(op, seed, operation, 0, count);
+
+    std::vector<FuzzRangeResult> ranges(ThreadCount());
+    const size_t rangeCount = ParallelFor(count, 4096, [&](size_t range, size_t begin, size_t end) {
+        ranges[range].result = FuzzRange(op, seed, operation, begin, end);
+    });
+
+    FuzzResult result;
+    for (size_t range = 0; range < rangeCount; range++) {
+        result.failures += ranges[range].result.failures;
+        result.firstFailure = std::min(result.firstFailure, ranges[range].result.firstFailure);
+    }
+    return result;
+}
+
+static void PrintFloats(std::ostream &os, const char *label, const float *values, int count) {
+    os << "  " << label << ":";
+    for (int i = 0; i < count; i++) os << " " << values[i];
+    os << "\n";
+}
+
+// The first failure of the operation, shrunk, with the output of every library
+static std::string DescribeFailure(const FuzzOperation &op, uint64_t seed, size_t operation, const FuzzResult &result) {
+    float in[FUZZ_MAX_INPUTS];
+    FuzzInputs(op, seed, operation, result.firstFailure, in);
+    std::ostringstream os;
+    os.precision(9);
+    os << op.name << ": " << result.failures << " failures, first at input " << result.firstFailure << " of seed " << seed << "\n";
+    PrintFloats(os, "input", in, op.inputCount);
+    Shrink(op, in);
+    PrintFloats(os, "shrunk", in, op.inputCount);
+    FuzzEvaluation evaluation;
+    Evaluate(op, in, evaluation);
+    PrintFloats(os, "SimdMath", evaluation.outputs[Simd], op.outputCount);
+    PrintFloats(os, "PlainMath", evaluation.outputs[Plain], op.outputCount);
+    PrintFloats(os, "glm", evaluation.outputs[Glm], op.outputCount);
+    return os.str();
+}
+
+static void Fuzz(size_t count, bool parallel) {
+    // Reproduce a failure with --rng-seed
+    const uint64_t seed = Catch::getSeed();
+    for (size_t operation = 0; operation < FUZZ_OPERATION_COUNT; operation++) {
+        const FuzzOperation &op = FUZZ_OPERATIONS[operation];
+        const FuzzResult result = FuzzOperationInputs(op, seed, operation, count, parallel);
+        INFO(op.name);
+        INFO((result.failures ? DescribeFailure(op, seed, operation, result) : std::string{}));
+        CHECK(result.failures == 0);
+    }
+}
+
+TEST_CASE("Differential Fuzzing") {
+    Fuzz(1 << 18, true);
+}
+
+// Hidden, run with: FuzzTests [fuzz]
+TEST_CASE("Differential Fuzzing Large", "[.][fuzz]") {
+    Fuzz(1 << 24, true);
+}
+
+// Hidden, the same inputs as the default case on one thread, for debuggers
+TEST_CASE("Differential Fuzzing Serial", "[.][fuzz]") {
+    Fuzz(1 << 18, false);
+}
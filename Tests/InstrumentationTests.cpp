@@ -0,0 +1,143 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Instrumentation.h"
+#include "Parallel.h"
+
+static Instrumentation::ProfileEntry FindEntry(const char *name) {
+    for (const Instrumentation::ProfileEntry &entry: Instrumentation::CollectProfile()) {
+        if (strcmp(entry.name, name) == 0) return entry;
+    }
+    return {name, 0, 0};
+}
+
+static volatile float g_sink;
+
+static void Work(int iterations) {
+    float sum = 0.0f;
+    for (int i = 0; i < iterations; i++) sum += static_cast<float>(i) * 0.5f;
+    g_sink = sum;
+}
+
+static void Outer() {
+    PROFILE_SCOPE("Outer");
+    Work(1000);
+    for (int i = 0; i < 3; i++) {
+        PROFILE_SCOPE("Inner");
+        Work(1000);
+    }
+}
+
+TEST_CASE("Scoped Timers") {
+    const Instrumentation::ProfileEntry outerBefore = FindEntry("Outer");
+    const Instrumentation::ProfileEntry innerBefore = FindEntry("Inner");
+
+    for (int i = 0; i < 10; i++) Outer();
+
+    const Instrumentation::ProfileEntry outer = FindEntry("Outer");
+    const Instrumentation::ProfileEntry inner = FindEntry("Inner");
+    CHECK(outer.calls - outerBefore.calls == 10);
+    CHECK(inner.calls - innerBefore.calls == 30);
+    CHECK(inner.ticks > innerBefore.ticks);
+    // Inner scopes are part of the outer one
+    CHECK(outer.ticks - outerBefore.ticks > inner.ticks - innerBefore.ticks);
+    CHECK(Instrumentation::TicksPerSecond() > 1e6);
+}
+
+TEST_CASE("Scoped Timers Across Threads") {
+    const auto run = [] {
+        ParallelFor(64, 1, [](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                PROFILE_SCOPE("Parallel");
+                Work(100);
+            }
+        });
+    };
+
+    const uint64_t before = FindEntry("Parallel").calls;
+    run();
+    CHECK(FindEntry("Parallel").calls - before == 64);
+    // Threads of the second run reuse the counters of the first, which have to keep their counts
+    run();
+    CHECK(FindEntry("Parallel").calls - before == 128);
+}
+
+TEST_CASE("Scoped Timer Sites") {
+    // Every PROFILE_SCOPE is its own site, even with the same name
+    const auto count = [] {
+        size_t sites = 0;
+        for (const Instrumentation::ProfileEntry &entry: Instrumentation::CollectProfile()) sites += strcmp(entry.name, "Twice") == 0;
+        return sites;
+    };
+    {
+        PROFILE_SCOPE("Twice");
+    }
+    {
+        PROFILE_SCOPE("Twice");
+    }
+    CHECK(count() == 2);
+}
+
+static std::string ReadFile(const char *path) {
+    std::ifstream file{path};
+    std::stringstream stream;
+    stream << file.rdbuf();
+    return stream.str();
+}
+
+static size_t CountOccurrences(const std::string &string, const std::string &pattern) {
+    size_t count = 0;
+    for (size_t i = string.find(pattern); i != std::string::npos; i = string.find(pattern, i + 1)) count++;
+    return count;
+}
+
+TEST_CASE("Chrome Trace") {
+    PROFILE_THREAD_NAME("Trace \"test\"");
+    for (uint64_t frame = 0; frame < 3; frame++) {
+        PROFILE_MARK("Trace frame", frame);
+        PROFILE_SCOPE("Trace scope");
+        Work(100);
+    }
+    const size_t ranges = ParallelFor(4, 1, [](size_t, size_t, size_t) {
+        PROFILE_SCOPE("Trace worker scope");
+        Work(100);
+    });
+
+    const char *path = "InstrumentationTests.trace.json";
+    REQUIRE(Instrumentation::WriteChromeTrace(path));
+    const std::string trace = ReadFile(path);
+    std::remove(path);
+
+    CHECK(trace.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0) == 0);
+    CHECK(trace.find("\"args\":{\"name\":\"Trace \\\"test\\\"\"}") != std::string::npos);
+    CHECK(CountOccurrences(trace, "{\"name\":\"Trace scope\",\"ph\":\"X\"") == 3);
+    CHECK(CountOccurrences(trace, "{\"name\":\"Trace frame\",\"ph\":\"i\"") == 3);
+    CHECK(trace.find("\"args\":{\"value\":2}") != std::string::npos);
+    CHECK(CountOccurrences(trace, "{\"name\":\"Trace worker scope\",\"ph\":\"X\"") == ranges);
+}
+
+TEST_CASE("Chrome Trace Ring Buffer") {
+    // Only the latest events of a thread are kept
+    for (uint64_t i = 0; i < Instrumentation::TRACE_CAPACITY + 100; i++) {
+        PROFILE_SCOPE("Trace ring scope");
+    }
+    PROFILE_MARK("Trace ring end", 0);
+
+    const char *path = "InstrumentationTests.ring.json";
+    REQUIRE(Instrumentation::WriteChromeTrace(path));
+    const std::string trace = ReadFile(path);
+    std::remove(path);
+
+    CHECK(CountOccurrences(trace, "\"Trace ring end\"") == 1);
+    // The oldest slot is dropped too, a recording thread could be overwriting it
+    CHECK(CountOccurrences(trace, "\"Trace ring scope\"") == Instrumentation::TRACE_CAPACITY - 2);
+}
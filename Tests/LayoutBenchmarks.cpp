@@ -0,0 +1,344 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cstdio>
+#include <immintrin.h>
+#include <new>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "Mat4.h"
+#include "TestUtils.h"
+
+// The same kernels over Vec4 AoS, pure SoA and AoSoA blocks
+// Elements are directions with w = 0, so Vec4::Normalize and Mat4 * Vec4 only see xyz like the float layouts do
+
+enum class LayoutKernel {
+    Transform,
+    Normalize,
+    Dot
+};
+
+static const char *KernelName(LayoutKernel kernel) {
+    switch (kernel) {
+        case LayoutKernel::Transform:
+            return "transform";
+        case LayoutKernel::Normalize:
+            return "normalize";
+        default:
+            return "dot";
+    }
+}
+
+// Deterministic element i, so every layout gets the same values without a shared source array
+static Vec4 LayoutElement(size_t i) {
+    const auto hash = [](uint32_t x) {
+        x ^= x >> 16;
+        x *= 0x7FEB352D;
+        x ^= x >> 15;
+        x *= 0x846CA68B;
+        x ^= x >> 16;
+        return static_cast<float>(x >> 8) / static_cast<float>(1 << 24) * 2.0f - 1.0f;
+    };
+    const auto seed = static_cast<uint32_t>(i * 3);
+    return Vec4{hash(seed), hash(seed + 1), hash(seed + 2) + 2.0f, 0.0f};
+}
+
+// Elements a run touches: every stride-th element, or a list of indices
+struct AccessPattern {
+    const char *name;
+    size_t stride;
+    const std::vector<uint32_t> *indices;
+    size_t count;
+
+    [[nodiscard]] bool Sequential() const { return stride == 1 && !indices; }
+
+    [[nodiscard]] uint32_t Index(size_t j) const {
+        return indices ? (*indices)[j] : static_cast<uint32_t>(j * stride);
+    }
+
+    // Elements j to j + 7
+    [[nodiscard]] __m256i Index8(size_t j) const {
+        if (indices) return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(indices->data() + j));
+        const __m256i lanes = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(static_cast<int>(stride)));
+        return _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(j * stride)), lanes);
+    }
+};
+
+// Kernels on 8 elements in SoA registers, the same math as the Vec4 versions
+struct LayoutKernels {
+    Mat4 transform;
+    Vec4 direction;
+
+    void Transform(__m256 &x, __m256 &y, __m256 &z) const {
+        const Vec4 &c0 = transform.c0;
+        const Vec4 &c1 = transform.c1;
+        const Vec4 &c2 = transform.c2;
+        const __m256 tx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(c0.x), x), _mm256_mul_ps(_mm256_set1_ps(c1.x), y)), _mm256_mul_ps(_mm256_set1_ps(c2.x), z));
+        const __m256 ty = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(c0.y), x), _mm256_mul_ps(_mm256_set1_ps(c1.y), y)), _mm256_mul_ps(_mm256_set1_ps(c2.y), z));
+        const __m256 tz = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(c0.z), x), _mm256_mul_ps(_mm256_set1_ps(c1.z), y)), _mm256_mul_ps(_mm256_set1_ps(c2.z), z));
+        x = tx;
+        y = ty;
+        z = tz;
+    }
+
+    static void Normalize(__m256 &x, __m256 &y, __m256 &z) {
+        const __m256 length = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z)));
+        x = _mm256_div_ps(x, length);
+        y = _mm256_div_ps(y, length);
+        z = _mm256_div_ps(z, length);
+    }
+
+    [[nodiscard]] __m256 Dot(__m256 x, __m256 y, __m256 z) const {
+        return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(direction.x), x), _mm256_mul_ps(_mm256_set1_ps(direction.y), y)), _mm256_mul_ps(_mm256_set1_ps(direction.z), z));
+    }
+};
+
+struct AoSLayout {
+    static constexpr const char *NAME = "AoS";
+
+    explicit AoSLayout(size_t count)
+        : elements(count) {
+        for (size_t i = 0; i < count; i++) elements[i] = LayoutElement(i);
+    }
+
+    [[nodiscard]] Vec4 Get(size_t i) const { return elements[i]; }
+
+    // Dot results go to out[j] for the j-th touched element
+    void Run(LayoutKernel kernel, const LayoutKernels &kernels, const AccessPattern &pattern, float *out) {
+        for (size_t j = 0; j < pattern.count; j++) {
+            Vec4 &v = elements[pattern.Index(j)];
+            switch (kernel) {
+                case LayoutKernel::Transform:
+                    v = kernels.transform * v;
+                    break;
+                case LayoutKernel::Normalize:
+                    v = v.Normalize();
+                    break;
+                case LayoutKernel::Dot:
+                    out[j] = v.Dot(kernels.direction);
+                    break;
+            }
+        }
+    }
+
+    std::vector<Vec4> elements;
+};
+
+// BlockSize 0 is pure SoA: all x, then all y, then all z
+// Otherwise blocks of BlockSize x, BlockSize y and BlockSize z
+template<size_t BlockSize>
+struct FloatLayout {
+    static constexpr const char *NAME = BlockSize == 0 ? "SoA" : BlockSize == 4 ? "AoSoA4" : BlockSize == 8 ? "AoSoA8" : "AoSoA16";
+
+    explicit FloatLayout(size_t count)
+        : count{count}, data(count * 3) {
+        for (size_t i = 0; i < count; i++) {
+            const Vec4 v = LayoutElement(i);
+            for (size_t c = 0; c < 3; c++) data[Offset(i) + c * ComponentStride()] = v[c];
+        }
+    }
+
+    [[nodiscard]] Vec4 Get(size_t i) const {
+        const size_t offset = Offset(i);
+        return Vec4{data[offset], data[offset + ComponentStride()], data[offset + 2 * ComponentStride()], 0.0f};
+    }
+
+    // Distance from x to y of an element
+    [[nodiscard]] size_t ComponentStride() const { return BlockSize ? BlockSize : count; }
+
+    // Of x of element i
+    [[nodiscard]] size_t Offset(size_t i) const {
+        if constexpr (BlockSize == 0) return i;
+        else return i / BlockSize * 3 * BlockSize + i % BlockSize;
+    }
+
+    [[nodiscard]] __m256i Offsets(__m256i indices) const {
+        if constexpr (BlockSize == 0) {
+            return indices;
+        } else {
+            constexpr int shift = BlockSize == 4 ? 2 : BlockSize == 8 ? 3 : 4;
+            const __m256i block = _mm256_mullo_epi32(_mm256_srli_epi32(indices, shift), _mm256_set1_epi32(3 * BlockSize));
+            return _mm256_add_epi32(block, _mm256_and_si256(indices, _mm256_set1_epi32(BlockSize - 1)));
+        }
+    }
+
+    // 8 consecutive elements from i, i is a multiple of 8
+    void Load(size_t i, __m256 v[3]) const {
+        for (size_t c = 0; c < 3; c++) {
+            const float *p = data.data() + Offset(i) + c * ComponentStride();
+            // The last 4 are in the next block
+            if constexpr (BlockSize == 4) v[c] = _mm256_set_m128(_mm_loadu_ps(p + 12), _mm_loadu_ps(p));
+            else v[c] = _mm256_loadu_ps(p);
+        }
+    }
+
+    void Store(size_t i, const __m256 v[3]) {
+        for (size_t c = 0; c < 3; c++) {
+            float *p = data.data() + Offset(i) + c * ComponentStride();
+            if constexpr (BlockSize == 4) {
+                _mm_storeu_ps(p, _mm256_castps256_ps128(v[c]));
+                _mm_storeu_ps(p + 12, _mm256_extractf128_ps(v[c], 1));
+            } else {
+                _mm256_storeu_ps(p, v[c]);
+            }
+        }
+    }
+
+    void Run(LayoutKernel kernel, const LayoutKernels &kernels, const AccessPattern &pattern, float *out) {
+        const auto componentStride = _mm256_set1_epi32(static_cast<int>(ComponentStride()));
+        for (size_t j = 0; j < pattern.count; j += 8) {
+            __m256 v[3];
+            alignas(32) int32_t offsets[8];
+            if (pattern.Sequential()) {
+                Load(j, v);
+            } else {
+                // No scatter in AVX2, the stores below are scalar
+                __m256i offset = Offsets(pattern.Index8(j));
+                _mm256_store_si256(reinterpret_cast<__m256i *>(offsets), offset);
+                for (size_t c = 0; c < 3; c++) {
+                    v[c] = _mm256_i32gather_ps(data.data(), offset, 4);
+                    offset = _mm256_add_epi32(offset, componentStride);
+                }
+            }
+
+            if (kernel == LayoutKernel::Dot) {
+                _mm256_storeu_ps(out + j, kernels.Dot(v[0], v[1], v[2]));
+                continue;
+            }
+            if (kernel == LayoutKernel::Transform) kernels.Transform(v[0], v[1], v[2]);
+            else LayoutKernels::Normalize(v[0], v[1], v[2]);
+
+            if (pattern.Sequential()) {
+                Store(j, v);
+            } else {
+                alignas(32) float values[3][8];
+                for (size_t c = 0; c < 3; c++) _mm256_store_ps(values[c], v[c]);
+                for (int lane = 0; lane < 8; lane++) {
+                    for (size_t c = 0; c < 3; c++) data[offsets[lane] + c * ComponentStride()] = values[c][lane];
+                }
+            }
+        }
+    }
+
+    size_t count;
+    std::vector<float> data;
+};
+
+static LayoutKernels CreateLayoutKernels() {
+    return {Mat4::RotateY(0.3f) * Mat4::RotateX(0.7f), Vec4{0.3f, -0.5f, 0.8f, 0.0f}};
+}
+
+// Patterns over count elements: all of them sequentially, strides 2, 4 and 16, and count / 16 distinct random indices
+static std::vector<AccessPattern> CreateAccessPatterns(size_t count, std::vector<uint32_t> &randomIndices, std::mt19937 &rng) {
+    // A prefix of a shuffled permutation, so no element is touched twice
+    randomIndices.resize(count);
+    std::iota(randomIndices.begin(), randomIndices.end(), 0u);
+    std::shuffle(randomIndices.begin(), randomIndices.end(), rng);
+    randomIndices.resize(count / 16);
+    return {
+            {"sequential", 1, nullptr, count},
+            {"stride 2", 2, nullptr, count / 2},
+            {"stride 4", 4, nullptr, count / 4},
+            {"stride 16", 16, nullptr, count / 16},
+            {"random 1/16", 0, &randomIndices, count / 16}
+    };
+}
+
+TEST_CASE("Layout Kernels") {
+    constexpr size_t count = 256;
+    const LayoutKernels kernels = CreateLayoutKernels();
+    std::mt19937 rng{40};
+    std::vector<uint32_t> randomIndices;
+    const std::vector<AccessPattern> patterns = CreateAccessPatterns(count, randomIndices, rng);
+
+    // Every layout matches the AoS results, for every kernel and pattern
+    const auto check = [&](auto layout) {
+        for (const AccessPattern &pattern: patterns) {
+            for (LayoutKernel kernel: {LayoutKernel::Transform, LayoutKernel::Normalize, LayoutKernel::Dot}) {
+                AoSLayout expected{count};
+                std::vector<float> expectedOut(count), out(count);
+                expected.Run(kernel, kernels, pattern, expectedOut.data());
+                layout.Run(kernel, kernels, pattern, out.data());
+                for (size_t i = 0; i < count; i++) CHECK_THAT(layout.Get(i), EqualsVec4(expected.Get(i), 1e-5f));
+                for (size_t j = 0; j < pattern.count; j++) CHECK_THAT(out[j], WithinAbs(expectedOut[j], 1e-5));
+                // Back to the initial values for the next kernel
+                layout = decltype(layout){count};
+            }
+        }
+    };
+    check(FloatLayout<0>{count});
+    check(FloatLayout<4>{count});
+    check(FloatLayout<8>{count});
+    check(FloatLayout<16>{count});
+}
+
+// Seconds per run, after a warm up run that also faults in the pages
+template<typename Func>
+static double SecondsPerRun(Func &&func) {
+    using Clock = std::chrono::steady_clock;
+    func();
+    const Clock::time_point start = Clock::now();
+    size_t runs = 0;
+    while (runs < 2 || Clock::now() - start < std::chrono::milliseconds(50)) {
+        func();
+        runs++;
+    }
+    return std::chrono::duration<double>(Clock::now() - start).count() / static_cast<double>(runs);
+}
+
+// xyz of one element, the w of AoS is padding and doesn't count as bandwidth
+static constexpr size_t PAYLOAD_SIZE = 3 * sizeof(float);
+
+template<typename Layout>
+static void SweepLayout(size_t count, const char *size, const LayoutKernels &kernels, const std::vector<AccessPattern> &patterns, std::vector<float> &out) {
+    Layout layout{count};
+    for (LayoutKernel kernel: {LayoutKernel::Transform, LayoutKernel::Normalize, LayoutKernel::Dot}) {
+        for (const AccessPattern &pattern: patterns) {
+            const double seconds = SecondsPerRun([&] { layout.Run(kernel, kernels, pattern, out.data()); });
+            // Useful bytes: xyz is read, and written back or reduced to one float, the same for every layout
+            const size_t bytes = kernel == LayoutKernel::Dot ? PAYLOAD_SIZE + sizeof(float) : PAYLOAD_SIZE * 2;
+            const auto elements = static_cast<double>(pattern.count);
+            printf("%-8s %-10s %-12s %8s %10.2f GB/s %10.3f ns/element\n",
+                   Layout::NAME, KernelName(kernel), pattern.name, size,
+                   elements * static_cast<double>(bytes) / seconds * 1e-9, seconds / elements * 1e9);
+        }
+    }
+}
+
+// Hidden, run with: Benchmarks [layout]
+// Working sets are the size of the Vec4 array, the float layouts hold the same elements in 3/4 of it
+// Bandwidth counts useful bytes only, cache lines loaded for neighbors of touched elements lower it
+TEST_CASE("Layout Sweep Benchmarks", "[.][layout]") {
+    const LayoutKernels kernels = CreateLayoutKernels();
+    std::mt19937 rng{40};
+
+    printf("%-8s %-10s %-12s %8s %15s %20s\n", "Layout", "Kernel", "Access", "Size", "Bandwidth", "Time");
+    for (size_t bytes = 4 * 1024; bytes <= 1024 * 1024 * 1024; bytes *= 4) {
+        char size[16];
+        if (bytes >= 1024 * 1024 * 1024) snprintf(size, sizeof(size), "%zu GB", bytes >> 30);
+        else if (bytes >= 1024 * 1024) snprintf(size, sizeof(size), "%zu MB", bytes >> 20);
+        else snprintf(size, sizeof(size), "%zu KB", bytes >> 10);
+
+        try {
+            const size_t count = bytes / sizeof(Vec4);
+            std::vector<uint32_t> randomIndices;
+            const std::vector<AccessPattern> patterns = CreateAccessPatterns(count, randomIndices, rng);
+            std::vector<float> out(count);
+            // One layout allocated at a time
+            SweepLayout<AoSLayout>(count, size, kernels, patterns, out);
+            SweepLayout<FloatLayout<0>>(count, size, kernels, patterns, out);
+            SweepLayout<FloatLayout<4>>(count, size, kernels, patterns, out);
+            SweepLayout<FloatLayout<8>>(count, size, kernels, patterns, out);
+            SweepLayout<FloatLayout<16>>(count, size, kernels, patterns, out);
+        } catch (const std::bad_alloc &) {
+            printf("Out of memory at %s, stopping\n", size);
+            break;
+        }
+    }
+}
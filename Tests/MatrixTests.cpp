@@ -4,7 +4,10 @@
 
 #include <catch2/catch_test_macros.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <vector>
 
+#include "AABB.h"
+#include "CameraBatch.h"
 #include "TestUtils.h"
 
 TEST_CASE("Construction") {
@@ -122,4 +125,158 @@ TEST_CASE("Static Creates") {
         const Mat4 m2 = Mat4::Perspective(M_PI / 3.0f, 1.0f, 0.1f, 100.0f);
         CHECK_THAT(m1, EqualsMat4(m2));
     }
+
+    {
+        const glm::mat4 m1 = glm::ortho(-2.0f, 3.0f, -1.0f, 4.0f, 0.5f, 50.0f);
+        const Mat4 m2 = Mat4::Ortho(-2.0f, 3.0f, -1.0f, 4.0f, 0.5f, 50.0f);
+        CHECK_THAT(m1, EqualsMat4(m2));
+    }
+}
+
+TEST_CASE("Camera Batch") {
+    // Not a multiple of 4 to cover the tail
+    constexpr size_t count = 11;
+    std::vector<float> eyeX(count), eyeY(count), eyeZ(count);
+    std::vector<float> targetX(count), targetY(count), targetZ(count);
+    std::vector<float> upX(count, 0.0f), upY(count, 1.0f), upZ(count, 0.0f);
+    std::vector<float> fov(count), aspectRatio(count), near(count), far(count);
+    for (size_t i = 0; i < count; i++) {
+        const auto f = static_cast<float>(i);
+        eyeX[i] = f + 1.0f;
+        eyeY[i] = 2.0f - f * 0.5f;
+        eyeZ[i] = 3.0f + f * 0.25f;
+        targetX[i] = -f;
+        targetY[i] = f * 0.1f;
+        targetZ[i] = 0.5f;
+        fov[i] = 0.5f + f * 0.1f;
+        aspectRatio[i] = 1.0f + f * 0.2f;
+        near[i] = 0.1f + f * 0.01f;
+        far[i] = 100.0f + f * 10.0f;
+    }
+    const CameraSoA cameras{{eyeX.data(), eyeY.data(), eyeZ.data()},
+                            {targetX.data(), targetY.data(), targetZ.data()},
+                            {upX.data(), upY.data(), upZ.data()},
+                            fov.data(),
+                            aspectRatio.data(),
+                            near.data(),
+                            far.data()};
+
+    std::vector<Mat4> views(count), projections(count), viewProjections(count);
+
+    CameraBatch::Build(count, cameras, DepthMode::Standard, views.data(), projections.data(), viewProjections.data());
+    for (size_t i = 0; i < count; i++) {
+        const Mat4 view = Mat4::LookAt({eyeX[i], eyeY[i], eyeZ[i], 1.0f},
+                                       {targetX[i], targetY[i], targetZ[i], 1.0f},
+                                       {upX[i], upY[i], upZ[i], 0.0f});
+        const Mat4 projection = Mat4::Perspective(fov[i], aspectRatio[i], near[i], far[i]);
+        CHECK_THAT(views[i], EqualsMat4(view, 1e-5f));
+        CHECK_THAT(projections[i], EqualsMat4(projection, 1e-5f));
+        CHECK_THAT(viewProjections[i], EqualsMat4(projection * view, 1e-4f));
+    }
+
+    const auto depth = [](const Mat4 &projection, float viewZ) {
+        const Vec4 clip = projection * Vec4{0.0f, 0.0f, viewZ, 1.0f};
+        return clip.z / clip.w;
+    };
+
+    CameraBatch::Build(count, cameras, DepthMode::ReverseZ, nullptr, projections.data(), nullptr);
+    for (size_t i = 0; i < count; i++) {
+        CHECK_THAT(depth(projections[i], -near[i]), WithinAbs(1.0f, 1e-5));
+        CHECK_THAT(depth(projections[i], -far[i]), WithinAbs(0.0f, 1e-5));
+    }
+
+    CameraBatch::Build(count, cameras, DepthMode::Infinite, nullptr, projections.data(), nullptr);
+    for (size_t i = 0; i < count; i++) {
+        CHECK_THAT(depth(projections[i], -near[i]), WithinAbs(-1.0f, 1e-5));
+        CHECK_THAT(depth(projections[i], -1e7f), WithinAbs(1.0f, 1e-5));
+    }
+
+    CameraBatch::Build(count, cameras, DepthMode::ReverseZInfinite, nullptr, projections.data(), nullptr);
+    for (size_t i = 0; i < count; i++) {
+        CHECK_THAT(depth(projections[i], -near[i]), WithinAbs(1.0f, 1e-5));
+        CHECK_THAT(depth(projections[i], -1e7f), WithinAbs(0.0f, 1e-5));
+    }
+}
+
+TEST_CASE("Affine") {
+    const Mat4 mat = Mat4::Translate({1.0f, -2.0f, 3.0f, 1.0f}) * Mat4::RotateY(0.7f) * Mat4::Scale({2.0f, 0.5f, 3.0f, 1.0f});
+    const Affine3x4 affine{mat};
+
+    CHECK_THAT(affine.r0, EqualsVec4({mat.c0.x, mat.c1.x, mat.c2.x, mat.c3.x}));
+    CHECK_THAT(affine.ToMat4(), EqualsMat4(mat));
+
+    const Vec4 point{0.5f, -1.5f, 2.0f, 1.0f};
+    const Vec4 direction{0.5f, -1.5f, 2.0f, 0.0f};
+    CHECK_THAT(affine * point, EqualsVec4(mat * point, 1e-5f));
+    CHECK_THAT(affine * direction, EqualsVec4(mat * direction, 1e-5f));
+}
+
+TEST_CASE("Transform AABB") {
+    // Reference: the bounds of the 8 transformed corners
+    const auto transformCorners = [](const Mat4 &mat, const AABB &box) {
+        AABB result = AABB::Empty();
+        for (int corner = 0; corner < 8; corner++) {
+            const Vec4 p{corner & 1 ? box.max.x : box.min.x,
+                         corner & 2 ? box.max.y : box.min.y,
+                         corner & 4 ? box.max.z : box.min.z,
+                         1.0f};
+            result = result.Union(mat * p);
+        }
+        return result;
+    };
+
+    std::vector<Mat4> matrices;
+    std::vector<Affine3x4> affines;
+    std::vector<AABB> boxes;
+    for (int i = 0; i < 37; i++) {
+        const auto f = static_cast<float>(i);
+        matrices.push_back(Mat4::Translate({f, -f * 0.5f, 3.0f, 1.0f}) *
+                           Mat4::RotateZ(f * 0.3f) * Mat4::RotateX(f * 0.7f) * Mat4::RotateY(f * 1.1f) *
+                           Mat4::Scale({1.0f + f * 0.1f, 0.5f, 2.0f - f * 0.03f, 1.0f}));
+        affines.emplace_back(matrices.back());
+        boxes.push_back({{-1.0f - f * 0.1f, -2.0f, f * 0.2f, 1.0f}, {1.0f, 0.5f + f * 0.05f, f * 0.2f + 3.0f, 1.0f}});
+    }
+
+    // Single boxes
+    for (size_t i = 0; i < matrices.size(); i++) {
+        const AABB expected = transformCorners(matrices[i], boxes[i]);
+        const AABB box = TransformAABB(matrices[i], boxes[i]);
+        const AABB affineBox = TransformAABB(affines[i], boxes[i]);
+        CHECK_THAT(box.min, EqualsVec4(expected.min, 1e-4f));
+        CHECK_THAT(box.max, EqualsVec4(expected.max, 1e-4f));
+        CHECK_THAT(affineBox.min, EqualsVec4(expected.min, 1e-4f));
+        CHECK_THAT(affineBox.max, EqualsVec4(expected.max, 1e-4f));
+    }
+
+    // SoA batches, 37 leaves a tail of 1
+    std::vector<float> soa(12 * matrices.size());
+    const auto view = [&](int offset) {
+        float *base = soa.data() + offset * 3 * matrices.size();
+        return Vec3SoA{base, base + matrices.size(), base + 2 * matrices.size()};
+    };
+    const Vec3SoA mins = view(0), maxs = view(1), affineMins = view(2), affineMaxs = view(3);
+    const auto checkBatch = [&](const Vec3SoA &mins, const Vec3SoA &maxs, size_t i, const AABB &expected) {
+        CHECK_THAT(mins.x[i], WithinAbs(expected.min.x, 1e-4));
+        CHECK_THAT(mins.y[i], WithinAbs(expected.min.y, 1e-4));
+        CHECK_THAT(mins.z[i], WithinAbs(expected.min.z, 1e-4));
+        CHECK_THAT(maxs.x[i], WithinAbs(expected.max.x, 1e-4));
+        CHECK_THAT(maxs.y[i], WithinAbs(expected.max.y, 1e-4));
+        CHECK_THAT(maxs.z[i], WithinAbs(expected.max.z, 1e-4));
+    };
+    TransformAABBs(matrices.data(), boxes.data(), matrices.size(), mins, maxs);
+    TransformAABBs(affines.data(), boxes.data(), affines.size(), affineMins, affineMaxs);
+    for (size_t i = 0; i < matrices.size(); i++) {
+        const AABB expected = transformCorners(matrices[i], boxes[i]);
+        checkBatch(mins, maxs, i, expected);
+        checkBatch(affineMins, affineMaxs, i, expected);
+    }
+
+    // Shared local bounds
+    TransformAABBs(matrices.data(), boxes[5], matrices.size(), mins, maxs);
+    TransformAABBs(affines.data(), boxes[5], affines.size(), affineMins, affineMaxs);
+    for (size_t i = 0; i < matrices.size(); i++) {
+        const AABB expected = transformCorners(matrices[i], boxes[5]);
+        checkBatch(mins, maxs, i, expected);
+        checkBatch(affineMins, affineMaxs, i, expected);
+    }
 }
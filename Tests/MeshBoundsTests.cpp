@@ -0,0 +1,103 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "MeshBounds.h"
+#include "Parallel.h"
+#include "TestUtils.h"
+
+// Same layout as the Vertex of Visualization
+struct Vertex {
+    Vec4 position;
+    Vec4 normal;
+};
+
+// Points on and inside of a sphere, normals within angle of +z
+static std::vector<Vertex> RandomVertices(size_t count, const Vec4 &center, float radius, float angle, std::mt19937 &rng) {
+    std::normal_distribution<float> direction;
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<Vertex> vertices(count);
+    for (Vertex &vertex: vertices) {
+        const Vec4 d = Vec4{direction(rng), direction(rng), direction(rng), 0.0f}.Normalize();
+        // Half of the points on the surface, so the true radius is known
+        const float r = unit(rng) < 0.5f ? radius : radius * unit(rng);
+        vertex.position = center + d * Vec4{r};
+        const float theta = unit(rng) * angle;
+        const float phi = unit(rng) * 2.0f * static_cast<float>(M_PI);
+        vertex.normal = Vec4{std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta), 0.0f};
+    }
+    return vertices;
+}
+
+TEST_CASE("Mesh Bounds") {
+    std::mt19937 rng{36};
+
+    // Small counts run on one range and mostly in the scalar tails, large counts on every thread
+    for (size_t count: {size_t{1}, size_t{7}, size_t{13}, size_t{1000}, PARALLEL_THRESHOLD * 4 + 5}) {
+        const Vec4 center{1000.0f, -200.0f, 50.0f, 1.0f};
+        const std::vector<Vertex> vertices = RandomVertices(count, center, 5.0f, 0.5f, rng);
+
+        AABB box = AABB::Empty();
+        double sum[3]{};
+        for (const Vertex &vertex: vertices) {
+            box = box.Union(vertex.position);
+            for (int axis = 0; axis < 3; axis++) sum[axis] += vertex.position[axis];
+        }
+        const Vec4 centroid{static_cast<float>(sum[0] / count), static_cast<float>(sum[1] / count), static_cast<float>(sum[2] / count), 1.0f};
+
+        SECTION("AABB " + std::to_string(count)) {
+            const AABB computed = ComputeAABB(&vertices[0].position, sizeof(Vertex), count);
+            for (int axis = 0; axis < 3; axis++) {
+                CHECK(computed.min[axis] == box.min[axis]);
+                CHECK(computed.max[axis] == box.max[axis]);
+            }
+        }
+
+        SECTION("Mesh Bounds " + std::to_string(count)) {
+            const MeshBounds bounds = ComputeMeshBounds(&vertices[0].position, &vertices[0].normal, sizeof(Vertex), count);
+            for (int axis = 0; axis < 3; axis++) {
+                CHECK(bounds.box.min[axis] == box.min[axis]);
+                CHECK(bounds.box.max[axis] == box.max[axis]);
+            }
+            CHECK_THAT(bounds.centroid, EqualsVec4(centroid, 1e-4f));
+
+            // Contains every vertex, and not much larger than the sphere the points were generated in
+            CHECK(bounds.sphere.center.w == 1.0f);
+            const float tolerance = 1e-4f * (bounds.sphere.center.Length() + bounds.sphere.radius);
+            for (const Vertex &vertex: vertices) {
+                CHECK(bounds.sphere.center.Distance(vertex.position) <= bounds.sphere.radius + tolerance);
+            }
+            if (count >= 1000) CHECK(bounds.sphere.radius <= 5.0f * 1.05f);
+
+            // Every normal is inside of the cone, the cone is not much wider than the generated normals
+            CHECK_THAT(bounds.normalCone.axis.Length(), WithinAbs(1.0f, 1e-5));
+            for (const Vertex &vertex: vertices) CHECK(bounds.normalCone.axis.Dot(vertex.normal) >= bounds.normalCone.cosAngle - 1e-5f);
+            if (count >= 1000) CHECK(bounds.normalCone.cosAngle >= std::cos(0.5f) - 1e-2f);
+        }
+    }
+
+    SECTION("Degenerate") {
+        const MeshBounds empty = ComputeMeshBounds(nullptr, nullptr, sizeof(Vertex), 0);
+        CHECK(empty.sphere.radius == 0.0f);
+        CHECK(empty.box.min.x > empty.box.max.x);
+
+        // Normals pointing in every direction cancel out, positions without normals skip the cone
+        const std::vector<Vertex> vertices = RandomVertices(1000, Vec4{0.0f, 0.0f, 0.0f, 1.0f}, 1.0f, static_cast<float>(M_PI), rng);
+        std::vector<Vertex> opposite = vertices;
+        for (Vertex &vertex: opposite) vertex.normal = -vertex.normal;
+        opposite.insert(opposite.end(), vertices.begin(), vertices.end());
+        CHECK(ComputeMeshBounds(&opposite[0].position, &opposite[0].normal, sizeof(Vertex), opposite.size()).normalCone.cosAngle == -1.0f);
+        CHECK(ComputeMeshBounds(&opposite[0].position, nullptr, sizeof(Vertex), opposite.size()).normalCone.cosAngle == -1.0f);
+
+        // All vertices at one point
+        const std::vector<Vec4> point(100, Vec4{1.0f, 2.0f, 3.0f, 1.0f});
+        const MeshBounds bounds = ComputeMeshBounds(point.data(), nullptr, sizeof(Vec4), point.size());
+        CHECK(bounds.sphere.radius == 0.0f);
+        CHECK_THAT(bounds.sphere.center, EqualsVec4(point[0]));
+    }
+}
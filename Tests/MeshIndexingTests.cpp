@@ -0,0 +1,143 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#include <algorithm>
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <vector>
+
+#include "MeshIndexing.h"
+#include "TestUtils.h"
+
+// Same layout as the Vertex of Visualization
+struct Vertex {
+    Vec4 position;
+    Vec4 normal;
+};
+
+// 2 triangles per face, every corner repeated like CreateBox of Visualization
+static std::vector<Vertex> ExpandedBox() {
+    std::vector<Vertex> vertices;
+    for (int axis = 0; axis < 3; axis++) {
+        for (const float side: {-1.0f, 1.0f}) {
+            Vec4 normal{0.0f, 0.0f, 0.0f, 0.0f};
+            normal[axis] = side;
+            Vec4 corners[4];
+            for (int corner = 0; corner < 4; corner++) {
+                Vec4 position{0.0f, 0.0f, 0.0f, 1.0f};
+                position[axis] = side;
+                position[(axis + 1) % 3] = corner & 1 ? 1.0f : -1.0f;
+                position[(axis + 2) % 3] = corner & 2 ? 1.0f : -1.0f;
+                corners[corner] = position;
+            }
+            for (const int corner: {0, 1, 2, 2, 1, 3}) vertices.push_back({corners[corner], normal});
+        }
+    }
+    return vertices;
+}
+
+// Quads of a size x size grid, each split into 2 triangles
+static std::vector<uint32_t> GridIndices(uint32_t size) {
+    std::vector<uint32_t> indices;
+    for (uint32_t y = 0; y < size; y++) {
+        for (uint32_t x = 0; x < size; x++) {
+            const uint32_t v = y * (size + 1) + x;
+            for (const uint32_t i: {v, v + 1, v + size + 1, v + size + 1, v + 1, v + size + 2}) indices.push_back(i);
+        }
+    }
+    return indices;
+}
+
+// Sorted triangles, rotated so the smallest index is first, which keeps the winding
+template<typename Index>
+static std::vector<std::array<Index, 3>> Triangles(const std::vector<Index> &indices) {
+    std::vector<std::array<Index, 3>> triangles;
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        std::array<Index, 3> t{indices[i], indices[i + 1], indices[i + 2]};
+        std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());
+        triangles.push_back(t);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+TEST_CASE("Weld") {
+    const std::vector<Vertex> box = ExpandedBox();
+    REQUIRE(box.size() == 36);
+
+    std::vector<Vertex> unique;
+    std::vector<uint16_t> indices;
+    MeshIndexing::Weld(box.data(), box.size(), unique, indices);
+    CHECK(unique.size() == 24);
+    REQUIRE(indices.size() == box.size());
+    for (size_t i = 0; i < box.size(); i++) {
+        CHECK_THAT(unique[indices[i]].position, EqualsVec4(box[i].position, 0.0f));
+        CHECK_THAT(unique[indices[i]].normal, EqualsVec4(box[i].normal, 0.0f));
+    }
+
+    // Random picks out of a small pool, so most vertices repeat
+    std::mt19937 rng{48};
+    std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+    std::vector<Vertex> pool(1000);
+    for (Vertex &vertex: pool) {
+        vertex.position = {value(rng), value(rng), value(rng), 1.0f};
+        vertex.normal = {value(rng), value(rng), value(rng), 0.0f};
+    }
+    // Only differs in the sign of zero
+    pool[1] = pool[0];
+    pool[1].normal[0] = -0.0f;
+    pool[0].normal[0] = 0.0f;
+
+    std::uniform_int_distribution<size_t> pick(0, pool.size() - 1);
+    std::vector<Vertex> vertices(100000);
+    for (Vertex &vertex: vertices) vertex = pool[pick(rng)];
+    std::vector<uint32_t> indices32;
+    MeshIndexing::Weld(vertices.data(), vertices.size(), unique, indices32);
+    CHECK(unique.size() <= pool.size());
+    CHECK(unique.size() > pool.size() * 9 / 10);
+    for (size_t i = 0; i < vertices.size(); i++) {
+        CHECK_THAT(unique[indices32[i]].position, EqualsVec4(vertices[i].position, 0.0f));
+        CHECK_THAT(unique[indices32[i]].normal, EqualsVec4(vertices[i].normal, 0.0f));
+    }
+    // Unique vertices are in the order of their first occurrence
+    uint32_t next = 0;
+    for (const uint32_t index: indices32) {
+        CHECK(index <= next);
+        if (index == next) next++;
+    }
+    CHECK(next == unique.size());
+}
+
+TEST_CASE("Optimize Vertex Cache") {
+    constexpr uint32_t size = 64;
+    constexpr size_t vertexCount = (size + 1) * (size + 1);
+    const std::vector<uint32_t> grid = GridIndices(size);
+
+    // Triangles in random order reuse almost nothing
+    std::vector<std::array<uint32_t, 3>> shuffled;
+    for (size_t i = 0; i < grid.size(); i += 3) shuffled.push_back({grid[i], grid[i + 1], grid[i + 2]});
+    std::mt19937 rng{48};
+    std::shuffle(shuffled.begin(), shuffled.end(), rng);
+    std::vector<uint32_t> indices;
+    for (const std::array<uint32_t, 3> &t: shuffled) indices.insert(indices.end(), t.begin(), t.end());
+
+    const float before = MeshIndexing::AverageCacheMissRatio(indices.data(), indices.size(), vertexCount);
+    const std::vector<uint32_t> optimized = MeshIndexing::OptimizeVertexCache(indices.data(), indices.size(), vertexCount);
+    const float after = MeshIndexing::AverageCacheMissRatio(optimized.data(), optimized.size(), vertexCount);
+    CHECK(before > 2.0f);
+    CHECK(after < 0.8f);
+    // Same triangles with the same winding
+    CHECK(Triangles(optimized) == Triangles(indices));
+
+    // Scattered vertices and unreferenced ones, with 16-bit indices
+    std::vector<uint16_t> sparse;
+    for (const uint32_t i: indices) sparse.push_back(static_cast<uint16_t>(i * 7 % 65521));
+    const std::vector<uint16_t> optimizedSparse = MeshIndexing::OptimizeVertexCache(sparse.data(), sparse.size(), 65536);
+    CHECK(Triangles(optimizedSparse) == Triangles(sparse));
+    CHECK(MeshIndexing::AverageCacheMissRatio(optimizedSparse.data(), optimizedSparse.size(), 65536) < 0.8f);
+
+    CHECK(MeshIndexing::OptimizeVertexCache<uint32_t>(nullptr, 0, 0).empty());
+    CHECK(MeshIndexing::AverageCacheMissRatio<uint32_t>(nullptr, 0, 0) == 0.0f);
+}
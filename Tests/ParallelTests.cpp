@@ -0,0 +1,62 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <utility>
+#include <vector>
+
+#include "Parallel.h"
+
+// Every index in exactly one range, ranges in order and contiguous
+static void CheckRanges(const std::vector<std::pair<size_t, size_t>> &ranges, size_t rangeCount, size_t count) {
+    size_t expectedBegin = 0;
+    for (size_t range = 0; range < rangeCount; range++) {
+        CHECK(ranges[range].first == expectedBegin);
+        CHECK(ranges[range].second >= ranges[range].first);
+        expectedBegin = ranges[range].second;
+    }
+    CHECK(expectedBegin == count);
+}
+
+TEST_CASE("Worker Pool") {
+    WorkerPool pool{4};
+    CHECK(pool.ThreadCount() == 4);
+
+    for (const size_t count: {size_t{0}, size_t{1}, size_t{7}, size_t{1000}, size_t{100003}}) {
+        for (const size_t minRangeSize: {size_t{1}, size_t{16}, size_t{4096}}) {
+            std::vector<std::pair<size_t, size_t>> ranges(4);
+            const size_t rangeCount = pool.For(count, minRangeSize, [&](size_t range, size_t begin, size_t end) {
+                ranges[range] = {begin, end};
+            });
+            CHECK(rangeCount == RangeCount(count, minRangeSize, 4));
+            CheckRanges(ranges, rangeCount, count);
+        }
+    }
+
+    // Many calls in a row reuse the same threads
+    std::atomic<size_t> sum{0};
+    for (int i = 0; i < 1000; i++) {
+        pool.For(64, 1, [&](size_t, size_t begin, size_t end) {
+            for (size_t j = begin; j < end; j++) sum += j;
+        });
+    }
+    CHECK(sum == 1000 * (63 * 64 / 2));
+}
+
+TEST_CASE("Parallel For Ranges") {
+    // The same count and minRangeSize give the same ranges every call, and the same as a pool of ThreadCount() threads
+    WorkerPool pool;
+    for (const size_t count: {size_t{5}, size_t{4096}, size_t{100003}}) {
+        std::vector<std::pair<size_t, size_t>> a(ThreadCount()), b(ThreadCount()), c(ThreadCount());
+        const size_t rangesA = ParallelFor(count, 1024, [&](size_t range, size_t begin, size_t end) { a[range] = {begin, end}; });
+        const size_t rangesB = ParallelFor(count, 1024, [&](size_t range, size_t begin, size_t end) { b[range] = {begin, end}; });
+        const size_t rangesC = pool.For(count, 1024, [&](size_t range, size_t begin, size_t end) { c[range] = {begin, end}; });
+        CHECK(rangesA == rangesB);
+        CHECK(rangesA == rangesC);
+        CheckRanges(a, rangesA, count);
+        CHECK(a == b);
+        CHECK(a == c);
+    }
+}
@@ -0,0 +1,166 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#include "PerfCounters.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cpuid.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+
+// glibc has no wrapper for it
+static int PerfEventOpen(perf_event_attr &attr, int groupFd) {
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0));
+}
+
+// Raw uop event of the CPU vendor, 0 when unknown
+static uint64_t UopsEvent() {
+    unsigned eax, vendor[3];
+    __cpuid(0, eax, vendor[0], vendor[2], vendor[1]);
+    char name[13]{};
+    memcpy(name, vendor, 12);
+    // UOPS_ISSUED.ANY, event 0x0E umask 0x01
+    if (strcmp(name, "GenuineIntel") == 0) return 0x010E;
+    // Retired Uops, PMCx0C1
+    if (strcmp(name, "AuthenticAMD") == 0) return 0x00C1;
+    return 0;
+}
+
+PerfCounters::PerfCounters() {
+    for (int &fd: m_fds) fd = -1;
+
+    const uint32_t types[COUNTER_COUNT] = {
+            PERF_TYPE_HARDWARE,
+            PERF_TYPE_HARDWARE,
+            PERF_TYPE_HW_CACHE,
+            PERF_TYPE_HW_CACHE,
+            PERF_TYPE_HARDWARE,
+            PERF_TYPE_RAW
+    };
+    const uint64_t configs[COUNTER_COUNT] = {
+            PERF_COUNT_HW_CPU_CYCLES,
+            PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_L1D | PERF_COUNT_HW_CACHE_OP_READ << 8 | PERF_COUNT_HW_CACHE_RESULT_MISS << 16,
+            PERF_COUNT_HW_CACHE_LL | PERF_COUNT_HW_CACHE_OP_READ << 8 | PERF_COUNT_HW_CACHE_RESULT_MISS << 16,
+            PERF_COUNT_HW_BRANCH_MISSES,
+            UopsEvent()
+    };
+
+    for (int counter = 0; counter < COUNTER_COUNT; counter++) {
+        if (types[counter] == PERF_TYPE_RAW && configs[counter] == 0) continue;
+
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = types[counter];
+        attr.config = configs[counter];
+        // User space only, allowed with the default perf_event_paranoid of 2
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        // Threads started by ParallelFor are counted too, once they are joined
+        attr.inherit = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        // Every counter is in the group of cycles, the group is enabled by Start
+        attr.disabled = counter == Cycles;
+        m_fds[counter] = PerfEventOpen(attr, m_fds[Cycles]);
+        if (m_fds[counter] < 0 && counter == Cycles) {
+            m_error = std::string{"perf_event_open failed: "} + strerror(errno);
+            if (errno == EACCES || errno == EPERM) m_error += ", see /proc/sys/kernel/perf_event_paranoid";
+            return;
+        }
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for (const int fd: m_fds) {
+        if (fd >= 0) close(fd);
+    }
+}
+
+void PerfCounters::Start() {
+    if (!Available()) return;
+    ioctl(m_fds[Cycles], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(m_fds[Cycles], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+void PerfCounters::Resume() {
+    if (!Available()) return;
+    ioctl(m_fds[Cycles], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+void PerfCounters::Stop() {
+    if (!Available()) return;
+    ioctl(m_fds[Cycles], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+}
+
+double PerfCounters::Read(Counter counter) const {
+    if (m_fds[counter] < 0) return 0.0;
+    // value, time enabled, time running
+    uint64_t values[3];
+    if (read(m_fds[counter], values, sizeof(values)) != sizeof(values) || values[2] == 0) return 0.0;
+    return static_cast<double>(values[0]) * static_cast<double>(values[1]) / static_cast<double>(values[2]);
+}
+
+#else
+
+PerfCounters::PerfCounters()
+    : m_error{"perf_event_open is only available on Linux"} {
+    for (int &fd: m_fds) fd = -1;
+}
+
+PerfCounters::~PerfCounters() = default;
+
+void PerfCounters::Start() {}
+
+void PerfCounters::Resume() {}
+
+void PerfCounters::Stop() {}
+
+double PerfCounters::Read(Counter) const {
+    return 0.0;
+}
+
+#endif
+
+const char *PerfCounters::Name(Counter counter) {
+    static const char *names[COUNTER_COUNT] = {"cycles", "instructions", "L1D misses", "LLC misses", "branch misses", "uops"};
+    return names[counter];
+}
+
+static std::unique_ptr<PerfCounters> g_perfCounters;
+
+void EnablePerfCounters() {
+    g_perfCounters = std::make_unique<PerfCounters>();
+    if (!g_perfCounters->Available()) {
+        fprintf(stderr, "Performance counters unavailable, %s\n", g_perfCounters->Error().c_str());
+        g_perfCounters.reset();
+    }
+}
+
+PerfCounters *ActivePerfCounters() {
+    return g_perfCounters.get();
+}
+
+void PrintPerfCounters(const PerfCounters &counters, double operations) {
+    printf("   ");
+    for (int i = 0; i < PerfCounters::COUNTER_COUNT; i++) {
+        const auto counter = static_cast<PerfCounters::Counter>(i);
+        if (counters.Has(counter)) printf(" %s/op %.2f", PerfCounters::Name(counter), counters.Read(counter) / operations);
+        if (counter == PerfCounters::Instructions && counters.Has(counter)) {
+            const double cycles = counters.Read(PerfCounters::Cycles);
+            if (cycles > 0.0) printf(" IPC %.2f", counters.Read(counter) / cycles);
+        }
+    }
+    printf("\n");
+}
@@ -0,0 +1,64 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#pragma once
+
+#include <string>
+
+// Hardware performance counters of the calling thread and the threads it starts, through Linux perf_event_open
+// Counters the kernel or CPU doesn't offer are skipped, on other platforms nothing is available
+class PerfCounters {
+public:
+    enum Counter {
+        Cycles,
+        Instructions,
+        L1DMisses,
+        LLCMisses,
+        BranchMisses,
+        // Issued on Intel, retired on AMD, not available elsewhere
+        Uops,
+        COUNTER_COUNT
+    };
+
+    PerfCounters();
+
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters &) = delete;
+
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    // Cycles at least could be opened, otherwise Error() says why
+    [[nodiscard]] bool Available() const { return m_fds[Cycles] >= 0; }
+
+    [[nodiscard]] bool Has(Counter counter) const { return m_fds[counter] >= 0; }
+
+    [[nodiscard]] const std::string &Error() const { return m_error; }
+
+    // Resets and starts every counter
+    void Start();
+
+    // Starts every counter again without resetting, counts add up over several Resume and Stop pairs
+    void Resume();
+
+    void Stop();
+
+    // Count between the last Start and Stop, scaled up when the kernel multiplexed the counter, 0 when not available
+    [[nodiscard]] double Read(Counter counter) const;
+
+    static const char *Name(Counter counter);
+
+private:
+    int m_fds[COUNTER_COUNT];
+    std::string m_error;
+};
+
+// Benchmarks report counters when the --perf-counters option enabled them and they are available
+void EnablePerfCounters();
+
+// nullptr when disabled or not available
+PerfCounters *ActivePerfCounters();
+
+// Prints every available counter divided by operations, on one line
+void PrintPerfCounters(const PerfCounters &counters, double operations);
@@ -6,12 +6,38 @@
 
 #include <cmath>
 
+#include "Mat4.h"
+
 struct alignas(16) PlainVec {
     float x;
     float y;
     float z;
     float w;
 
+    PlainVec operator+(const PlainVec &v) const {
+        return {x + v.x, y + v.y, z + v.z, w + v.w};
+    }
+
+    PlainVec operator-(const PlainVec &v) const {
+        return {x - v.x, y - v.y, z - v.z, w - v.w};
+    }
+
+    PlainVec operator*(const PlainVec &v) const {
+        return {x * v.x, y * v.y, z * v.z, w * v.w};
+    }
+
+    PlainVec operator/(const PlainVec &v) const {
+        return {x / v.x, y / v.y, z / v.z, w / v.w};
+    }
+
+    [[nodiscard]] float Dot(const PlainVec &v) const {
+        return x * v.x + y * v.y + z * v.z + w * v.w;
+    }
+
+    [[nodiscard]] float Length() const {
+        return sqrt(Dot(*this));
+    }
+
     [[nodiscard]] PlainVec Normalize() const {
         float sum = x * x + y * y + z * z + w * w;
         float len = sqrt(sum);
@@ -23,6 +49,32 @@ struct alignas(16) PlainVec {
     }
 };
 
+// Column major like Mat4
+struct alignas(16) PlainMat {
+    PlainVec operator*(const PlainVec &v) const {
+        return {c0.x * v.x + c1.x * v.y + c2.x * v.z + c3.x * v.w,
+                c0.y * v.x + c1.y * v.y + c2.y * v.z + c3.y * v.w,
+                c0.z * v.x + c1.z * v.y + c2.z * v.z + c3.z * v.w,
+                c0.w * v.x + c1.w * v.y + c2.w * v.z + c3.w * v.w};
+    }
+
+    PlainMat operator*(const PlainMat &m) const {
+        return {*this * m.c0, *this * m.c1, *this * m.c2, *this * m.c3};
+    }
+
+    [[nodiscard]] PlainMat Transpose() const {
+        return {{c0.x, c1.x, c2.x, c3.x},
+                {c0.y, c1.y, c2.y, c3.y},
+                {c0.z, c1.z, c2.z, c3.z},
+                {c0.w, c1.w, c2.w, c3.w}};
+    }
+
+    PlainVec c0;
+    PlainVec c1;
+    PlainVec c2;
+    PlainVec c3;
+};
+
 struct alignas(16) PlainQuat {
     PlainQuat operator*(const PlainQuat &q) const {
         const float x1 = x;
@@ -49,9 +101,9 @@ struct alignas(16) PlainQuat {
         const float wx = w * x;
         const float wy = w * y;
         const float wz = w * z;
-        return {1 - 2 * y2 - 2 * z2, 2 * xy - 2 * wz, 2 * xz + 2 * wy, 0,
-                2 * xy + 2 * wz, 1 - 2 * x2 - 2 * z2, 2 * yz - 2 * wx, 0,
-                2 * xz - 2 * wy, 2 * yz + 2 * wx, 1 - 2 * x2 - 2 * y2, 0,
+        return {1 - 2 * y2 - 2 * z2, 2 * xy + 2 * wz, 2 * xz - 2 * wy, 0,
+                2 * xy - 2 * wz, 1 - 2 * x2 - 2 * z2, 2 * yz + 2 * wx, 0,
+                2 * xz + 2 * wy, 2 * yz - 2 * wx, 1 - 2 * x2 - 2 * y2, 0,
                 0, 0, 0, 1};
     }
 
@@ -3,7 +3,9 @@
 //
 
 #include <catch2/catch_test_macros.hpp>
+#include <vector>
 
+#include "QuatBatch.h"
 #include "TestUtils.h"
 
 using Catch::Matchers::WithinRel;
@@ -89,3 +91,98 @@ TEST_CASE("Operators") {
     CHECK_THAT(j.ToMat4(), EqualsMat4(ToMat4Reference(j)));
     CHECK_THAT(k.ToMat4(), EqualsMat4(ToMat4Reference(k)));
 }
+
+TEST_CASE("Batch Construction") {
+    // Not a multiple of 4 to cover the tail
+    constexpr size_t count = 103;
+    std::vector<float> ax(count), ay(count), az(count), angles(count);
+    for (size_t i = 0; i < count; i++) {
+        ax[i] = std::sin(static_cast<float>(i) * 1.3f);
+        ay[i] = std::cos(static_cast<float>(i) * 0.7f) + 0.1f;
+        az[i] = std::sin(static_cast<float>(i) * 2.9f + 1.0f);
+        angles[i] = static_cast<float>(i) * 0.37f - 19.0f;
+    }
+
+    std::vector<float> qx(count), qy(count), qz(count), qw(count);
+    const Vec4SoA quats{qx.data(), qy.data(), qz.data(), qw.data()};
+
+    QuatBatch::FromAxisAngle(count, {ax.data(), ay.data(), az.data()}, angles.data(), quats);
+    for (size_t i = 0; i < count; i++) {
+        const Quat q{{ax[i], ay[i], az[i], 0.0f}, angles[i]};
+        CHECK_THAT(Quat(qx[i], qy[i], qz[i], qw[i]), EqualsQuat(q, 1e-6f));
+    }
+
+    const Vec4 unitAxes[3] = {{1.0f, 0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f, 0.0f}};
+    static constexpr int AXES[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+    for (int order = 0; order < 6; order++) {
+        // Keep the middle angle inside [-pi/2, pi/2] so the round trip is unique
+        std::vector<float> ex(count), ey(count), ez(count);
+        for (size_t i = 0; i < count; i++) {
+            float e[3] = {angles[i] * 0.15f, std::sin(angles[i]) * 1.5f, ax[i] * 3.0f};
+            std::swap(e[1], e[AXES[order][1]]);
+            ex[i] = e[0];
+            ey[i] = e[1];
+            ez[i] = e[2];
+        }
+
+        QuatBatch::FromEuler(count, {ex.data(), ey.data(), ez.data()}, static_cast<EulerOrder>(order), quats);
+        for (size_t i = 0; i < count; i++) {
+            const float e[3] = {ex[i], ey[i], ez[i]};
+            const int *axes = AXES[order];
+            const Quat q = Quat{unitAxes[axes[2]], e[axes[2]]} * Quat{unitAxes[axes[1]], e[axes[1]]} * Quat{unitAxes[axes[0]], e[axes[0]]};
+            CHECK_THAT(Quat(qx[i], qy[i], qz[i], qw[i]), EqualsQuat(q, 1e-6f));
+        }
+
+        std::vector<float> rx(count), ry(count), rz(count);
+        QuatBatch::ToEuler(count, quats, static_cast<EulerOrder>(order), {rx.data(), ry.data(), rz.data()});
+        for (size_t i = 0; i < count; i++) {
+            CHECK_THAT(rx[i], WithinAbs(std::remainder(ex[i], 2.0f * M_PI), 1e-3));
+            CHECK_THAT(ry[i], WithinAbs(std::remainder(ey[i], 2.0f * M_PI), 1e-3));
+            CHECK_THAT(rz[i], WithinAbs(std::remainder(ez[i], 2.0f * M_PI), 1e-3));
+        }
+    }
+
+    const float dt = 1.0f / 60.0f;
+    ax[0] = ay[0] = az[0] = 0.0f;
+    ax[1] = 1e-6f;
+    ay[1] = az[1] = 0.0f;
+    QuatBatch::FromAngularVelocity(count, {ax.data(), ay.data(), az.data()}, dt, quats);
+    CHECK_THAT(Quat(qx[0], qy[0], qz[0], qw[0]), EqualsQuat({}));
+    CHECK_THAT(Quat(qx[1], qy[1], qz[1], qw[1]), EqualsQuat({0.5e-6f * dt, 0.0f, 0.0f, 1.0f}));
+    for (size_t i = 2; i < count; i++) {
+        const Vec4 omega{ax[i], ay[i], az[i], 0.0f};
+        const Quat q{omega, omega.Length() * dt};
+        CHECK_THAT(Quat(qx[i], qy[i], qz[i], qw[i]), EqualsQuat(q, 1e-6f));
+    }
+}
+
+TEST_CASE("Batch Matrices") {
+    // Not a multiple of 4 to cover the tail
+    constexpr size_t count = 13;
+    std::vector<float> qx(count), qy(count), qz(count), qw(count);
+    std::vector<float> tx(count), ty(count), tz(count);
+    std::vector<Quat> reference(count);
+    for (size_t i = 0; i < count; i++) {
+        const auto f = static_cast<float>(i);
+        reference[i] = Quat{{std::sin(f * 1.3f), std::cos(f * 0.7f) + 0.1f, std::sin(f * 2.9f + 1.0f), 0.0f}, f * 0.9f - 5.0f};
+        qx[i] = reference[i].x;
+        qy[i] = reference[i].y;
+        qz[i] = reference[i].z;
+        qw[i] = reference[i].w;
+        tx[i] = f;
+        ty[i] = -2.0f * f;
+        tz[i] = f * f;
+    }
+    const Vec4SoA quats{qx.data(), qy.data(), qz.data(), qw.data()};
+    const Vec3SoA translations{tx.data(), ty.data(), tz.data()};
+
+    std::vector<Mat4> rotations(count), transforms(count);
+    QuatBatch::ToMat4(count, quats, nullptr, rotations.data());
+    QuatBatch::ToMat4(count, quats, &translations, transforms.data());
+    for (size_t i = 0; i < count; i++) {
+        const Mat4 rotation = reference[i].ToMat4();
+        CHECK_THAT(rotations[i], EqualsMat4(rotation));
+        const Mat4 transform{rotation.c0, rotation.c1, rotation.c2, {tx[i], ty[i], tz[i], 1.0f}};
+        CHECK_THAT(transforms[i], EqualsMat4(transform));
+    }
+}
@@ -0,0 +1,157 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <random>
+
+#include "Ray.h"
+#include "TestUtils.h"
+
+using Catch::Matchers::WithinRel;
+
+// Straightforward slab test, axes the ray is parallel to are checked separately
+static bool IntersectReference(const Ray &ray, const AABB &box, float &tEntry) {
+    float tNear = ray.tMin;
+    float tFar = ray.tMax;
+    for (int axis = 0; axis < 3; axis++) {
+        if (ray.direction[axis] == 0.0f) {
+            if (ray.origin[axis] < box.min[axis] || ray.origin[axis] > box.max[axis]) return false;
+            continue;
+        }
+        float t1 = (box.min[axis] - ray.origin[axis]) / ray.direction[axis];
+        float t2 = (box.max[axis] - ray.origin[axis]) / ray.direction[axis];
+        if (t1 > t2) std::swap(t1, t2);
+        tNear = std::fmax(tNear, t1);
+        tFar = std::fmin(tFar, t2);
+    }
+    tEntry = tNear;
+    return tNear <= tFar;
+}
+
+static Ray RandomRay(std::mt19937 &rng) {
+    std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+    std::uniform_int_distribution<int> zeroAxis(-1, 2);
+    Vec4 direction{position(rng), position(rng), position(rng), 0.0f};
+    // Axis-parallel rays exercise the infinite reciprocals
+    const int axis = zeroAxis(rng);
+    if (axis >= 0) direction[axis] = 0.0f;
+    return {{position(rng), position(rng), position(rng), 1.0f}, direction, 0.0f, 2.0f};
+}
+
+static AABB RandomBox(std::mt19937 &rng) {
+    std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> extent(0.1f, 8.0f);
+    const Vec4 min{position(rng), position(rng), position(rng), 1.0f};
+    return {min, min + Vec4{extent(rng), extent(rng), extent(rng), 0.0f}};
+}
+
+static void SetLane(AABB4 &boxes, int lane, const AABB &box) {
+    boxes.minX[lane] = box.min.x;
+    boxes.minY[lane] = box.min.y;
+    boxes.minZ[lane] = box.min.z;
+    boxes.maxX[lane] = box.max.x;
+    boxes.maxY[lane] = box.max.y;
+    boxes.maxZ[lane] = box.max.z;
+}
+
+static void SetLane(AABB8 &boxes, int lane, const AABB &box) {
+    boxes.minX[lane] = box.min.x;
+    boxes.minY[lane] = box.min.y;
+    boxes.minZ[lane] = box.min.z;
+    boxes.maxX[lane] = box.max.x;
+    boxes.maxY[lane] = box.max.y;
+    boxes.maxZ[lane] = box.max.z;
+}
+
+TEST_CASE("Ray Box Intersection") {
+    const Ray ray{{0.0f, 0.0f, -5.0f, 1.0f}, {0.0f, 0.0f, 1.0f, 0.0f}};
+    float tEntry;
+    CHECK(Intersect(ray, {{-1.0f, -1.0f, -1.0f, 1.0f}, {1.0f, 1.0f, 1.0f, 1.0f}}, tEntry));
+    CHECK_THAT(tEntry, WithinRel(4.0f));
+    CHECK_FALSE(Intersect(ray, {{2.0f, -1.0f, -1.0f, 1.0f}, {3.0f, 1.0f, 1.0f, 1.0f}}, tEntry));
+    CHECK_FALSE(Intersect(ray, {{-1.0f, -1.0f, -8.0f, 1.0f}, {1.0f, 1.0f, -6.0f, 1.0f}}, tEntry));
+
+    // Starting inside clamps the entry distance to tMin
+    CHECK(Intersect(Ray{{0.0f, 0.0f, 0.0f, 1.0f}, {1.0f, 0.0f, 0.0f, 0.0f}}, {{-1.0f, -1.0f, -1.0f, 1.0f}, {1.0f, 1.0f, 1.0f, 1.0f}}, tEntry));
+    CHECK_THAT(tEntry, WithinAbs(0.0f, 0.0));
+}
+
+TEST_CASE("Ray Box Packets") {
+    std::mt19937 rng{42};
+    for (int iteration = 0; iteration < 1000; iteration++) {
+        Ray rays[8];
+        AABB boxes[8];
+        for (int i = 0; i < 8; i++) {
+            rays[i] = RandomRay(rng);
+            boxes[i] = RandomBox(rng);
+        }
+
+        bool expectedHits[8];
+        float expectedEntries[8];
+
+        // 1 ray vs 4 and 8 boxes
+        AABB4 boxes4;
+        AABB8 boxes8;
+        for (int i = 0; i < 8; i++) {
+            if (i < 4) SetLane(boxes4, i, boxes[i]);
+            SetLane(boxes8, i, boxes[i]);
+            expectedHits[i] = IntersectReference(rays[0], boxes[i], expectedEntries[i]);
+        }
+
+        __m128 tEntry4;
+        __m256 tEntry8;
+        const int mask4 = Intersect(rays[0], boxes4, tEntry4);
+        const int mask8 = Intersect(rays[0], boxes8, tEntry8);
+        alignas(32) float entries[8];
+        _mm256_store_ps(entries, tEntry8);
+        for (int i = 0; i < 8; i++) {
+            CHECK(((mask8 >> i) & 1) == expectedHits[i]);
+            CHECK_FALSE(std::isnan(entries[i]));
+            if (expectedHits[i]) CHECK_THAT(entries[i], WithinAbs(expectedEntries[i], 1e-4));
+        }
+        _mm_store_ps(entries, tEntry4);
+        for (int i = 0; i < 4; i++) {
+            CHECK(((mask4 >> i) & 1) == expectedHits[i]);
+            if (expectedHits[i]) CHECK_THAT(entries[i], WithinAbs(expectedEntries[i], 1e-4));
+        }
+
+        float scalarEntry;
+        CHECK(Intersect(rays[0], boxes[0], scalarEntry) == expectedHits[0]);
+        if (expectedHits[0]) CHECK_THAT(scalarEntry, WithinAbs(expectedEntries[0], 1e-4));
+
+        // 4 and 8 rays vs 1 box
+        for (int i = 0; i < 8; i++) {
+            expectedHits[i] = IntersectReference(rays[i], boxes[0], expectedEntries[i]);
+        }
+        const int packetMask4 = Intersect(RayPacket4{rays}, boxes[0], tEntry4);
+        const int packetMask8 = Intersect(RayPacket8{rays}, boxes[0], tEntry8);
+        _mm256_store_ps(entries, tEntry8);
+        for (int i = 0; i < 8; i++) {
+            CHECK(((packetMask8 >> i) & 1) == expectedHits[i]);
+            CHECK(((packetMask4 >> i) & 1) == (i < 4 && expectedHits[i]));
+            if (expectedHits[i]) CHECK_THAT(entries[i], WithinAbs(expectedEntries[i], 1e-4));
+        }
+    }
+}
+
+TEST_CASE("Ray Box Degenerate Cases") {
+    AABB8 boxes;
+    for (int i = 0; i < 8; i++) {
+        SetLane(boxes, i, {Vec4{INFINITY}, Vec4{INFINITY}});
+    }
+    // Axis-parallel ray starting exactly on a slab plane
+    SetLane(boxes, 0, {{0.0f, -1.0f, -1.0f, 1.0f}, {1.0f, 1.0f, 1.0f, 1.0f}});
+
+    for (const Vec4 &direction: {Vec4{0.0f, 0.0f, 1.0f, 0.0f}, Vec4{0.0f, 0.0f, -1.0f, 0.0f}, Vec4{-0.0f, 1.0f, 0.0f, 0.0f}}) {
+        const Ray ray{{0.0f, 0.0f, 0.0f, 1.0f}, direction};
+        __m256 tEntry;
+        const int mask = Intersect(ray, boxes, tEntry);
+        alignas(32) float entries[8];
+        _mm256_store_ps(entries, tEntry);
+        // Unused lanes never hit
+        CHECK((mask & 0b11111110) == 0);
+        for (const float entry: entries) CHECK_FALSE(std::isnan(entry));
+    }
+}
@@ -0,0 +1,96 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <vector>
+
+#include "Parallel.h"
+#include "SpatialHash.h"
+#include "TestUtils.h"
+
+static std::vector<Vec4> RandomPositions(size_t count, float size, std::mt19937 &rng) {
+    // Both signs, so negative cell coordinates are covered
+    std::uniform_real_distribution<float> position(-size, size);
+    std::vector<Vec4> positions(count);
+    for (Vec4 &p: positions) p = Vec4{position(rng), position(rng), position(rng), 1.0f};
+    return positions;
+}
+
+static std::vector<uint32_t> BruteForce(const std::vector<Vec4> &positions, const Vec4 &center, float radius) {
+    std::vector<uint32_t> indices;
+    for (size_t i = 0; i < positions.size(); i++) {
+        const Vec4 d = positions[i] - center;
+        if (d.x * d.x + d.y * d.y + d.z * d.z <= radius * radius) indices.push_back(static_cast<uint32_t>(i));
+    }
+    return indices;
+}
+
+TEST_CASE("Spatial Hash Grid") {
+    SECTION("Rebuild") {
+        std::mt19937 rng{34};
+        const std::vector<Vec4> positions = RandomPositions(1000, 20.0f, rng);
+        SpatialHashGrid grid{2.0f};
+        grid.Rebuild(positions.data(), positions.size());
+
+        // Every point once, in the bucket of its cell
+        const std::vector<uint32_t> &starts = grid.BucketStarts();
+        CHECK(starts.front() == 0);
+        CHECK(starts.back() == positions.size());
+        std::vector<uint32_t> indices = grid.Indices();
+        std::sort(indices.begin(), indices.end());
+        for (size_t i = 0; i < indices.size(); i++) CHECK(indices[i] == i);
+    }
+
+    SECTION("Radius Queries") {
+        std::mt19937 rng{35};
+        const std::vector<Vec4> positions = RandomPositions(3000, 20.0f, rng);
+        SpatialHashGrid grid{2.0f};
+        grid.Rebuild(positions.data(), positions.size());
+
+        // Radii smaller and larger than the cells
+        for (float radius: {0.5f, 2.0f, 7.5f}) {
+            for (const Vec4 &center: RandomPositions(50, 22.0f, rng)) {
+                std::vector<uint32_t> found;
+                grid.Query(center, radius, [&](uint32_t index, float distanceSquared) {
+                    found.push_back(index);
+                    CHECK_THAT(distanceSquared, WithinAbs((positions[index] - center).Dot(positions[index] - center), 1e-3));
+                });
+                std::sort(found.begin(), found.end());
+                CHECK(found == BruteForce(positions, center, radius));
+            }
+        }
+    }
+
+    SECTION("Batched Queries") {
+        std::mt19937 rng{36};
+        const std::vector<Vec4> positions = RandomPositions(PARALLEL_THRESHOLD * 2, 40.0f, rng);
+        SpatialHashGrid grid{1.5f};
+        grid.Rebuild(positions.data(), positions.size());
+
+        // The points themselves as centers, so every point finds at least itself
+        const std::vector<Vec4> centers(positions.begin(), positions.begin() + 5000);
+        std::vector<uint32_t> offsets, neighbors;
+        grid.Query(centers.data(), centers.size(), 1.5f, offsets, neighbors);
+        REQUIRE(offsets.size() == centers.size() + 1);
+        CHECK(offsets.back() == neighbors.size());
+        for (size_t i = 0; i < centers.size(); i += 7) {
+            std::vector<uint32_t> found(neighbors.begin() + offsets[i], neighbors.begin() + offsets[i + 1]);
+            std::sort(found.begin(), found.end());
+            CHECK(std::binary_search(found.begin(), found.end(), static_cast<uint32_t>(i)));
+            CHECK(found == BruteForce(positions, centers[i], 1.5f));
+        }
+
+        // Rebuilding with fewer points reuses the buffers
+        const std::vector<Vec4> fewer(positions.begin(), positions.begin() + 10);
+        grid.Rebuild(fewer.data(), fewer.size());
+        grid.Query(fewer.data(), fewer.size(), 30.0f, offsets, neighbors);
+        for (size_t i = 0; i < fewer.size(); i++) {
+            std::vector<uint32_t> found(neighbors.begin() + offsets[i], neighbors.begin() + offsets[i + 1]);
+            std::sort(found.begin(), found.end());
+            CHECK(found == BruteForce(fewer, fewer[i], 30.0f));
+        }
+    }
+}
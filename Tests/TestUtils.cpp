@@ -4,6 +4,8 @@
 
 #include "TestUtils.h"
 
+#include <cmath>
+#include <limits>
 #include <sstream>
 
 std::ostream &operator<<(std::ostream &os, const Vec4 &v) {
@@ -22,6 +24,33 @@ std::ostream &operator<<(std::ostream &os, const Quat &v) {
     return os << "{" << v.x << ", " << v.y << ", " << v.z << ", " << v.w << "}";
 }
 
+double UlpError(float value, double reference) {
+    const float magnitude = std::abs(static_cast<float>(reference));
+    const float spacing = magnitude == 0.0f ? std::numeric_limits<float>::denorm_min()
+                                            : std::nextafter(magnitude, std::numeric_limits<float>::infinity()) - magnitude;
+    return std::abs(static_cast<double>(value) - reference) / static_cast<double>(spacing);
+}
+
+std::vector<Vec4> CreateBoxPositions(const Vec4 &min, const Vec4 &max) {
+    // Digits are x, y, z, 1 takes max
+    const auto p = [&](int x, int y, int z) {
+        return Vec4{x ? max.x : min.x, y ? max.y : min.y, z ? max.z : min.z, 1.0f};
+    };
+    return {
+            // +x
+            p(1, 0, 1), p(1, 0, 0), p(1, 1, 1), p(1, 1, 1), p(1, 0, 0), p(1, 1, 0),
+            // -x
+            p(0, 0, 0), p(0, 0, 1), p(0, 1, 0), p(0, 1, 0), p(0, 0, 1), p(0, 1, 1),
+            // +y
+            p(0, 1, 1), p(1, 1, 1), p(0, 1, 0), p(0, 1, 0), p(1, 1, 1), p(1, 1, 0),
+            // -y
+            p(0, 0, 0), p(1, 0, 0), p(0, 0, 1), p(0, 0, 1), p(1, 0, 0), p(1, 0, 1),
+            // +z
+            p(0, 0, 1), p(1, 0, 1), p(0, 1, 1), p(0, 1, 1), p(1, 0, 1), p(1, 1, 1),
+            // -z
+            p(1, 0, 0), p(0, 0, 0), p(1, 1, 0), p(1, 1, 0), p(0, 0, 0), p(0, 1, 0)};
+}
+
 EqualsVec4::EqualsVec4(const Vec4 &vec, float epsilon)
     : vec{vec}, epsilon{epsilon} {}
 
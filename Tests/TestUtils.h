@@ -7,6 +7,7 @@
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 #include <catch2/matchers/catch_matchers_templated.hpp>
 #include <glm/mat4x4.hpp>
+#include <vector>
 
 #include "Mat4.h"
 #include "Quat.h"
@@ -20,6 +21,12 @@ std::ostream &operator<<(std::ostream &os, const Quat &v);
 
 using Catch::Matchers::WithinAbs;
 
+// Distance of value from reference in units of the float spacing at reference, denormal spacing near 0
+double UlpError(float value, double reference);
+
+// Triangle list positions of a box, with the counter-clockwise winding of CreateBox in Visualization
+std::vector<Vec4> CreateBoxPositions(const Vec4 &min, const Vec4 &max);
+
 struct EqualsVec4 : Catch::Matchers::MatcherGenericBase {
     explicit EqualsVec4(const Vec4 &vec, float epsilon = std::numeric_limits<float>::epsilon() * 100);
 
@@ -0,0 +1,183 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <vector>
+
+#include "Bvh.h"
+#include "TestUtils.h"
+#include "Triangle.h"
+
+using Catch::Matchers::WithinRel;
+
+// Same layout as the Vertex of Visualization
+struct Vertex {
+    Vec4 position;
+    Vec4 normal;
+};
+
+static std::vector<Vec4> RandomTriangles(size_t count, std::mt19937 &rng) {
+    std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> offset(-2.0f, 2.0f);
+    std::vector<Vec4> positions(count * 3);
+    for (size_t i = 0; i < count; i++) {
+        const Vec4 center{position(rng), position(rng), position(rng), 1.0f};
+        for (int corner = 0; corner < 3; corner++) positions[i * 3 + corner] = center + Vec4{offset(rng), offset(rng), offset(rng), 0.0f};
+    }
+    return positions;
+}
+
+static std::vector<Ray> RandomRays(size_t count, std::mt19937 &rng) {
+    std::uniform_real_distribution<float> position(-12.0f, 12.0f);
+    std::uniform_real_distribution<float> direction(-1.0f, 1.0f);
+    std::vector<Ray> rays(count);
+    for (Ray &ray: rays) {
+        ray = Ray{{position(rng), position(rng), position(rng), 1.0f},
+                  Vec4{direction(rng), direction(rng), direction(rng), 0.0f}.Normalize()};
+    }
+    return rays;
+}
+
+static TriangleHit BruteForce(const Ray &ray, const std::vector<Vec4> &positions) {
+    TriangleHit hit;
+    for (size_t i = 0; i < positions.size() / 3; i++) {
+        float t, u, v;
+        if (Intersect(ray, positions[i * 3], positions[i * 3 + 1], positions[i * 3 + 2], t, u, v) && t < hit.t) {
+            hit = {t, u, v, static_cast<uint32_t>(i)};
+        }
+    }
+    return hit;
+}
+
+TEST_CASE("Ray Triangle") {
+    SECTION("Single Triangle") {
+        const Vec4 v0{0.0f, 0.0f, 0.0f, 1.0f};
+        const Vec4 v1{1.0f, 0.0f, 0.0f, 1.0f};
+        const Vec4 v2{0.0f, 1.0f, 0.0f, 1.0f};
+        float t, u, v;
+
+        REQUIRE(Intersect(Ray{{0.25f, 0.5f, 2.0f, 1.0f}, {0.0f, 0.0f, -1.0f, 0.0f}}, v0, v1, v2, t, u, v));
+        CHECK_THAT(t, WithinAbs(2.0f, 1e-6));
+        CHECK_THAT(u, WithinAbs(0.25f, 1e-6));
+        CHECK_THAT(v, WithinAbs(0.5f, 1e-6));
+
+        // Back faces are hit too
+        CHECK(Intersect(Ray{{0.25f, 0.25f, -2.0f, 1.0f}, {0.0f, 0.0f, 1.0f, 0.0f}}, v0, v1, v2, t, u, v));
+        // Outside of the edges
+        CHECK_FALSE(Intersect(Ray{{0.75f, 0.75f, 2.0f, 1.0f}, {0.0f, 0.0f, -1.0f, 0.0f}}, v0, v1, v2, t, u, v));
+        // Behind the origin, beyond tMax, parallel
+        CHECK_FALSE(Intersect(Ray{{0.25f, 0.25f, 2.0f, 1.0f}, {0.0f, 0.0f, 1.0f, 0.0f}}, v0, v1, v2, t, u, v));
+        CHECK_FALSE(Intersect(Ray{{0.25f, 0.25f, 2.0f, 1.0f}, {0.0f, 0.0f, -1.0f, 0.0f}, 0.0f, 1.0f}, v0, v1, v2, t, u, v));
+        CHECK_FALSE(Intersect(Ray{{0.25f, 0.25f, 0.0f, 1.0f}, {1.0f, 0.0f, 0.0f, 0.0f}}, v0, v1, v2, t, u, v));
+    }
+
+    SECTION("8-wide Matches Scalar") {
+        std::mt19937 rng{31};
+        // 13 triangles, so the second block has padding lanes
+        const std::vector<Vec4> positions = RandomTriangles(13, rng);
+        const std::vector<TriangleBlock8> blocks = BuildTriangleBlocks(positions.data(), sizeof(Vec4), 13);
+        REQUIRE(blocks.size() == 2);
+
+        // Aim near the triangles so about half of the rays hit
+        std::uniform_real_distribution<float> jitter(-1.0f, 1.0f);
+        int hitCount = 0;
+        for (size_t i = 0; i < 4000; i++) {
+            const size_t target = i % 13;
+            const Vec4 centroid = (positions[target * 3] + positions[target * 3 + 1] + positions[target * 3 + 2]) * Vec4{1.0f / 3.0f};
+            const Vec4 origin{jitter(rng) * 20.0f, jitter(rng) * 20.0f, jitter(rng) * 20.0f, 1.0f};
+            const Vec4 aim = centroid + Vec4{jitter(rng), jitter(rng), jitter(rng), 0.0f};
+            const Ray ray{origin, Vec4{_mm_blend_ps((aim - origin).m, _mm_setzero_ps(), 0b1000)}.Normalize()};
+            for (size_t block = 0; block < blocks.size(); block++) {
+                __m256 t, u, v;
+                const int mask = Intersect(ray, blocks[block], t, u, v);
+                alignas(32) float ts[8], us[8], vs[8];
+                _mm256_store_ps(ts, t);
+                _mm256_store_ps(us, u);
+                _mm256_store_ps(vs, v);
+                for (int lane = 0; lane < 8; lane++) {
+                    const size_t triangle = block * 8 + lane;
+                    if (triangle >= 13) {
+                        CHECK_FALSE(mask & (1 << lane));
+                        continue;
+                    }
+                    float expectedT = 0.0f, expectedU = 0.0f, expectedV = 0.0f;
+                    const bool expected = Intersect(ray, positions[triangle * 3], positions[triangle * 3 + 1], positions[triangle * 3 + 2],
+                                                    expectedT, expectedU, expectedV);
+                    // Skip the grazing hits where rounding decides
+                    if (expected != static_cast<bool>(mask & (1 << lane))) {
+                        CHECK((std::fabs(expectedU) < 1e-4f || std::fabs(expectedV) < 1e-4f || std::fabs(expectedU + expectedV - 1.0f) < 1e-4f));
+                        continue;
+                    }
+                    if (!expected) continue;
+                    hitCount++;
+                    CHECK_THAT(ts[lane], WithinRel(expectedT, 1e-4f));
+                    CHECK_THAT(us[lane], WithinAbs(expectedU, 1e-4));
+                    CHECK_THAT(vs[lane], WithinAbs(expectedV, 1e-4));
+                }
+            }
+        }
+        CHECK(hitCount > 1000);
+    }
+
+    SECTION("Vertex Array") {
+        // Two triangles of the +z face of a unit box, in the winding of CreateBox
+        const Vec4 normal{0.0f, 0.0f, 1.0f, 0.0f};
+        const Vertex vertices[6]{
+                {{-1.0f, -1.0f, 1.0f, 1.0f}, normal},
+                {{1.0f, -1.0f, 1.0f, 1.0f}, normal},
+                {{-1.0f, 1.0f, 1.0f, 1.0f}, normal},
+                {{-1.0f, 1.0f, 1.0f, 1.0f}, normal},
+                {{1.0f, -1.0f, 1.0f, 1.0f}, normal},
+                {{1.0f, 1.0f, 1.0f, 1.0f}, normal},
+        };
+        const std::vector<TriangleBlock8> blocks = BuildTriangleBlocks(&vertices[0].position, sizeof(Vertex), 2);
+
+        TriangleHit hit;
+        REQUIRE(IntersectTriangles(Ray{{0.5f, 0.5f, 5.0f, 1.0f}, {0.0f, 0.0f, -1.0f, 0.0f}}, blocks.data(), 0, 2, hit));
+        CHECK(hit.triangle == 1);
+        CHECK_THAT(hit.t, WithinAbs(4.0f, 1e-6));
+
+        // The hit point from the barycentrics
+        const Vec4 &v0 = vertices[3].position;
+        const Vec4 &v1 = vertices[4].position;
+        const Vec4 &v2 = vertices[5].position;
+        const Vec4 point = v0 * Vec4{1.0f - hit.u - hit.v} + v1 * Vec4{hit.u} + v2 * Vec4{hit.v};
+        CHECK_THAT(point.x, WithinAbs(0.5f, 1e-6));
+        CHECK_THAT(point.y, WithinAbs(0.5f, 1e-6));
+
+        // Lanes outside of the range are ignored
+        TriangleHit other;
+        CHECK_FALSE(IntersectTriangles(Ray{{0.5f, 0.5f, 5.0f, 1.0f}, {0.0f, 0.0f, -1.0f, 0.0f}}, blocks.data(), 0, 1, other));
+    }
+
+    SECTION("Bvh Leaves") {
+        std::mt19937 rng{131};
+        constexpr size_t count = 2000;
+        const std::vector<Vec4> positions = RandomTriangles(count, rng);
+        std::vector<AABB> bounds(count, AABB::Empty());
+        for (size_t i = 0; i < count; i++) {
+            for (int corner = 0; corner < 3; corner++) bounds[i] = bounds[i].Union(positions[i * 3 + corner]);
+        }
+
+        const Bvh<8> bvh{bounds.data(), count, 8};
+        // Blocks in leaf order, so every leaf is a contiguous range of lanes
+        const std::vector<TriangleBlock8> blocks = BuildTriangleBlocks(positions.data(), sizeof(Vec4), count, bvh.Indices().data());
+
+        for (const Ray &ray: RandomRays(500, rng)) {
+            TriangleHit closest;
+            const auto intersectLeaf = [&](const Ray &leafRay, uint32_t first, uint32_t leafCount, BvhHit &hit) {
+                closest.t = hit.t;
+                if (!IntersectTriangles(leafRay, blocks.data(), first, leafCount, closest)) return false;
+                hit = {closest.t, bvh.Indices()[closest.triangle]};
+                return true;
+            };
+            const TriangleHit expected = BruteForce(ray, positions);
+            BvhHit hit;
+            const bool found = bvh.ClosestHit(ray, intersectLeaf, hit);
+            CHECK(found == (expected.triangle != UINT32_MAX));
+            if (found) CHECK_THAT(hit.t, WithinRel(expected.t, 1e-4f));
+        }
+    }
+}
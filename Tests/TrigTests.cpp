@@ -0,0 +1,43 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+
+#include "TestUtils.h"
+#include "Trig.h"
+
+TEST_CASE("Sin Cos") {
+    for (float x = -100.0f; x <= 100.0f; x += 0.0137f) {
+        __m128 s, c;
+        SinCos(_mm_set_ps1(x), s, c);
+        CHECK_THAT(_mm_cvtss_f32(s), WithinAbs(std::sin(x), 2e-7));
+        CHECK_THAT(_mm_cvtss_f32(c), WithinAbs(std::cos(x), 2e-7));
+    }
+}
+
+TEST_CASE("Atan2") {
+    for (float y = -3.0f; y <= 3.0f; y += 0.0625f) {
+        for (float x = -3.0f; x <= 3.0f; x += 0.0625f) {
+            const float expected = (x == 0.0f && y == 0.0f) ? 0.0f : std::atan2(y, x);
+            CHECK_THAT(_mm_cvtss_f32(Atan2(_mm_set_ps1(y), _mm_set_ps1(x))), WithinAbs(expected, 5e-7));
+        }
+    }
+
+    // Signed zeros, same as std::atan2
+    for (const float y: {0.0f, -0.0f}) {
+        for (const float x: {0.0f, -0.0f}) {
+            const float result = _mm_cvtss_f32(Atan2(_mm_set_ps1(y), _mm_set_ps1(x)));
+            CHECK(result == std::atan2(y, x));
+            CHECK(std::signbit(result) == std::signbit(std::atan2(y, x)));
+        }
+    }
+}
+
+TEST_CASE("Asin") {
+    for (float x = -1.0f; x <= 1.0f; x += 0.001f) {
+        CHECK_THAT(_mm_cvtss_f32(Asin(_mm_set_ps1(x))), WithinAbs(std::asin(x), 1e-6));
+    }
+    CHECK_THAT(_mm_cvtss_f32(Asin(_mm_set_ps1(1.0001f))), WithinAbs(M_PI_2, 1e-6));
+}
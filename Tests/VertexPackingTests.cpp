@@ -0,0 +1,101 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "MeshBounds.h"
+#include "TestUtils.h"
+#include "VertexPacking.h"
+
+// Same layout as the Vertex of Visualization
+struct Vertex {
+    Vec4 position;
+    Vec4 normal;
+};
+
+// 12 bytes instead of 32
+struct PackedVertex {
+    uint16_t position[4];
+    uint32_t normal;
+};
+
+TEST_CASE("Pack Positions") {
+    std::mt19937 rng{49};
+    std::uniform_real_distribution<float> value(-10.0f, 30.0f);
+    std::vector<Vertex> vertices(1001);
+    for (Vertex &vertex: vertices) vertex.position = {value(rng), value(rng) * 0.01f, value(rng), 1.0f};
+
+    const AABB bounds = ComputeAABB(&vertices[0].position, sizeof(Vertex), vertices.size());
+    const VertexPacking::Quantization quantization = VertexPacking::Quantization::FromBounds(bounds);
+    std::vector<PackedVertex> packed(vertices.size());
+    VertexPacking::PackPositions(&vertices[0].position, sizeof(Vertex), vertices.size(), quantization,
+                                 packed[0].position, sizeof(PackedVertex));
+    std::vector<Vec4> unpacked(vertices.size());
+    VertexPacking::UnpackPositions(packed[0].position, sizeof(PackedVertex), vertices.size(), quantization,
+                                   unpacked.data(), sizeof(Vec4));
+
+    // Half a step of each axis
+    const Vec4 tolerance = (bounds.max - bounds.min) * Vec4{0.5f / 65535.0f} + Vec4{1e-5f};
+    for (size_t i = 0; i < vertices.size(); i++) {
+        CHECK(packed[i].position[3] == 0);
+        for (int axis = 0; axis < 3; axis++) CHECK(std::abs(unpacked[i][axis] - vertices[i].position[axis]) <= tolerance[axis]);
+        CHECK(unpacked[i].w == 1.0f);
+    }
+
+    // The corners of the box are exact ends of the range
+    const Vec4 corners[2] = {bounds.min, bounds.max};
+    uint16_t ends[2][4];
+    VertexPacking::PackPositions(corners, sizeof(Vec4), 2, quantization, ends[0], sizeof(ends[0]));
+    for (int axis = 0; axis < 3; axis++) {
+        CHECK(ends[0][axis] == 0);
+        CHECK(ends[1][axis] == 65535);
+    }
+
+    // Flat along y, which packs to 0 instead of dividing by 0
+    const Vec4 flat[2] = {{1.0f, 2.0f, 3.0f, 1.0f}, {4.0f, 2.0f, 6.0f, 1.0f}};
+    const VertexPacking::Quantization flatQuantization = VertexPacking::Quantization::FromBounds(ComputeAABB(flat, sizeof(Vec4), 2));
+    VertexPacking::PackPositions(flat, sizeof(Vec4), 2, flatQuantization, ends[0], sizeof(ends[0]));
+    Vec4 flatUnpacked[2];
+    VertexPacking::UnpackPositions(ends[0], sizeof(ends[0]), 2, flatQuantization, flatUnpacked, sizeof(Vec4));
+    CHECK(ends[0][1] == 0);
+    CHECK(ends[1][1] == 0);
+    CHECK_THAT(flatUnpacked[0], EqualsVec4(flat[0]));
+    CHECK_THAT(flatUnpacked[1], EqualsVec4(flat[1]));
+}
+
+TEST_CASE("Pack Normals") {
+    // Bit layout of GL_INT_2_10_10_10_REV
+    const Vec4 axes[4] = {{1.0f, 0.0f, 0.0f, 0.0f}, {0.0f, -1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f, 0.0f}, {2.0f, -2.0f, 0.5f, 0.0f}};
+    uint32_t packedAxes[4];
+    VertexPacking::PackNormals(axes, sizeof(Vec4), 4, packedAxes, sizeof(uint32_t));
+    CHECK(packedAxes[0] == 511u);
+    CHECK(packedAxes[1] == 513u << 10);
+    CHECK(packedAxes[2] == 511u << 20);
+    // Clamped to [-1, 1]
+    CHECK(packedAxes[3] == (511u | 513u << 10 | 256u << 20));
+
+    std::mt19937 rng{49};
+    std::normal_distribution<float> direction;
+    std::vector<Vertex> vertices(1001);
+    for (Vertex &vertex: vertices) vertex.normal = Vec4{direction(rng), direction(rng), direction(rng), 0.0f}.Normalize();
+
+    std::vector<PackedVertex> packed(vertices.size());
+    VertexPacking::PackNormals(&vertices[0].normal, sizeof(Vertex), vertices.size(), &packed[0].normal, sizeof(PackedVertex));
+    std::vector<Vertex> unpacked(vertices.size());
+    VertexPacking::UnpackNormals(&packed[0].normal, sizeof(PackedVertex), vertices.size(), &unpacked[0].normal, sizeof(Vertex));
+    for (size_t i = 0; i < vertices.size(); i++) {
+        CHECK(packed[i].normal >> 30 == 0);
+        CHECK_THAT(unpacked[i].normal, EqualsVec4(vertices[i].normal, 0.5f / 511.0f + 1e-6f));
+        CHECK(unpacked[i].normal.w == 0.0f);
+    }
+
+    // -512 is the one code below -1, it decodes to -1
+    const uint32_t lowest = 512u;
+    Vec4 decoded;
+    VertexPacking::UnpackNormals(&lowest, sizeof(uint32_t), 1, &decoded, sizeof(Vec4));
+    CHECK_THAT(decoded, EqualsVec4({-1.0f, 0.0f, 0.0f, 0.0f}));
+}
@@ -0,0 +1,192 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#include "NullGL.h"
+
+#include <algorithm>
+#include <cstring>
+#include <glad/gl.h>
+#include <unordered_map>
+
+namespace NullGL {
+    // Keyed by the name literal of each stub, there's one per function
+    static std::unordered_map<const char *, CallStats> g_stats;
+
+    static std::unordered_map<GLuint, std::vector<unsigned char>> g_buffers;
+
+    static GLuint g_nextName = 1;
+
+    static void Record(const char *name, const uint64_t bytes = 0) {
+        CallStats &stats = g_stats.try_emplace(name, CallStats{name, 0, 0}).first->second;
+        stats.calls++;
+        stats.bytes += bytes;
+    }
+
+    static void GLAD_API_PTR CreateBuffers(const GLsizei n, GLuint *buffers) {
+        Record("glCreateBuffers");
+        for (GLsizei i = 0; i < n; i++) {
+            buffers[i] = g_nextName++;
+            g_buffers[buffers[i]];
+        }
+    }
+
+    static void GLAD_API_PTR DeleteBuffers(const GLsizei n, const GLuint *buffers) {
+        Record("glDeleteBuffers");
+        for (GLsizei i = 0; i < n; i++) g_buffers.erase(buffers[i]);
+    }
+
+    // Copies like a driver would, so uploads cost what they cost on the CPU side of a real one
+    static void Upload(const GLuint buffer, const GLsizeiptr size, const void *data) {
+        std::vector<unsigned char> &storage = g_buffers[buffer];
+        storage.resize(size);
+        if (data) memcpy(storage.data(), data, size);
+    }
+
+    static void GLAD_API_PTR NamedBufferData(const GLuint buffer, const GLsizeiptr size, const void *data, GLenum) {
+        Record("glNamedBufferData", size);
+        Upload(buffer, size, data);
+    }
+
+    static void GLAD_API_PTR NamedBufferStorage(const GLuint buffer, const GLsizeiptr size, const void *data, GLbitfield) {
+        Record("glNamedBufferStorage", size);
+        Upload(buffer, size, data);
+    }
+
+    static void *GLAD_API_PTR MapNamedBufferRange(const GLuint buffer, const GLintptr offset, GLsizeiptr, GLbitfield) {
+        Record("glMapNamedBufferRange");
+        return g_buffers[buffer].data() + offset;
+    }
+
+    static GLboolean GLAD_API_PTR UnmapNamedBuffer(GLuint) {
+        Record("glUnmapNamedBuffer");
+        return GL_TRUE;
+    }
+
+    static void GLAD_API_PTR CreateVertexArrays(const GLsizei n, GLuint *arrays) {
+        Record("glCreateVertexArrays");
+        for (GLsizei i = 0; i < n; i++) arrays[i] = g_nextName++;
+    }
+
+    static GLsync GLAD_API_PTR FenceSync(GLenum, GLbitfield) {
+        Record("glFenceSync");
+        // Never dereferenced, only has to be unique and non-null
+        return reinterpret_cast<GLsync>(static_cast<uintptr_t>(g_nextName++));
+    }
+
+    static GLenum GLAD_API_PTR ClientWaitSync(GLsync, GLbitfield, GLuint64) {
+        Record("glClientWaitSync");
+        return GL_ALREADY_SIGNALED;
+    }
+
+    static void GLAD_API_PTR ShaderSource(GLuint, const GLsizei count, const GLchar *const *string, const GLint *length) {
+        uint64_t bytes = 0;
+        for (GLsizei i = 0; i < count; i++) bytes += length && length[i] >= 0 ? length[i] : strlen(string[i]);
+        Record("glShaderSource", bytes);
+    }
+
+    static void GLAD_API_PTR GetShaderiv(GLuint, const GLenum pname, GLint *params) {
+        Record("glGetShaderiv");
+        *params = pname == GL_COMPILE_STATUS ? GL_TRUE : 0;
+    }
+
+    static void GLAD_API_PTR GetProgramiv(GLuint, const GLenum pname, GLint *params) {
+        Record("glGetProgramiv");
+        *params = pname == GL_LINK_STATUS ? GL_TRUE : 0;
+    }
+
+    static const GLubyte *GLAD_API_PTR GetString(const GLenum name) {
+        Record("glGetString");
+        switch (name) {
+            case GL_VERSION:
+                return reinterpret_cast<const GLubyte *>("4.6 NullGL");
+            case GL_SHADING_LANGUAGE_VERSION:
+                return reinterpret_cast<const GLubyte *>("4.60 NullGL");
+            default:
+                return reinterpret_cast<const GLubyte *>("NullGL");
+        }
+    }
+
+    static void GLAD_API_PTR ProgramUniformMatrix4fv(GLuint, GLint, const GLsizei count, GLboolean, const GLfloat *) {
+        Record("glProgramUniformMatrix4fv", count * 16 * sizeof(GLfloat));
+    }
+
+    static void GLAD_API_PTR GetIntegerv(const GLenum pname, GLint *data) {
+        Record("glGetIntegerv");
+        // The common offset alignment of desktop drivers
+        *data = pname == GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT || pname == GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT ? 256 : 0;
+    }
+
+    void Load() {
+        glad_glCreateBuffers = CreateBuffers;
+        glad_glDeleteBuffers = DeleteBuffers;
+        glad_glNamedBufferData = NamedBufferData;
+        glad_glNamedBufferStorage = NamedBufferStorage;
+        glad_glMapNamedBufferRange = MapNamedBufferRange;
+        glad_glUnmapNamedBuffer = UnmapNamedBuffer;
+        glad_glCreateVertexArrays = CreateVertexArrays;
+        glad_glFenceSync = FenceSync;
+        glad_glClientWaitSync = ClientWaitSync;
+        glad_glShaderSource = ShaderSource;
+        glad_glGetShaderiv = GetShaderiv;
+        glad_glGetProgramiv = GetProgramiv;
+        glad_glGetString = GetString;
+        glad_glGetIntegerv = GetIntegerv;
+        glad_glProgramUniformMatrix4fv = ProgramUniformMatrix4fv;
+
+        // Names for the objects without storage
+        glad_glCreateShader = [](GLenum) -> GLuint {
+            Record("glCreateShader");
+            return g_nextName++;
+        };
+        glad_glCreateProgram = []() -> GLuint {
+            Record("glCreateProgram");
+            return g_nextName++;
+        };
+        glad_glGetUniformLocation = [](GLuint, const GLchar *) -> GLint {
+            Record("glGetUniformLocation");
+            return 0;
+        };
+
+        // Everything else only counts
+        glad_glAttachShader = [](GLuint, GLuint) { Record("glAttachShader"); };
+        glad_glBindBufferRange = [](GLenum, GLuint, GLuint, GLintptr, GLsizeiptr) { Record("glBindBufferRange"); };
+        glad_glBindVertexArray = [](GLuint) { Record("glBindVertexArray"); };
+        glad_glClear = [](GLbitfield) { Record("glClear"); };
+        glad_glClearColor = [](GLfloat, GLfloat, GLfloat, GLfloat) { Record("glClearColor"); };
+        glad_glCompileShader = [](GLuint) { Record("glCompileShader"); };
+        glad_glDeleteProgram = [](GLuint) { Record("glDeleteProgram"); };
+        glad_glDeleteShader = [](GLuint) { Record("glDeleteShader"); };
+        glad_glDeleteSync = [](GLsync) { Record("glDeleteSync"); };
+        glad_glDeleteVertexArrays = [](GLsizei, const GLuint *) { Record("glDeleteVertexArrays"); };
+        glad_glDetachShader = [](GLuint, GLuint) { Record("glDetachShader"); };
+        glad_glDrawArrays = [](GLenum, GLint, GLsizei) { Record("glDrawArrays"); };
+        glad_glDrawArraysInstanced = [](GLenum, GLint, GLsizei, GLsizei) { Record("glDrawArraysInstanced"); };
+        glad_glDrawElements = [](GLenum, GLsizei, GLenum, const void *) { Record("glDrawElements"); };
+        glad_glDrawElementsInstanced = [](GLenum, GLsizei, GLenum, const void *, GLsizei) { Record("glDrawElementsInstanced"); };
+        glad_glEnable = [](GLenum) { Record("glEnable"); };
+        glad_glEnableVertexArrayAttrib = [](GLuint, GLuint) { Record("glEnableVertexArrayAttrib"); };
+        glad_glGetProgramInfoLog = [](GLuint, GLsizei, GLsizei *, GLchar *) { Record("glGetProgramInfoLog"); };
+        glad_glGetShaderInfoLog = [](GLuint, GLsizei, GLsizei *, GLchar *) { Record("glGetShaderInfoLog"); };
+        glad_glLinkProgram = [](GLuint) { Record("glLinkProgram"); };
+        glad_glUseProgram = [](GLuint) { Record("glUseProgram"); };
+        glad_glVertexArrayAttribBinding = [](GLuint, GLuint, GLuint) { Record("glVertexArrayAttribBinding"); };
+        glad_glVertexArrayAttribFormat = [](GLuint, GLuint, GLint, GLenum, GLboolean, GLuint) { Record("glVertexArrayAttribFormat"); };
+        glad_glVertexArrayElementBuffer = [](GLuint, GLuint) { Record("glVertexArrayElementBuffer"); };
+        glad_glVertexArrayBindingDivisor = [](GLuint, GLuint, GLuint) { Record("glVertexArrayBindingDivisor"); };
+        glad_glVertexArrayVertexBuffer = [](GLuint, GLuint, GLuint, GLintptr, GLsizei) { Record("glVertexArrayVertexBuffer"); };
+        glad_glViewport = [](GLint, GLint, GLsizei, GLsizei) { Record("glViewport"); };
+    }
+
+    void ResetStats() {
+        g_stats.clear();
+    }
+
+    std::vector<CallStats> CollectStats() {
+        std::vector<CallStats> stats;
+        stats.reserve(g_stats.size());
+        for (const auto &[name, entry]: g_stats) stats.push_back(entry);
+        std::sort(stats.begin(), stats.end(), [](const CallStats &a, const CallStats &b) { return strcmp(a.name, b.name) < 0; });
+        return stats;
+    }
+}
@@ -0,0 +1,27 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Headless OpenGL backend, the glad entry points used by the Visualization record calls instead of rendering
+// Buffers are plain host memory, so mapped pointers are writable, everything else is a no-op
+namespace NullGL {
+    struct CallStats {
+        const char *name;
+        uint64_t calls;
+        // Data passed to the call, buffer uploads, uniforms and shader sources
+        uint64_t bytes;
+    };
+
+    // Replaces gladLoadGL, needs no window or context
+    void Load();
+
+    void ResetStats();
+
+    // Sorted by name, only functions that were called since the last reset
+    std::vector<CallStats> CollectStats();
+}
@@ -0,0 +1,63 @@
+//
+// Created by andyroiiid on 10/19/2026.
+//
+
+#pragma once
+
+#include <glad/gl.h>
+#include <immintrin.h>
+#include <type_traits>
+
+#include "Movable.h"
+#include "VertexBuffer.h"
+
+// Shader parameters as uniform or shader storage blocks in a StreamBuffer, one bulk write per frame
+// Block is a struct of Mat4 and Vec4 members, which is already the std140 and std430 layout of mat4 and vec4 members
+template<typename Block, int FRAMES = 3>
+class ParameterBlocks {
+public:
+    static_assert(std::is_trivially_copyable_v<Block>);
+    static_assert(alignof(Block) >= 16 && sizeof(Block) % 16 == 0, "std140 rounds blocks up to vec4");
+
+    MOVABLE(ParameterBlocks)
+
+    ParameterBlocks() = default;
+
+    // target is GL_UNIFORM_BUFFER or GL_SHADER_STORAGE_BUFFER, capacity is the number of blocks per frame
+    ParameterBlocks(const GLenum target, const size_t capacity)
+        : m_target(target) {
+        // Every block starts at an offset BindRange accepts
+        GLint alignment = 0;
+        glGetIntegerv(target == GL_UNIFORM_BUFFER ? GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT : GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        const size_t align = alignment > 16 ? alignment : 16;
+        m_stride = (sizeof(Block) + align - 1) / align * align;
+        m_stream = StreamBuffer<uint8_t, FRAMES>(capacity * m_stride);
+    }
+
+    // Starts the blocks of the next frame, waits if the GPU still reads them
+    // False when count exceeds the capacity, nothing may be stored then
+    [[nodiscard]] bool Map(const size_t count) {
+        m_data = m_stream.Map(count * m_stride);
+        return m_data != nullptr;
+    }
+
+    // Aligned SIMD copy into the mapped buffer, written once and never read back
+    void Store(const size_t i, const Block &block) {
+        const auto *src = reinterpret_cast<const float *>(&block);
+        auto *dst = reinterpret_cast<float *>(m_data + i * m_stride);
+        for (size_t offset = 0; offset < sizeof(Block) / sizeof(float); offset += 4) {
+            _mm_store_ps(dst + offset, _mm_load_ps(src + offset));
+        }
+    }
+
+    // Block i of the last Map for the draws that follow
+    void BindRange(const GLuint binding, const size_t i) const {
+        glBindBufferRange(m_target, binding, m_stream.Buffer(), m_stream.Offset() + static_cast<GLintptr>(i * m_stride), sizeof(Block));
+    }
+
+protected:
+    StreamBuffer<uint8_t, FRAMES> m_stream;
+    Movable<uint8_t *> m_data;
+    Movable<GLenum> m_target;
+    Movable<size_t> m_stride;
+};
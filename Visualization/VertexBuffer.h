@@ -1,9 +1,78 @@
 ﻿#pragma once
 
+#include <cstdint>
+#include <cstdio>
 #include <glad/gl.h>
 
 #include "Movable.h"
 
+// Persistently mapped buffer split into FRAMES regions used round-robin
+// The CPU writes straight into one region while the GPU still reads the previous ones, fences keep them apart
+template<typename Element, int FRAMES = 3>
+class StreamBuffer {
+public:
+    MOVABLE(StreamBuffer)
+
+    StreamBuffer() = default;
+
+    explicit StreamBuffer(const size_t capacity)
+        : m_capacity(capacity) {
+        const GLsizeiptr size = static_cast<GLsizeiptr>(FRAMES * capacity * sizeof(Element));
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glCreateBuffers(1, &m_buffer);
+        glNamedBufferStorage(m_buffer, size, nullptr, flags);
+        m_data = static_cast<Element *>(glMapNamedBufferRange(m_buffer, 0, size, flags));
+    }
+
+    ~StreamBuffer() {
+        for (Movable<GLsync> &fence: m_fences) {
+            if (fence) glDeleteSync(fence);
+        }
+        if (m_buffer) {
+            glUnmapNamedBuffer(m_buffer);
+            glDeleteBuffers(1, &m_buffer);
+        }
+    }
+
+    // Region for the next count elements, write it before issuing the draws that read it
+    // Fences the draws issued since the last Map, then waits until the GPU is done with the region from FRAMES maps ago
+    Element *Map(const size_t count) {
+        if (count > m_capacity) {
+            fprintf(stderr, "StreamBuffer::Map: %zu elements exceed the capacity of %zu\n", count, static_cast<size_t>(m_capacity));
+            return nullptr;
+        }
+
+        m_fences[m_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        m_region = (m_region + 1) % FRAMES;
+        if (m_fences[m_region]) {
+            // Only stalls when the CPU runs FRAMES frames ahead of the GPU
+            while (glClientWaitSync(m_fences[m_region], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED) {}
+            glDeleteSync(m_fences[m_region]);
+            m_fences[m_region] = nullptr;
+        }
+
+        m_count = static_cast<GLsizei>(count);
+        return m_data + m_region * m_capacity;
+    }
+
+    [[nodiscard]] GLuint Buffer() const { return m_buffer; }
+
+    // Byte offset of the region returned by the last Map
+    [[nodiscard]] GLintptr Offset() const { return static_cast<GLintptr>(m_region * m_capacity * sizeof(Element)); }
+
+    [[nodiscard]] GLsizei Stride() const { return sizeof(Element); }
+
+    [[nodiscard]] GLsizei Count() const { return m_count; }
+
+protected:
+    Movable<GLuint> m_buffer;
+    Movable<Element *> m_data;
+    Movable<size_t> m_capacity;
+    Movable<GLsizei> m_count;
+    Movable<int> m_region;
+    Movable<GLsync> m_fences[FRAMES];
+};
+
 template<typename Vertex>
 class VertexBuffer {
 public:
@@ -23,8 +92,15 @@ public:
         UpdateData(count, data, GL_STATIC_DRAW);
     }
 
+    template<typename Index>
+    VertexBuffer(const size_t count, const Vertex *data, const size_t indexCount, const Index *indices)
+        : VertexBuffer(count, data) {
+        UpdateIndices(indexCount, indices, GL_STATIC_DRAW);
+    }
+
     ~VertexBuffer() {
         if (m_vbo) glDeleteBuffers(1, &m_vbo);
+        if (m_ibo) glDeleteBuffers(1, &m_ibo);
         if (m_vao) glDeleteVertexArrays(1, &m_vao);
     }
 
@@ -33,15 +109,68 @@ public:
         glNamedBufferData(m_vbo, count * sizeof(Vertex), data, usage);
     }
 
+    // Streaming mode, draws the vertices written to the last Map of stream
+    // No reallocation, driver copy or implicit sync, unlike respecifying the data every frame
+    template<int FRAMES>
+    void UpdateData(const StreamBuffer<Vertex, FRAMES> &stream) {
+        m_count = stream.Count();
+        glVertexArrayVertexBuffer(m_vao, 0, stream.Buffer(), stream.Offset(), stream.Stride());
+    }
+
+    // Draws are indexed from then on, 16-bit indices halve the index buffer when there are at most 65536 vertices
+    void UpdateIndices(const size_t count, const uint16_t *indices, const GLenum usage = GL_DYNAMIC_DRAW) {
+        SetIndexData(count, indices, sizeof(uint16_t), GL_UNSIGNED_SHORT, usage);
+    }
+
+    void UpdateIndices(const size_t count, const uint32_t *indices, const GLenum usage = GL_DYNAMIC_DRAW) {
+        SetIndexData(count, indices, sizeof(uint32_t), GL_UNSIGNED_INT, usage);
+    }
+
     void BindAndDraw(const GLenum mode) const {
         glBindVertexArray(m_vao);
-        glDrawArrays(mode, 0, m_count);
+        if (m_ibo) {
+            glDrawElements(mode, m_indexCount, m_indexType, nullptr);
+        } else {
+            glDrawArrays(mode, 0, m_count);
+        }
+    }
+
+    // Attributes on bindingIndex advance once per instance instead of once per vertex
+    // Set the stream again after every Map, its offset changes
+    template<typename Instance, int FRAMES>
+    void SetInstanceBuffer(const StreamBuffer<Instance, FRAMES> &instances, const GLuint bindingIndex) {
+        glVertexArrayVertexBuffer(m_vao, bindingIndex, instances.Buffer(), instances.Offset(), instances.Stride());
+        glVertexArrayBindingDivisor(m_vao, bindingIndex, 1);
+    }
+
+    [[nodiscard]] GLuint VertexArray() const { return m_vao; }
+
+    void BindAndDrawInstanced(const GLenum mode, const GLsizei instanceCount) const {
+        glBindVertexArray(m_vao);
+        if (m_ibo) {
+            glDrawElementsInstanced(mode, m_indexCount, m_indexType, nullptr, instanceCount);
+        } else {
+            glDrawArraysInstanced(mode, 0, m_count, instanceCount);
+        }
     }
 
 protected:
+    void SetIndexData(const size_t count, const void *indices, const size_t indexSize, const GLenum type, const GLenum usage) {
+        if (!m_ibo) {
+            glCreateBuffers(1, &m_ibo);
+            glVertexArrayElementBuffer(m_vao, m_ibo);
+        }
+        m_indexCount = static_cast<GLsizei>(count);
+        m_indexType = type;
+        glNamedBufferData(m_ibo, count * indexSize, indices, usage);
+    }
+
     Movable<GLuint> m_vbo;
+    Movable<GLuint> m_ibo;
     Movable<GLuint> m_vao;
     Movable<GLsizei> m_count;
+    Movable<GLsizei> m_indexCount;
+    Movable<GLenum> m_indexType;
 };
 
 static void SetupVertexArrayAttrib(
@@ -64,4 +193,34 @@ static void SetupVertexArrayFloatsAttrib(
         const GLint size,
         const GLuint relativeOffset) {
     SetupVertexArrayAttrib(vao, attribIndex, bindingIndex, size, GL_FLOAT, GL_FALSE, relativeOffset);
-}
\ No newline at end of file
+}
+
+// 16-bit unsigned normalized, like the positions of VertexPacking::PackPositions
+static void SetupVertexArrayUnorm16Attrib(
+        const GLuint vao,
+        const GLuint attribIndex,
+        const GLuint bindingIndex,
+        const GLint size,
+        const GLuint relativeOffset) {
+    SetupVertexArrayAttrib(vao, attribIndex, bindingIndex, size, GL_UNSIGNED_SHORT, GL_TRUE, relativeOffset);
+}
+
+// xyz in one signed normalized 2_10_10_10 word, like the normals of VertexPacking::PackNormals
+static void SetupVertexArrayPackedNormalAttrib(
+        const GLuint vao,
+        const GLuint attribIndex,
+        const GLuint bindingIndex,
+        const GLuint relativeOffset) {
+    SetupVertexArrayAttrib(vao, attribIndex, bindingIndex, 4, GL_INT_2_10_10_10_REV, GL_TRUE, relativeOffset);
+}
+
+// A mat4 attribute takes 4 consecutive locations, one per column
+static void SetupVertexArrayMat4Attrib(
+        const GLuint vao,
+        const GLuint attribIndex,
+        const GLuint bindingIndex,
+        const GLuint relativeOffset) {
+    for (GLuint column = 0; column < 4; column++) {
+        SetupVertexArrayFloatsAttrib(vao, attribIndex + column, bindingIndex, 4, relativeOffset + column * 4 * sizeof(float));
+    }
+}
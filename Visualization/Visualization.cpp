@@ -3,11 +3,25 @@
 //
 
 #include <GLFW/glfw3.h>
-#include <Quat.h>
+#include <Instrumentation.h>
+#include <MeshBounds.h>
+#include <MeshIndexing.h>
+#include <Parallel.h>
+#include <QuatBatch.h>
+#include <VertexPacking.h>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdint>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <glad/gl.h>
+#include <random>
 #include <vector>
 
+#include "NullGL.h"
+#include "ParameterBlocks.h"
 #include "Shader.h"
 #include "VertexBuffer.h"
 
@@ -15,16 +29,25 @@ const char *VERTEX_SHADER_SOURCE = R"GLSL(
 #version 450 core
 layout (location = 0) in vec4 aPosition;
 layout (location = 1) in vec4 aNormal;
+layout (location = 2) in mat4 aModel;
 
 layout (location = 0) out vec4 vNormal;
 
-layout (location = 0) uniform mat4 uModel;
-layout (location = 1) uniform mat4 uView;
-layout (location = 2) uniform mat4 uProjection;
+layout (std140, binding = 0) uniform FrameParameters {
+    mat4 uView;
+    mat4 uProjection;
+};
+
+layout (std140, binding = 1) uniform DrawParameters {
+    // VertexPacking::Quantization of the mesh
+    vec4 uPositionOffset;
+    vec4 uPositionScale;
+};
 
 void main() {
-    gl_Position = uProjection * uView * uModel * aPosition;
-    vNormal = uModel * aNormal;
+    vec4 position = vec4(aPosition.xyz * uPositionScale.xyz + uPositionOffset.xyz, 1.0);
+    gl_Position = uProjection * uView * aModel * position;
+    vNormal = vec4(mat3(aModel) * aNormal.xyz, 0.0);
 }
 )GLSL";
 
@@ -39,16 +62,44 @@ void main() {
 }
 )GLSL";
 
+// Meshes are built with full precision vertices
 struct Vertex {
     Vec4 position;
     Vec4 normal;
+};
+
+// What gets uploaded, 12 bytes instead of 32
+struct PackedVertex {
+    // Quantized against the bounds of the mesh, w is unused
+    uint16_t position[4];
+    uint32_t normal;
     static void SetupVertexArray(GLuint vao) {
-        SetupVertexArrayFloatsAttrib(vao, 0, 0, 3, offsetof(Vertex, position));
-        SetupVertexArrayFloatsAttrib(vao, 1, 0, 3, offsetof(Vertex, normal));
+        SetupVertexArrayUnorm16Attrib(vao, 0, 0, 3, offsetof(PackedVertex, position));
+        SetupVertexArrayPackedNormalAttrib(vao, 1, 0, offsetof(PackedVertex, normal));
     }
 };
 
-using Vertices = VertexBuffer<Vertex>;
+using Vertices = VertexBuffer<PackedVertex>;
+
+// Same members in the same order as the blocks of VERTEX_SHADER_SOURCE
+struct FrameParameters {
+    Mat4 view;
+    Mat4 projection;
+};
+
+struct DrawParameters {
+    Vec4 positionOffset;
+    Vec4 positionScale;
+};
+
+// Once per frame, bound at 0
+using FrameBlocks = ParameterBlocks<FrameParameters>;
+
+// Once per draw, bound at 1
+using DrawBlocks = ParameterBlocks<DrawParameters>;
+
+// Model matrices, one per box, rewritten every frame
+using Instances = StreamBuffer<Mat4>;
 
 std::vector<Vertex> CreateBox(const Vec4 &min, const Vec4 &max) {
     const Vec4 p000{_mm_blend_ps(min.m, max.m, 0b0000)};
@@ -119,9 +170,37 @@ public:
     NO_MOVE_OR_COPY(App)
 
     App() {
-        std::vector<Vertex> vertices = CreateBox({-1.0f, -1.0f, -1.0f, 1.0f},
-                                                 {1.0f, 1.0f, 1.0f, 1.0f});
-        m_vertices = Vertices(vertices.size(), vertices.data());
+        // 36 corners of 24 distinct vertices
+        const std::vector<Vertex> box = CreateBox({-1.0f, -1.0f, -1.0f, 1.0f},
+                                                  {1.0f, 1.0f, 1.0f, 1.0f});
+        std::vector<Vertex> vertices;
+        std::vector<uint16_t> indices;
+        MeshIndexing::Weld(box.data(), box.size(), vertices, indices);
+        indices = MeshIndexing::OptimizeVertexCache(indices.data(), indices.size(), vertices.size());
+
+        const VertexPacking::Quantization quantization =
+                VertexPacking::Quantization::FromBounds(ComputeAABB(&vertices[0].position, sizeof(Vertex), vertices.size()));
+        std::vector<PackedVertex> packed(vertices.size());
+        VertexPacking::PackPositions(&vertices[0].position, sizeof(Vertex), vertices.size(), quantization,
+                                     packed[0].position, sizeof(PackedVertex));
+        VertexPacking::PackNormals(&vertices[0].normal, sizeof(Vertex), vertices.size(), &packed[0].normal, sizeof(PackedVertex));
+        m_vertices = Vertices(packed.size(), packed.data(), indices.size(), indices.data());
+        m_boxParameters = {quantization.offset, quantization.scale};
+        SetupVertexArrayMat4Attrib(m_vertices.VertexArray(), 2, 1, 0);
+
+        // Boxes on a grid centered at the origin, each spinning around its own axis
+        std::mt19937 random{42};
+        std::uniform_real_distribution<float> axis{-1.0f, 1.0f};
+        std::uniform_real_distribution<float> speed{0.5f, 3.0f};
+        for (size_t i = 0; i < BOX_COUNT; i++) {
+            m_axisX[i] = axis(random);
+            m_axisY[i] = axis(random);
+            m_axisZ[i] = axis(random) + 0.01f;
+            m_speeds[i] = speed(random);
+            m_positionX[i] = (static_cast<float>(i % GRID_SIZE) - 0.5f * (GRID_SIZE - 1)) * GRID_SPACING;
+            m_positionY[i] = (static_cast<float>(i / GRID_SIZE % GRID_SIZE) - 0.5f * (GRID_SIZE - 1)) * GRID_SPACING;
+            m_positionZ[i] = (static_cast<float>(i / (GRID_SIZE * GRID_SIZE)) - 0.5f * (GRID_SIZE - 1)) * GRID_SPACING;
+        }
 
         glEnable(GL_DEPTH_TEST);
     }
@@ -129,30 +208,94 @@ public:
     ~App() = default;
 
     void MainLoop(GLFWwindow *window) {
+        PROFILE_THREAD_NAME("Main");
         double prevTime = glfwGetTime();
+        uint64_t frame = 0;
         while (!glfwWindowShouldClose(window)) {
-            glfwPollEvents();
-            double currTime = glfwGetTime();
-            int width, height;
-            glfwGetFramebufferSize(window, &width, &height);
-            Frame(static_cast<float>(currTime - prevTime), width, height);
-            prevTime = currTime;
-            glfwSwapBuffers(window);
+            PROFILE_MARK("Frame", frame++);
+            {
+                PROFILE_SCOPE("App::MainLoop");
+                glfwPollEvents();
+                double currTime = glfwGetTime();
+                int width, height;
+                glfwGetFramebufferSize(window, &width, &height);
+                Frame(static_cast<float>(currTime - prevTime), width, height);
+                prevTime = currTime;
+                {
+                    PROFILE_SCOPE("glfwSwapBuffers");
+                    glfwSwapBuffers(window);
+                }
+            }
+#ifdef SIMD_INSTRUMENTATION
+            PrintProfile();
+            // F12 saves the trace of the last frames, it's saved on exit too
+            const bool traceKey = glfwGetKey(window, GLFW_KEY_F12) == GLFW_PRESS;
+            if (traceKey && !m_traceKey) SaveTrace();
+            m_traceKey = traceKey;
+#endif
         }
+#ifdef SIMD_INSTRUMENTATION
+        SaveTrace();
+#endif
     }
 
-private:
+    [[nodiscard]] unsigned WorkerCount() const { return m_workers.ThreadCount(); }
+
     void Frame(float DeltaTime, int width, int height) {
-        m_rotation = Quat{{1.0f, 1.0f, 1.0f, 0.0f}, DeltaTime} * m_rotation;
+        PROFILE_SCOPE("App::Frame");
+        m_time += DeltaTime;
+
+        // Angles from the total time rather than accumulated rotations, so nothing drifts away from unit length
+        {
+            PROFILE_SCOPE("App::Frame rotations");
+            m_workers.For(BOX_COUNT, PARALLEL_RANGE, [this](size_t, size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) m_angles[i] = m_speeds[i] * m_time;
+                QuatBatch::FromAxisAngle(end - begin,
+                                         {m_axisX.data() + begin, m_axisY.data() + begin, m_axisZ.data() + begin},
+                                         m_angles.data() + begin,
+                                         {m_rotationX.data() + begin, m_rotationY.data() + begin, m_rotationZ.data() + begin, m_rotationW.data() + begin});
+            });
+        }
+
+        Mat4 *models;
+        {
+            PROFILE_SCOPE("App::Frame map");
+            models = m_instances.Map(BOX_COUNT);
+            // Map already printed why, nothing is drawn this frame
+            if (!models) return;
+            m_vertices.SetInstanceBuffer(m_instances, 1);
+        }
+
+        // Written straight into the mapped buffer, there is no upload
+        {
+            PROFILE_SCOPE("App::Frame matrices");
+            m_workers.For(BOX_COUNT, PARALLEL_RANGE, [this, models](size_t, size_t begin, size_t end) {
+                const Vec3SoA positions{m_positionX.data() + begin, m_positionY.data() + begin, m_positionZ.data() + begin};
+                QuatBatch::ToMat4(end - begin,
+                                  {m_rotationX.data() + begin, m_rotationY.data() + begin, m_rotationZ.data() + begin, m_rotationW.data() + begin},
+                                  &positions,
+                                  models + begin);
+            });
+        }
 
-        const Mat4 lookAt = Mat4::LookAt({1.0f, 2.0f, 3.0f, 1.0f},
-                                         {0.0f, 0.0f, 0.0f, 1.0f},
-                                         {0.0f, 1.0f, 0.0f, 0.0f});
+        // Every block of the frame is written before any draw, then each draw only binds a range
+        {
+            PROFILE_SCOPE("App::Frame parameters");
+            const Mat4 lookAt = Mat4::LookAt({120.0f, 90.0f, 160.0f, 1.0f},
+                                             {0.0f, 0.0f, 0.0f, 1.0f},
+                                             {0.0f, 1.0f, 0.0f, 0.0f});
+
+            const Mat4 perspective = Mat4::Perspective(M_PI / 3.0f,
+                                                       static_cast<float>(width) / static_cast<float>(height),
+                                                       1.0f,
+                                                       1000.0f);
+
+            if (!m_frameBlocks.Map(1) || !m_drawBlocks.Map(1)) return;
+            m_frameBlocks.Store(0, {lookAt, perspective});
+            m_drawBlocks.Store(0, m_boxParameters);
+        }
 
-        const Mat4 perspective = Mat4::Perspective(M_PI / 3.0f,
-                                                   static_cast<float>(width) / static_cast<float>(height),
-                                                   0.1f,
-                                                   100.0f);
+        PROFILE_SCOPE("App::Frame GL");
 
         glViewport(0, 0, width, height);
         glClearColor(0.2f, 0.2f, 0.2f, 1.0f);
@@ -160,23 +303,132 @@ private:
 
         m_shader.Use();
 
-        m_shader.SetUniform(m_modelLocation, m_rotation.ToMat4());
-        m_shader.SetUniform(m_viewLocation, lookAt);
-        m_shader.SetUniform(m_projectionLocation, perspective);
+        m_frameBlocks.BindRange(0, 0);
+        m_drawBlocks.BindRange(1, 0);
+
+        m_vertices.BindAndDrawInstanced(GL_TRIANGLES, m_instances.Count());
+    }
+
+private:
+#ifdef SIMD_INSTRUMENTATION
+    // Time per frame of every scope over the last second, SimdMath kernels included
+    void PrintProfile() {
+        m_profileFrames++;
+        const double time = glfwGetTime();
+        if (time - m_profileTime < 1.0) return;
+
+        const std::vector<Instrumentation::ProfileEntry> profile = Instrumentation::CollectProfile();
+        const double msPerTick = 1000.0 / Instrumentation::TicksPerSecond();
+        const auto frames = static_cast<double>(m_profileFrames);
+        printf("%d frames\n", m_profileFrames);
+        for (size_t i = 0; i < profile.size(); i++) {
+            const uint64_t calls = profile[i].calls - (i < m_profile.size() ? m_profile[i].calls : 0);
+            const uint64_t ticks = profile[i].ticks - (i < m_profile.size() ? m_profile[i].ticks : 0);
+            if (calls == 0) continue;
+            printf("  %-32s %8.2f calls/frame %8.3f ms/frame\n", profile[i].name,
+                   static_cast<double>(calls) / frames, static_cast<double>(ticks) * msPerTick / frames);
+        }
+
+        m_profile = profile;
+        m_profileTime = time;
+        m_profileFrames = 0;
+    }
 
-        m_vertices.BindAndDraw(GL_TRIANGLES);
+    static void SaveTrace() {
+        if (Instrumentation::WriteChromeTrace("trace.json")) {
+            printf("Saved trace.json, open it in https://ui.perfetto.dev\n");
+        } else {
+            printf("Failed to save trace.json\n");
+        }
     }
 
+    std::vector<Instrumentation::ProfileEntry> m_profile;
+    double m_profileTime = 0.0;
+    int m_profileFrames = 0;
+    bool m_traceKey = false;
+#endif
+
+    static constexpr size_t BOX_COUNT = 100000;
+    // Smallest cube that fits every box
+    static constexpr size_t GRID_SIZE = 47;
+    static constexpr float GRID_SPACING = 4.0f;
+    static constexpr size_t PARALLEL_RANGE = 4096;
+
+    // Started once, so frames don't pay for starting and joining threads
+    WorkerPool m_workers;
     Vertices m_vertices;
+    Instances m_instances{BOX_COUNT};
     Shader m_shader{VERTEX_SHADER_SOURCE, FRAGMENT_SHADER_SOURCE};
-    GLint m_modelLocation = m_shader.GetUniformLocation("uModel");
-    GLint m_viewLocation = m_shader.GetUniformLocation("uView");
-    GLint m_projectionLocation = m_shader.GetUniformLocation("uProjection");
-
-    Quat m_rotation;
+    FrameBlocks m_frameBlocks{GL_UNIFORM_BUFFER, 1};
+    DrawBlocks m_drawBlocks{GL_UNIFORM_BUFFER, 1};
+    DrawParameters m_boxParameters;
+
+    float m_time = 0.0f;
+    // Per-box state in SoA layout for the QuatBatch kernels
+    std::vector<float> m_axisX = std::vector<float>(BOX_COUNT);
+    std::vector<float> m_axisY = std::vector<float>(BOX_COUNT);
+    std::vector<float> m_axisZ = std::vector<float>(BOX_COUNT);
+    std::vector<float> m_speeds = std::vector<float>(BOX_COUNT);
+    std::vector<float> m_angles = std::vector<float>(BOX_COUNT);
+    std::vector<float> m_rotationX = std::vector<float>(BOX_COUNT);
+    std::vector<float> m_rotationY = std::vector<float>(BOX_COUNT);
+    std::vector<float> m_rotationZ = std::vector<float>(BOX_COUNT);
+    std::vector<float> m_rotationW = std::vector<float>(BOX_COUNT);
+    std::vector<float> m_positionX = std::vector<float>(BOX_COUNT);
+    std::vector<float> m_positionY = std::vector<float>(BOX_COUNT);
+    std::vector<float> m_positionZ = std::vector<float>(BOX_COUNT);
 };
 
-int main() {
+// CPU cost of App::Frame against NullGL, no window or GPU needed
+static int Benchmark(const int frames) {
+    NullGL::Load();
+    App app;
+    // The worker threads start with the App and are reused by every frame, the first frame only warms up caches and buffers
+    app.Frame(1.0f / 60.0f, 1920, 1080);
+    NullGL::ResetStats();
+#ifdef SIMD_INSTRUMENTATION
+    const std::vector<Instrumentation::ProfileEntry> before = Instrumentation::CollectProfile();
+#endif
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; i++) app.Frame(1.0f / 60.0f, 1920, 1080);
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+    printf("%d frames, %.3f ms/frame, %u threads, the pool workers start once and no thread starts per frame\n", frames, elapsed.count() / frames, app.WorkerCount());
+    for (const NullGL::CallStats &stats: NullGL::CollectStats()) {
+        printf("  %-32s %8.2f calls/frame %12.0f bytes/frame\n", stats.name,
+               static_cast<double>(stats.calls) / frames, static_cast<double>(stats.bytes) / frames);
+    }
+#ifdef SIMD_INSTRUMENTATION
+    const std::vector<Instrumentation::ProfileEntry> profile = Instrumentation::CollectProfile();
+    const double msPerTick = 1000.0 / Instrumentation::TicksPerSecond();
+    for (size_t i = 0; i < profile.size(); i++) {
+        const uint64_t calls = profile[i].calls - (i < before.size() ? before[i].calls : 0);
+        const uint64_t ticks = profile[i].ticks - (i < before.size() ? before[i].ticks : 0);
+        if (calls == 0) continue;
+        printf("  %-32s %8.2f calls/frame %8.3f ms/frame\n", profile[i].name,
+               static_cast<double>(calls) / frames, static_cast<double>(ticks) * msPerTick / frames);
+    }
+#endif
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    // Visualization --benchmark [frames]
+    if (argc > 1 && strcmp(argv[1], "--benchmark") == 0) {
+        long frames = 1000;
+        if (argc > 2) {
+            char *end = nullptr;
+            errno = 0;
+            frames = strtol(argv[2], &end, 10);
+            if (end == argv[2] || *end != '\0' || errno == ERANGE || frames <= 0 || frames > INT_MAX) {
+                fprintf(stderr, "Usage: %s --benchmark [frames], frames is a positive integer\n", argv[0]);
+                return 1;
+            }
+        }
+        return Benchmark(static_cast<int>(frames));
+    }
+
     glfwInit();
 
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);